@@ -40,6 +40,7 @@
  */
 
 #include "rta_biquad.h"
+#include "rta_biquadintern.h" /* vectorised kernels */
 #include "rta_filter.h" /* filter types */
 #include "rta_math.h" /* rta_sin, rta_cos, M_PI */
 
@@ -59,107 +60,334 @@
 
 /* a1 is a[0] and a2 is a[1] */
 
+/* The formulas take s = sin(w0) and c = cos(w0), with w0 = M_PI * f0, */
+/* computed by rta_sin and rta_cos, or by the polynomials of */
+/* rta_biquad_coefs_fast and rta_biquad_coefs_batch */
 
 /* LPF: H(s) = 1 / (s^2 + s/Q + 1) */
-void rta_biquad_lowpass_coefs(rta_real_t * b, rta_real_t * a,
-                              const rta_real_t f0, const rta_real_t q)
+static void biquad_lowpass(rta_real_t * b, const int b_stride,
+                           rta_real_t * a, const int a_stride,
+                           const rta_real_t s, const rta_real_t c,
+                           const rta_real_t q)
 {
-  const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha = rta_sin(w0) / (2. * q);
-  const rta_real_t c = rta_cos(w0);
+  const rta_real_t alpha = s / (2. * q);
 
   const rta_real_t  a0_inv = 1. / (1. + alpha);
 
   a[0] = (-2. * c) * a0_inv;
-  a[1] = (1. - alpha) * a0_inv;
+  a[a_stride] = (1. - alpha) * a0_inv;
 
   b[0] = ((1. - c) * 0.5) * a0_inv;
-  b[1] = (1. - c) * a0_inv;
-  b[2] = b[0];
+  b[b_stride] = (1. - c) * a0_inv;
+  b[2*b_stride] = b[0];
 
   return;
 }
 
-/* LPF: H(s) = 1 / (s^2 + s/Q + 1) */
-void rta_biquad_lowpass_coefs_stride(rta_real_t * b, const int b_stride,
-                                     rta_real_t * a, const int a_stride,
-                                     const rta_real_t f0, const rta_real_t q)
+/* HPF: H(s) = s^2 / (s^2 + s/Q + 1) */
+static void biquad_highpass(rta_real_t * b, const int b_stride,
+                            rta_real_t * a, const int a_stride,
+                            const rta_real_t s, const rta_real_t c,
+                            const rta_real_t q)
 {
-  const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha = rta_sin(w0) / (2. * q);
-  const rta_real_t c = rta_cos(w0);
+  const rta_real_t alpha = s / (2. * q);
 
-  const rta_real_t  a0_inv = 1. / (1. + alpha);
+  const rta_real_t a0_inv = 1. / (1. + alpha);
 
   a[0] = (-2. * c) * a0_inv;
   a[a_stride] = (1. - alpha) * a0_inv;
 
-  b[0] = ((1. - c) * 0.5) * a0_inv;
-  b[b_stride] = (1. - c) * a0_inv;
+  b[0] = ((1. + c) * 0.5) * a0_inv;
+  b[b_stride] = (-1. - c) * a0_inv;
   b[2*b_stride] = b[0];
 
   return;
 }
 
-/* HPF: H(s) = s^2 / (s^2 + s/Q + 1) */
-void rta_biquad_highpass_coefs(rta_real_t * b, rta_real_t * a,
-                               const rta_real_t f0, const rta_real_t q)
+/* BPF: H(s) = s / (s^2 + s/Q + 1)  (constant skirt gain, peak gain = Q) */
+static void biquad_bandpass_constant_skirt(rta_real_t * b, const int b_stride,
+                                           rta_real_t * a, const int a_stride,
+                                           const rta_real_t s,
+                                           const rta_real_t c,
+                                           const rta_real_t q)
 {
-  const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha = rta_sin(w0) / (2. * q);
-  const rta_real_t c = rta_cos(w0);
+  const rta_real_t alpha = s / (2. * q);
 
   const rta_real_t a0_inv = 1. / (1. + alpha);
 
   a[0] = (-2. * c) * a0_inv;
-  a[1] = (1. - alpha) * a0_inv;
+  a[a_stride] = (1. - alpha) * a0_inv;
 
-  b[0] = ((1. + c) * 0.5) * a0_inv;
-  b[1] = (-1. - c) * a0_inv;
-  b[2] = b[0];
+  b[0] = (s * 0.5) * a0_inv;
+  b[b_stride] = 0.;
+  b[2*b_stride] = -b[0];
 
   return;
 }
 
-/* HPF: H(s) = s^2 / (s^2 + s/Q + 1) */
-void rta_biquad_highpass_coefs_stride(rta_real_t * b, const int b_stride,
-                                      rta_real_t * a, const int a_stride,
-                                      const rta_real_t f0, const rta_real_t q)
+/* BPF: H(s) = (s/Q) / (s^2 + s/Q + 1)      (constant 0 dB peak gain) */
+static void biquad_bandpass_constant_peak(rta_real_t * b, const int b_stride,
+                                          rta_real_t * a, const int a_stride,
+                                          const rta_real_t s,
+                                          const rta_real_t c,
+                                          const rta_real_t q)
 {
-  const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha = rta_sin(w0) / (2. * q);
-  const rta_real_t c = rta_cos(w0);
+  const rta_real_t alpha = s / (2. * q);
 
   const rta_real_t a0_inv = 1. / (1. + alpha);
 
   a[0] = (-2. * c) * a0_inv;
   a[a_stride] = (1. - alpha) * a0_inv;
 
-  b[0] = ((1. + c) * 0.5) * a0_inv;
-  b[b_stride] = (-1. - c) * a0_inv;
+  b[0] = alpha * a0_inv;
+  b[b_stride] = 0.;
+  b[2*b_stride] = -b[0];
+
+  return;
+}
+
+/* notch: H(s) = (s^2 + 1) / (s^2 + s/Q + 1) */
+static void biquad_notch(rta_real_t * b, const int b_stride,
+                         rta_real_t * a, const int a_stride,
+                         const rta_real_t s, const rta_real_t c,
+                         const rta_real_t q)
+{
+  const rta_real_t alpha = s / (2. * q);
+
+  const rta_real_t a0_inv = 1. / (1. + alpha);
+
+  a[0] = (-2. * c) * a0_inv;
+  a[a_stride] = (1. - alpha) * a0_inv;
+
+  b[0] = a0_inv;
+  b[b_stride] = a[0];
   b[2*b_stride] = b[0];
 
   return;
 }
 
-/* BPF: H(s) = s / (s^2 + s/Q + 1)  (constant skirt gain, peak gain = Q) */
-void rta_biquad_bandpass_constant_skirt_coefs(rta_real_t * b, rta_real_t * a, 
-                                              const rta_real_t f0, 
-                                              const rta_real_t q)
+/* APF: H(s) = (s^2 - s/Q + 1) / (s^2 + s/Q + 1) */
+static void biquad_allpass(rta_real_t * b, const int b_stride,
+                           rta_real_t * a, const int a_stride,
+                           const rta_real_t s, const rta_real_t c,
+                           const rta_real_t q)
 {
-  const rta_real_t w0 = M_PI * f0;
-  const rta_real_t s = rta_sin(w0);
   const rta_real_t alpha = s / (2. * q);
-  const rta_real_t c = rta_cos(w0);
 
   const rta_real_t a0_inv = 1. / (1. + alpha);
 
   a[0] = (-2. * c) * a0_inv;
-  a[1] = (1. - alpha) * a0_inv;
+  a[a_stride] = (1. - alpha) * a0_inv;
 
-  b[0] = (s * 0.5) * a0_inv;
-  b[1] = 0.;
-  b[2] = -b[0];
+  b[0] = a[a_stride];
+  b[b_stride] = a[0];
+  b[2*b_stride] = 1.;
+
+  return;
+}
+
+/* peakingEQ: H(s) = (s^2 + s*(A/Q) + 1) / (s^2 + s/(A*Q) + 1) */
+/* A = sqrt( 10^(dBgain/20) ) = 10^(dBgain/40) */
+/* gain is linear here */
+static void biquad_peaking(rta_real_t * b, const int b_stride,
+                           rta_real_t * a, const int a_stride,
+                           const rta_real_t s, const rta_real_t c,
+                           const rta_real_t q, const rta_real_t gain)
+{
+  const rta_real_t g = rta_sqrt(gain);
+  const rta_real_t g_inv = 1. / g;
+
+  const rta_real_t alpha = s / (2. * q);
+
+  const rta_real_t a0_inv = 1. / (1. + alpha * g_inv);
+
+  a[0] = (-2. * c) * a0_inv;
+  a[a_stride] = (1. - alpha * g_inv) * a0_inv;
+
+  b[0] = (1. + alpha * g) * a0_inv;
+  b[b_stride] = a[0];
+  b[2*b_stride] = (1. - alpha * g) * a0_inv;
+
+  return;
+}
+
+/* lowShelf: H(s) = A * (s^2 + (sqrt(A)/Q)*s + A)/(A*s^2 + (sqrt(A)/Q)*s + 1) */
+/* A = sqrt( 10^(dBgain/20) ) = 10^(dBgain/40) */
+/* gain is linear here */
+static void biquad_lowshelf(rta_real_t * b, const int b_stride,
+                            rta_real_t * a, const int a_stride,
+                            const rta_real_t s, const rta_real_t c,
+                            const rta_real_t q, const rta_real_t gain)
+{
+  const rta_real_t g = rta_sqrt(gain);
+
+  const rta_real_t alpha_2_sqrtg = s * rta_sqrt(g) / q ;
+
+  const rta_real_t a0_inv = 1. / 
+                             ( (g+1.) + (g-1.) * c + alpha_2_sqrtg);
+
+  a[0] =          (-2. *     ( (g-1.) + (g+1.) * c                ) ) * a0_inv;
+  a[a_stride] =   (            (g+1.) + (g-1.) * c - alpha_2_sqrtg  ) * a0_inv; 
+
+  b[0] =          (      g * ( (g+1.) - (g-1.) * c + alpha_2_sqrtg) ) * a0_inv;
+  b[b_stride] =   ( 2. * g * ( (g-1.) - (g+1.) * c                ) ) * a0_inv;
+  b[2*b_stride] = (      g * ( (g+1.) - (g-1.) * c - alpha_2_sqrtg) ) * a0_inv;
+
+  return;
+}
+
+/* highShelf: H(s) = A * (A*s^2 + (sqrt(A)/Q)*s + 1)/(s^2 + (sqrt(A)/Q)*s + A) */
+/* A = sqrt( 10^(dBgain/20) ) = 10^(dBgain/40) */
+/* gain is linear here */
+static void biquad_highshelf(rta_real_t * b, const int b_stride,
+                             rta_real_t * a, const int a_stride,
+                             const rta_real_t s, const rta_real_t c,
+                             const rta_real_t q, const rta_real_t gain)
+{
+  const rta_real_t g = rta_sqrt(gain);
+
+  const rta_real_t alpha_2_sqrtg = s * rta_sqrt(g) / q ;
+
+  const rta_real_t a0_inv = 1. / 
+                             ( (g+1.) - (g-1.) * c + alpha_2_sqrtg);
+
+  a[0] =          ( 2. *     ( (g-1.) - (g+1.) * c                ) ) * a0_inv;
+  a[a_stride] =   (            (g+1.) - (g-1.) * c - alpha_2_sqrtg  ) * a0_inv; 
+
+  b[0] =          (      g * ( (g+1.) + (g-1.) * c + alpha_2_sqrtg) ) * a0_inv;
+  b[b_stride] =   (-2. * g * ( (g-1.) + (g+1.) * c                ) ) * a0_inv;
+  b[2*b_stride] = (      g * ( (g+1.) + (g-1.) * c - alpha_2_sqrtg) ) * a0_inv;
+
+  return;
+}
+
+/* any type, with the gain applied to b when it is not integrated */
+static void biquad_coefs_sincos(rta_real_t * b, const int b_stride,
+                                rta_real_t * a, const int a_stride,
+                                const rta_filter_t type,
+                                const rta_real_t s, const rta_real_t c,
+                                const rta_real_t q, const rta_real_t gain)
+{
+  switch(type)
+  {
+    case rta_lowpass:
+      biquad_lowpass(b, b_stride, a, a_stride, s, c, q);
+      break;
+
+    case rta_highpass:
+      biquad_highpass(b, b_stride, a, a_stride, s, c, q);
+      break;
+
+    case rta_bandpass_constant_skirt:
+      biquad_bandpass_constant_skirt(b, b_stride, a, a_stride, s, c, q);
+      break;
+
+    case rta_bandpass_constant_peak:
+      biquad_bandpass_constant_peak(b, b_stride, a, a_stride, s, c, q);
+      break;
+
+    case rta_notch:
+      biquad_notch(b, b_stride, a, a_stride, s, c, q);
+      break;
+
+    case rta_allpass:
+      biquad_allpass(b, b_stride, a, a_stride, s, c, q);
+      break;
+
+    case rta_peaking:
+      biquad_peaking(b, b_stride, a, a_stride, s, c, q, gain);
+      break;
+
+    case rta_lowshelf:
+      biquad_lowshelf(b, b_stride, a, a_stride, s, c, q, gain);
+      break;
+
+    case rta_highshelf:
+      biquad_highshelf(b, b_stride, a, a_stride, s, c, q, gain);
+      break;
+  }
+
+  switch(type)
+  {
+    case rta_lowpass:
+    case rta_highpass:
+    case rta_bandpass_constant_skirt:
+    case rta_bandpass_constant_peak:
+    case rta_notch:
+    case rta_allpass:
+
+      if(gain != 1.)
+      {
+        b[0] *= gain;
+        b[b_stride] *= gain;
+        b[2*b_stride] *= gain;
+      }
+      break;
+
+    /* gain is already integrated for the following */
+    case rta_peaking:
+    case rta_lowshelf:
+    case rta_highshelf:
+      break;
+  }
+
+  return;
+}
+
+/* LPF: H(s) = 1 / (s^2 + s/Q + 1) */
+void rta_biquad_lowpass_coefs(rta_real_t * b, rta_real_t * a,
+                              const rta_real_t f0, const rta_real_t q)
+{
+  const rta_real_t w0 = M_PI * f0;
+
+  biquad_lowpass(b, 1, a, 1, rta_sin(w0), rta_cos(w0), q);
+
+  return;
+}
+
+/* LPF: H(s) = 1 / (s^2 + s/Q + 1) */
+void rta_biquad_lowpass_coefs_stride(rta_real_t * b, const int b_stride,
+                                     rta_real_t * a, const int a_stride,
+                                     const rta_real_t f0, const rta_real_t q)
+{
+  const rta_real_t w0 = M_PI * f0;
+
+  biquad_lowpass(b, b_stride, a, a_stride, rta_sin(w0), rta_cos(w0), q);
+
+  return;
+}
+
+/* HPF: H(s) = s^2 / (s^2 + s/Q + 1) */
+void rta_biquad_highpass_coefs(rta_real_t * b, rta_real_t * a,
+                               const rta_real_t f0, const rta_real_t q)
+{
+  const rta_real_t w0 = M_PI * f0;
+
+  biquad_highpass(b, 1, a, 1, rta_sin(w0), rta_cos(w0), q);
+
+  return;
+}
+
+/* HPF: H(s) = s^2 / (s^2 + s/Q + 1) */
+void rta_biquad_highpass_coefs_stride(rta_real_t * b, const int b_stride,
+                                      rta_real_t * a, const int a_stride,
+                                      const rta_real_t f0, const rta_real_t q)
+{
+  const rta_real_t w0 = M_PI * f0;
+
+  biquad_highpass(b, b_stride, a, a_stride, rta_sin(w0), rta_cos(w0), q);
+
+  return;
+}
+
+/* BPF: H(s) = s / (s^2 + s/Q + 1)  (constant skirt gain, peak gain = Q) */
+void rta_biquad_bandpass_constant_skirt_coefs(rta_real_t * b, rta_real_t * a, 
+                                              const rta_real_t f0, 
+                                              const rta_real_t q)
+{
+  const rta_real_t w0 = M_PI * f0;
+
+  biquad_bandpass_constant_skirt(b, 1, a, 1, rta_sin(w0), rta_cos(w0), q);
 
   return;
 }
@@ -172,18 +400,9 @@ void rta_biquad_bandpass_constant_skirt_coefs_stride(
   const rta_real_t q)
 {
   const rta_real_t w0 = M_PI * f0;
-  const rta_real_t s = rta_sin(w0);
-  const rta_real_t alpha = s / (2. * q);
-  const rta_real_t c = rta_cos(w0);
 
-  const rta_real_t a0_inv = 1. / (1. + alpha);
-
-  a[0] = (-2. * c) * a0_inv;
-  a[a_stride] = (1. - alpha) * a0_inv;
-
-  b[0] = (s * 0.5) * a0_inv;
-  b[b_stride] = 0.;
-  b[2*b_stride] = -b[0];
+  biquad_bandpass_constant_skirt(b, b_stride, a, a_stride,
+                                 rta_sin(w0), rta_cos(w0), q);
 
   return;
 }
@@ -194,17 +413,8 @@ void rta_biquad_bandpass_constant_peak_coefs(rta_real_t * b, rta_real_t * a,
                                              const rta_real_t q)
 {
   const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha = rta_sin(w0) / (2. * q);
-  const rta_real_t c = rta_cos(w0);
 
-  const rta_real_t a0_inv = 1. / (1. + alpha);
-
-  a[0] = (-2. * c) * a0_inv;
-  a[1] = (1. - alpha) * a0_inv;
-
-  b[0] = alpha * a0_inv;
-  b[1] = 0.;
-  b[2] = -b[0];
+  biquad_bandpass_constant_peak(b, 1, a, 1, rta_sin(w0), rta_cos(w0), q);
 
   return;
 }
@@ -217,17 +427,9 @@ void rta_biquad_bandpass_constant_peak_coefs_stride(
   const rta_real_t q)
 {
   const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha = rta_sin(w0) / (2. * q);
-  const rta_real_t c = rta_cos(w0);
-
-  const rta_real_t a0_inv = 1. / (1. + alpha);
-
-  a[0] = (-2. * c) * a0_inv;
-  a[a_stride] = (1. - alpha) * a0_inv;
 
-  b[0] = alpha * a0_inv;
-  b[b_stride] = 0.;
-  b[2*b_stride] = -b[0];
+  biquad_bandpass_constant_peak(b, b_stride, a, a_stride,
+                                rta_sin(w0), rta_cos(w0), q);
 
   return;
 }
@@ -237,17 +439,8 @@ void rta_biquad_notch_coefs(rta_real_t * b, rta_real_t * a,
                             const rta_real_t f0, const rta_real_t q)
 {
   const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha = rta_sin(w0) / (2. * q);
-  const rta_real_t c = rta_cos(w0);
 
-  const rta_real_t a0_inv = 1. / (1. + alpha);
-
-  a[0] = (-2. * c) * a0_inv;
-  a[1] = (1. - alpha) * a0_inv;
-
-  b[0] = a0_inv;
-  b[1] = a[0];
-  b[2] = b[0];
+  biquad_notch(b, 1, a, 1, rta_sin(w0), rta_cos(w0), q);
 
   return;
 }
@@ -258,17 +451,8 @@ void rta_biquad_notch_coefs_stride(rta_real_t * b, const int b_stride,
                                    const rta_real_t f0, const rta_real_t q)
 {
   const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha = rta_sin(w0) / (2. * q);
-  const rta_real_t c = rta_cos(w0);
 
-  const rta_real_t a0_inv = 1. / (1. + alpha);
-
-  a[0] = (-2. * c) * a0_inv;
-  a[a_stride] = (1. - alpha) * a0_inv;
-
-  b[0] = a0_inv;
-  b[b_stride] = a[0];
-  b[2*b_stride] = b[0];
+  biquad_notch(b, b_stride, a, a_stride, rta_sin(w0), rta_cos(w0), q);
 
   return;
 }
@@ -278,17 +462,8 @@ void rta_biquad_allpass_coefs(rta_real_t * b, rta_real_t * a,
                               const rta_real_t f0, const rta_real_t q)
 {
   const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha = rta_sin(w0) / (2. * q);
-  const rta_real_t c = rta_cos(w0);
 
-  const rta_real_t a0_inv = 1. / (1. + alpha);
-
-  a[0] = (-2. * c) * a0_inv;
-  a[1] = (1. - alpha) * a0_inv;
-
-  b[0] = a[1];
-  b[1] = a[0];
-  b[2] = 1.;
+  biquad_allpass(b, 1, a, 1, rta_sin(w0), rta_cos(w0), q);
 
   return;
 }
@@ -299,17 +474,8 @@ void rta_biquad_allpass_coefs_stride(rta_real_t * b, const int b_stride,
                                      const rta_real_t f0, const rta_real_t q)
 {
   const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha = rta_sin(w0) / (2. * q);
-  const rta_real_t c = rta_cos(w0);
-
-  const rta_real_t a0_inv = 1. / (1. + alpha);
 
-  a[0] = (-2. * c) * a0_inv;
-  a[a_stride] = (1. - alpha) * a0_inv;
-
-  b[0] = a[a_stride];
-  b[b_stride] = a[0];
-  b[2*b_stride] = 1.;
+  biquad_allpass(b, b_stride, a, a_stride, rta_sin(w0), rta_cos(w0), q);
 
   return;
 }
@@ -321,21 +487,9 @@ void rta_biquad_peaking_coefs(rta_real_t * b, rta_real_t * a,
                               const rta_real_t f0, const rta_real_t q,
                               const rta_real_t gain)
 {
-  const rta_real_t g = rta_sqrt(gain);
-  const rta_real_t g_inv = 1. / g;
-
   const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha = rta_sin(w0) / (2. * q);
-  const rta_real_t c = rta_cos(w0);
-
-  const rta_real_t a0_inv = 1. / (1. + alpha * g_inv);
-
-  a[0] = (-2. * c) * a0_inv;
-  a[1] = (1. - alpha * g_inv) * a0_inv;
 
-  b[0] = (1. + alpha * g) * a0_inv;
-  b[1] = a[0];
-  b[2] = (1. - alpha * g) * a0_inv;
+  biquad_peaking(b, 1, a, 1, rta_sin(w0), rta_cos(w0), q, gain);
 
   return;
 }
@@ -348,21 +502,9 @@ void rta_biquad_peaking_coefs_stride(rta_real_t * b, const int b_stride,
                                      const rta_real_t f0, const rta_real_t q,
                                      const rta_real_t gain)
 {
-  const rta_real_t g = rta_sqrt(gain);
-  const rta_real_t g_inv = 1. / g;
-
   const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha = rta_sin(w0) / (2. * q);
-  const rta_real_t c = rta_cos(w0);
-
-  const rta_real_t a0_inv = 1. / (1. + alpha * g_inv);
-
-  a[0] = (-2. * c) * a0_inv;
-  a[a_stride] = (1. - alpha * g_inv) * a0_inv;
 
-  b[0] = (1. + alpha * g) * a0_inv;
-  b[b_stride] = a[0];
-  b[2*b_stride] = (1. - alpha * g) * a0_inv;
+  biquad_peaking(b, b_stride, a, a_stride, rta_sin(w0), rta_cos(w0), q, gain);
 
   return;
 }
@@ -374,21 +516,9 @@ void rta_biquad_lowshelf_coefs(rta_real_t * b, rta_real_t * a,
                                const rta_real_t f0, const rta_real_t q, 
                                const rta_real_t gain)
 {
-  const rta_real_t g = rta_sqrt(gain);
-
   const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha_2_sqrtg = rta_sin(w0) * rta_sqrt(g) / q ;
-  const rta_real_t c = rta_cos(w0);
-
-  const rta_real_t a0_inv = 1. / 
-                    ( (g+1.) + (g-1.) * c + alpha_2_sqrtg);
 
-  a[0] = (-2. *     ( (g-1.) + (g+1.) * c                ) ) * a0_inv;
-  a[1] = (            (g+1.) + (g-1.) * c - alpha_2_sqrtg  ) * a0_inv; 
-
-  b[0] = (      g * ( (g+1.) - (g-1.) * c + alpha_2_sqrtg) ) * a0_inv;
-  b[1] = ( 2. * g * ( (g-1.) - (g+1.) * c                ) ) * a0_inv;
-  b[2] = (      g * ( (g+1.) - (g-1.) * c - alpha_2_sqrtg) ) * a0_inv;
+  biquad_lowshelf(b, 1, a, 1, rta_sin(w0), rta_cos(w0), q, gain);
 
   return;
 }
@@ -401,21 +531,9 @@ void rta_biquad_lowshelf_coefs_stride(rta_real_t * b, const int b_stride,
                                       const rta_real_t f0, const rta_real_t q, 
                                       const rta_real_t gain)
 {
-  const rta_real_t g = rta_sqrt(gain);
-
   const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha_2_sqrtg = rta_sin(w0) * rta_sqrt(g) / q ;
-  const rta_real_t c = rta_cos(w0);
-
-  const rta_real_t a0_inv = 1. / 
-                             ( (g+1.) + (g-1.) * c + alpha_2_sqrtg);
-
-  a[0] =          (-2. *     ( (g-1.) + (g+1.) * c                ) ) * a0_inv;
-  a[a_stride] =   (            (g+1.) + (g-1.) * c - alpha_2_sqrtg  ) * a0_inv; 
 
-  b[0] =          (      g * ( (g+1.) - (g-1.) * c + alpha_2_sqrtg) ) * a0_inv;
-  b[b_stride] =   ( 2. * g * ( (g-1.) - (g+1.) * c                ) ) * a0_inv;
-  b[2*b_stride] = (      g * ( (g+1.) - (g-1.) * c - alpha_2_sqrtg) ) * a0_inv;
+  biquad_lowshelf(b, b_stride, a, a_stride, rta_sin(w0), rta_cos(w0), q, gain);
 
   return;
 }
@@ -427,21 +545,9 @@ void rta_biquad_highshelf_coefs(rta_real_t * b, rta_real_t * a,
                                 const rta_real_t f0, const rta_real_t q, 
                                 const rta_real_t gain)
 {
-  const rta_real_t g = rta_sqrt(gain);
-
   const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha_2_sqrtg = rta_sin(w0) * rta_sqrt(g) / q ;
-  const rta_real_t c = rta_cos(w0);
-
-  const rta_real_t a0_inv = 1. / 
-                    ( (g+1.) - (g-1.) * c + alpha_2_sqrtg);
 
-  a[0] = ( 2. *     ( (g-1.) - (g+1.) * c                ) ) * a0_inv;
-  a[1] = (            (g+1.) - (g-1.) * c - alpha_2_sqrtg  ) * a0_inv; 
-
-  b[0] = (      g * ( (g+1.) + (g-1.) * c + alpha_2_sqrtg) ) * a0_inv;
-  b[1] = (-2. * g * ( (g-1.) + (g+1.) * c                ) ) * a0_inv;
-  b[2] = (      g * ( (g+1.) + (g-1.) * c - alpha_2_sqrtg) ) * a0_inv;
+  biquad_highshelf(b, 1, a, 1, rta_sin(w0), rta_cos(w0), q, gain);
 
   return;
 }
@@ -455,21 +561,9 @@ void rta_biquad_highshelf_coefs_stride(
   const rta_real_t f0, const rta_real_t q, 
   const rta_real_t gain)
 {
-  const rta_real_t g = rta_sqrt(gain);
-
   const rta_real_t w0 = M_PI * f0;
-  const rta_real_t alpha_2_sqrtg = rta_sin(w0) * rta_sqrt(g) / q ;
-  const rta_real_t c = rta_cos(w0);
-
-  const rta_real_t a0_inv = 1. / 
-                             ( (g+1.) - (g-1.) * c + alpha_2_sqrtg);
-
-  a[0] =          ( 2. *     ( (g-1.) - (g+1.) * c                ) ) * a0_inv;
-  a[a_stride] =   (            (g+1.) - (g-1.) * c - alpha_2_sqrtg  ) * a0_inv; 
 
-  b[0] =          (      g * ( (g+1.) + (g-1.) * c + alpha_2_sqrtg) ) * a0_inv;
-  b[b_stride] =   (-2. * g * ( (g-1.) + (g+1.) * c                ) ) * a0_inv;
-  b[2*b_stride] = (      g * ( (g+1.) + (g-1.) * c - alpha_2_sqrtg) ) * a0_inv;
+  biquad_highshelf(b, b_stride, a, a_stride, rta_sin(w0), rta_cos(w0), q, gain);
 
   return;
 }
@@ -480,69 +574,9 @@ void rta_biquad_coefs(rta_real_t * b, rta_real_t * a,
                       const rta_real_t f0, const rta_real_t q, 
                       const rta_real_t gain)
 {
-  
-  switch(type)
-  {
-    case rta_lowpass:
-      rta_biquad_lowpass_coefs(b, a, f0, q);
-      break;
-
-    case rta_highpass:
-      rta_biquad_highpass_coefs(b, a, f0, q);
-      break;
-
-    case rta_bandpass_constant_skirt:
-      rta_biquad_bandpass_constant_skirt_coefs(b, a, f0, q);
-      break;
-
-    case rta_bandpass_constant_peak:
-      rta_biquad_bandpass_constant_peak_coefs(b, a, f0, q);
-      break;
-
-    case rta_notch:
-      rta_biquad_notch_coefs(b, a, f0, q);
-      break;
-
-    case rta_allpass:
-      rta_biquad_allpass_coefs(b, a, f0, q);
-      break;
-
-    case rta_peaking:
-      rta_biquad_peaking_coefs(b, a, f0, q, gain);
-      break;
-
-    case rta_lowshelf:
-      rta_biquad_lowshelf_coefs(b, a, f0, q, gain);
-      break;
-
-    case rta_highshelf:
-      rta_biquad_highshelf_coefs(b, a, f0, q, gain);
-      break;
-  }
-
-  switch(type)
-  {
-    case rta_lowpass:
-    case rta_highpass:
-    case rta_bandpass_constant_skirt:
-    case rta_bandpass_constant_peak:
-    case rta_notch:
-    case rta_allpass:
-
-     if(gain != 1.)
-     {
-       b[0] *= gain;
-       b[1] *= gain;
-       b[2] *= gain;
-     }
-     break;
+  const rta_real_t w0 = M_PI * f0;
 
-    /* gain is already integrated for the following */
-    case rta_peaking:
-    case rta_lowshelf:
-    case rta_highshelf:
-      break;
-  }
+  biquad_coefs_sincos(b, 1, a, 1, type, rta_sin(w0), rta_cos(w0), q, gain);
 
   return;
 }
@@ -554,71 +588,115 @@ void rta_biquad_coefs_stride(rta_real_t * b, const int b_stride,
                              const rta_real_t f0, const rta_real_t q, 
                              const rta_real_t gain)
 {
-  
-  switch(type)
-  {
-    case rta_lowpass:
-      rta_biquad_lowpass_coefs_stride(b, b_stride, a, a_stride, f0, q);
-      break;
+  const rta_real_t w0 = M_PI * f0;
 
-    case rta_highpass:
-      rta_biquad_highpass_coefs_stride(b, b_stride, a, a_stride, f0, q);
-      break;
+  biquad_coefs_sincos(b, b_stride, a, a_stride, type,
+                      rta_sin(w0), rta_cos(w0), q, gain);
 
-    case rta_bandpass_constant_skirt:
-      rta_biquad_bandpass_constant_skirt_coefs_stride(b, b_stride, a, a_stride, 
-                                                      f0, q);
-      break;
+  return;
+}
 
-    case rta_bandpass_constant_peak:
+/* filters computed together by rta_biquad_coefs_batch */
+#define RTA_BIQUAD_COEFS_BATCH 64
 
-      rta_biquad_bandpass_constant_peak_coefs_stride(b, b_stride, a, a_stride, 
-                                                     f0, q);
-      break;
+/* sin(M_PI * f0) and cos(M_PI * f0) by polynomials, for 0 <= f0 <= 1: */
+/* the argument is reduced to [0, M_PI / 4] with the symmetries, where */
+/* the Taylor series (up to the powers 11 and 12) are within 1e-11 */
+static inline void biquad_sincos(rta_real_t * s, rta_real_t * c,
+                                 const rta_real_t f0)
+{
+  /* in the working precision, without promotion to double */
+  const rta_real_t one = 1.;
+  const rta_real_t half = 0.5;
+  const rta_real_t quarter = 0.25;
+  const rta_real_t pi = M_PI;
+  const rta_real_t s3 = -1. / 6.;
+  const rta_real_t s5 = 1. / 120.;
+  const rta_real_t s7 = -1. / 5040.;
+  const rta_real_t s9 = 1. / 362880.;
+  const rta_real_t s11 = -1. / 39916800.;
+  const rta_real_t c2 = -0.5;
+  const rta_real_t c4 = 1. / 24.;
+  const rta_real_t c6 = -1. / 720.;
+  const rta_real_t c8 = 1. / 40320.;
+  const rta_real_t c10 = -1. / 3628800.;
+  const rta_real_t c12 = 1. / 479001600.;
+
+  const rta_real_t f = (f0 > half) ? one - f0 : f0; /* cos changes sign */
+  const rta_real_t x = pi * ((f > quarter) ? half - f : f); /* swapped */
+  const rta_real_t x2 = x * x;
+
+  const rta_real_t ps =
+    x * (one + x2 * (s3 + x2 * (s5 + x2 * (s7 + x2 * (s9 + x2 * s11)))));
+  const rta_real_t pc =
+    one + x2 * (c2 + x2 * (c4 + x2 * (c6 + x2 * (c8 + x2 * (c10 + x2 * c12)))));
+
+  *s = (f > quarter) ? pc : ps;
+  *c = (f > quarter) ? ps : pc;
+  *c = (f0 > half) ? - *c : *c;
 
-    case rta_notch:
-      rta_biquad_notch_coefs_stride(b, b_stride, a, a_stride, f0, q);
-      break;
+  return;
+}
 
-    case rta_allpass:
-      rta_biquad_allpass_coefs_stride(b, b_stride, a, a_stride, f0, q);
-      break;
+void rta_biquad_coefs_fast(rta_real_t * b, rta_real_t * a,
+                           const rta_filter_t type,
+                           const rta_real_t f0, const rta_real_t q,
+                           const rta_real_t gain)
+{
+  rta_real_t s, c;
 
-    case rta_peaking:
-      rta_biquad_peaking_coefs_stride(b, b_stride, a, a_stride, f0, q, gain);
-      break;
+  biquad_sincos(&s, &c, f0);
+  biquad_coefs_sincos(b, 1, a, 1, type, s, c, q, gain);
 
-    case rta_lowshelf:
-      rta_biquad_lowshelf_coefs_stride(b, b_stride, a, a_stride, f0, q, gain);
-      break;
+  return;
+}
 
-    case rta_highshelf:
-      rta_biquad_highshelf_coefs_stride(b, b_stride, a, a_stride, f0, q, gain);
-      break;
-  }
+void rta_biquad_coefs_fast_stride(
+  rta_real_t * b, const int b_stride,
+  rta_real_t * a, const int a_stride,
+  const rta_filter_t type,
+  const rta_real_t f0, const rta_real_t q,
+  const rta_real_t gain)
+{
+  rta_real_t s, c;
 
-  switch(type)
-  {
-    case rta_lowpass:
-    case rta_highpass:
-    case rta_bandpass_constant_skirt:
-    case rta_bandpass_constant_peak:
-    case rta_notch:
-    case rta_allpass:
+  biquad_sincos(&s, &c, f0);
+  biquad_coefs_sincos(b, b_stride, a, a_stride, type, s, c, q, gain);
 
-      if(gain != 1.)
-      {
-        b[0] *= gain;
-        b[b_stride] *= gain;
-        b[2*b_stride] *= gain;
-      }
-      break;
+  return;
+}
 
-    /* gain is already integrated for the following */
-    case rta_peaking:
-    case rta_lowshelf:
-    case rta_highshelf:
-      break;
+void rta_biquad_coefs_batch(rta_real_t * b, rta_real_t * a,
+                            const rta_filter_t * types,
+                            const rta_real_t * f0, const rta_real_t * q,
+                            const rta_real_t * gain,
+                            const unsigned int size)
+{
+  const rta_biquad_simd_t * simd = rta_biquad_simd_get();
+  rta_real_t s[RTA_BIQUAD_COEFS_BATCH];
+  rta_real_t c[RTA_BIQUAD_COEFS_BATCH];
+  unsigned int start, n, i;
+
+  for(start = 0; start < size; start += n)
+  {
+    n = size - start;
+    if(n > RTA_BIQUAD_COEFS_BATCH)
+    {
+      n = RTA_BIQUAD_COEFS_BATCH;
+    }
+
+    i = (simd != NULL) ? simd->sincos(s, c, f0 + start, n) : 0;
+    for(; i < n; i++)
+    {
+      biquad_sincos(s + i, c + i, f0[start + i]);
+    }
+
+    for(i = 0; i < n; i++)
+    {
+      biquad_coefs_sincos(b + 3 * (start + i), 1, a + 2 * (start + i), 1,
+                          types[start + i], s[i], c[i],
+                          q[start + i], gain[start + i]);
+    }
   }
 
   return;
@@ -766,3 +844,262 @@ void rta_biquad_df2t_vector_stride(
 
   return;
 }
+
+/* linear interpolation of the coefficients: start values and */
+/* increments per sample, the last sample using the end values */
+typedef struct
+{
+  rta_real_t b[3];
+  rta_real_t a[2];
+  rta_real_t b_step[3];
+  rta_real_t a_step[2];
+} biquad_ramp_t;
+
+static void biquad_ramp_init(biquad_ramp_t * ramp,
+                             const rta_real_t * b_start, const rta_real_t * b_end,
+                             const int b_stride,
+                             const rta_real_t * a_start, const rta_real_t * a_end,
+                             const int a_stride,
+                             const unsigned int x_size)
+{
+  const rta_real_t step = (x_size > 0) ? 1. / (rta_real_t) x_size : 0.;
+  int j;
+
+  for(j = 0; j < 3; j++)
+  {
+    ramp->b[j] = b_start[j * b_stride];
+    ramp->b_step[j] = (b_end[j * b_stride] - b_start[j * b_stride]) * step;
+  }
+
+  for(j = 0; j < 2; j++)
+  {
+    ramp->a[j] = a_start[j * a_stride];
+    ramp->a_step[j] = (a_end[j * a_stride] - a_start[j * a_stride]) * step;
+  }
+
+  return;
+}
+
+/* coefficients of sample i, in b and a */
+static void biquad_ramp_coefs(rta_real_t * b, rta_real_t * a,
+                              const biquad_ramp_t * ramp,
+                              const unsigned int i)
+{
+  const rta_real_t t = (rta_real_t) (i + 1);
+
+  b[0] = ramp->b[0] + t * ramp->b_step[0];
+  b[1] = ramp->b[1] + t * ramp->b_step[1];
+  b[2] = ramp->b[2] + t * ramp->b_step[2];
+  a[0] = ramp->a[0] + t * ramp->a_step[0];
+  a[1] = ramp->a[1] + t * ramp->a_step[1];
+
+  return;
+}
+
+void rta_biquad_df1_vector_ramp(rta_real_t * y,
+                                const rta_real_t * x, const unsigned int x_size,
+                                const rta_real_t * b_start, const rta_real_t * b_end,
+                                const rta_real_t * a_start, const rta_real_t * a_end,
+                                rta_real_t * states)
+{
+  rta_biquad_df1_vector_ramp_stride(y, 1, x, 1, x_size,
+                                    b_start, b_end, 1, a_start, a_end, 1,
+                                    states, 1);
+  return;
+}
+
+void rta_biquad_df2t_vector_ramp(rta_real_t * y,
+                                 const rta_real_t * x, const unsigned int x_size,
+                                 const rta_real_t * b_start, const rta_real_t * b_end,
+                                 const rta_real_t * a_start, const rta_real_t * a_end,
+                                 rta_real_t * states)
+{
+  rta_biquad_df2t_vector_ramp_stride(y, 1, x, 1, x_size,
+                                     b_start, b_end, 1, a_start, a_end, 1,
+                                     states, 1);
+  return;
+}
+
+void rta_biquad_df1_vector_ramp_stride(
+  rta_real_t * y, const int y_stride,
+  const rta_real_t * x, const int x_stride, const unsigned int x_size,
+  const rta_real_t * b_start, const rta_real_t * b_end, const int b_stride,
+  const rta_real_t * a_start, const rta_real_t * a_end, const int a_stride,
+  rta_real_t * states, const int s_stride)
+{
+  biquad_ramp_t ramp;
+  rta_real_t b[3];
+  rta_real_t a[2];
+  unsigned int i;
+
+  biquad_ramp_init(&ramp, b_start, b_end, b_stride, a_start, a_end, a_stride,
+                   x_size);
+
+  for(i = 0; i < x_size; i++)
+  {
+    biquad_ramp_coefs(b, a, &ramp, i);
+    y[i * y_stride] = rta_biquad_df1_stride(
+      x[i * x_stride], b, 1, a, 1, states, s_stride);
+  }
+
+  return;
+}
+
+void rta_biquad_df2t_vector_ramp_stride(
+  rta_real_t * y, const int y_stride,
+  const rta_real_t * x, const int x_stride, const unsigned int x_size,
+  const rta_real_t * b_start, const rta_real_t * b_end, const int b_stride,
+  const rta_real_t * a_start, const rta_real_t * a_end, const int a_stride,
+  rta_real_t * states, const int s_stride)
+{
+  biquad_ramp_t ramp;
+  rta_real_t b[3];
+  rta_real_t a[2];
+  unsigned int i;
+
+  biquad_ramp_init(&ramp, b_start, b_end, b_stride, a_start, a_end, a_stride,
+                   x_size);
+
+  for(i = 0; i < x_size; i++)
+  {
+    biquad_ramp_coefs(b, a, &ramp, i);
+    y[i * y_stride] = rta_biquad_df2t_stride(
+      x[i * x_stride], b, 1, a, 1, states, s_stride);
+  }
+
+  return;
+}
+
+/* state-space form of the transposed direct form II, by blocks: */
+/* responses of a block to each of its input samples, then to each state */
+/* (see rta_biquad_block_kernel_t), computed as by rta_biquad_df2t in the */
+/* same precision, which is important for poles close to 1 */
+static void df2t_block_matrix(rta_real_t * matrix,
+                              const rta_real_t * b, const rta_real_t * a)
+{
+  const unsigned int n = RTA_BIQUAD_BLOCK;
+  rta_real_t h[RTA_BIQUAD_BLOCK];
+  rta_real_t s0, s1, y;
+  unsigned int i, k, c;
+
+  /* impulse response, shifted for each input sample */
+  s0 = 0.;
+  s1 = 0.;
+  for(i = 0; i < n; i++)
+  {
+    y = (i == 0 ? b[0] : 0.) + s0;
+    s0 = (i == 0 ? b[1] : 0.) - a[0] * y + s1;
+    s1 = (i == 0 ? b[2] : 0.) - a[1] * y;
+    h[i] = y;
+  }
+
+  for(k = 0; k < n; k++)
+  {
+    for(i = 0; i < n; i++)
+    {
+      matrix[k * n + i] = (i >= k) ? h[i - k] : 0.;
+    }
+  }
+
+  /* free responses to each state */
+  for(c = 0; c < 2; c++)
+  {
+    s0 = (c == 0) ? 1. : 0.;
+    s1 = (c == 1) ? 1. : 0.;
+    for(i = 0; i < n; i++)
+    {
+      y = s0;
+      s0 = - a[0] * y + s1;
+      s1 = - a[1] * y;
+      matrix[(n + c) * n + i] = y;
+    }
+  }
+
+  return;
+}
+
+void rta_biquad_df2t_vector_block(rta_real_t * y,
+                                  const rta_real_t * x,
+                                  const unsigned int x_size,
+                                  const rta_real_t * b, const rta_real_t * a,
+                                  rta_real_t * states)
+{
+  const rta_biquad_simd_t * simd =
+    (x_size >= RTA_BIQUAD_BLOCK) ? rta_biquad_simd_get() : NULL;
+  unsigned int i = 0;
+
+  if(simd != NULL)
+  {
+    rta_real_t matrix[(RTA_BIQUAD_BLOCK + 2) * RTA_BIQUAD_BLOCK];
+
+    df2t_block_matrix(matrix, b, a);
+    i = simd->df2t_block(y, x, x_size, b, a, matrix, states);
+  }
+
+  for(; i < x_size; i++)
+  {
+    y[i] = rta_biquad_df2t(x[i], b, a, states);
+  }
+
+  return;
+}
+
+void rta_biquad_df2t_vector_block_stride(
+  rta_real_t * y, const int y_stride,
+  const rta_real_t * x, const int x_stride, const unsigned int x_size,
+  const rta_real_t * b, const int b_stride,
+  const rta_real_t * a, const int a_stride,
+  rta_real_t * states, const int s_stride)
+{
+  const unsigned int n = RTA_BIQUAD_BLOCK;
+  const rta_biquad_simd_t * simd =
+    (x_size >= n) ? rta_biquad_simd_get() : NULL;
+  unsigned int i = 0;
+
+  if(simd != NULL)
+  {
+    rta_real_t matrix[(RTA_BIQUAD_BLOCK + 2) * RTA_BIQUAD_BLOCK];
+    rta_real_t buffer[RTA_BIQUAD_BLOCK];
+    rta_real_t bc[3];
+    rta_real_t ac[2];
+    rta_real_t sc[2];
+    unsigned int j;
+
+    bc[0] = b[0];
+    bc[1] = b[b_stride];
+    bc[2] = b[2 * b_stride];
+    ac[0] = a[0];
+    ac[1] = a[a_stride];
+    sc[0] = states[0];
+    sc[1] = states[s_stride];
+
+    df2t_block_matrix(matrix, bc, ac);
+
+    /* contiguous copy of each block */
+    for(i = 0; i + n <= x_size; i += n)
+    {
+      for(j = 0; j < n; j++)
+      {
+        buffer[j] = x[(i + j) * x_stride];
+      }
+
+      simd->df2t_block(buffer, buffer, n, bc, ac, matrix, sc);
+
+      for(j = 0; j < n; j++)
+      {
+        y[(i + j) * y_stride] = buffer[j];
+      }
+    }
+
+    states[0] = sc[0];
+    states[s_stride] = sc[1];
+  }
+
+  for(; i < x_size; i++)
+  {
+    y[i * y_stride] = rta_biquad_df2t_stride(
+      x[i * x_stride], b, b_stride, a, a_stride, states, s_stride);
+  }
+
+  return;
+}
@@ -478,6 +478,90 @@ void rta_biquad_coefs_stride(
   const rta_real_t gain);
 
 
+/**
+ * Biquad coefficients calculation, depending on the filter type, as
+ * rta_biquad_coefs but faster.
+ *
+ * The sine and cosine of the cutoff frequency are computed by
+ * polynomials, within 1e-11 of the standard functions: the
+ * coefficients are the same as rta_biquad_coefs in single precision,
+ * up to the rounding, and within about 1e-10 in double precision.
+ * This avoids the trigonometric functions of the mathematical library,
+ * which are slow in double precision.
+ *
+ * \see rta_biquad_coefs
+ *
+ * @param b is a vector of feed-forward coefficients
+ * @param a is a vector of feed-backward coefficients
+ * @param type is the filter type (see rta_biquad_coefs)
+ * @param f0 is the cutoff frequency, normalised by the nyquist
+ * frequency. It must be >= 0. and <= 1.
+ * @param q must be > 0. and is generally >= 0.5 for audio
+ * filtering.
+ * @param gain is linear and must be > 0.
+ */
+void rta_biquad_coefs_fast(rta_real_t * b, rta_real_t * a,
+                           const rta_filter_t type,
+                           const rta_real_t f0, const rta_real_t q,
+                           const rta_real_t gain);
+
+/**
+ * Biquad coefficients calculation, depending on the filter type, as
+ * rta_biquad_coefs_stride but faster.
+ *
+ * \see rta_biquad_coefs_fast
+ *
+ * @param b is a vector of feed-forward coefficients
+ * @param b_stride is 'b' stride
+ * @param a is a vector of feed-backward coefficients
+ * @param a_stride is 'a' stride
+ * @param type is the filter type (see rta_biquad_coefs)
+ * @param f0 is the cutoff frequency, normalised by the nyquist
+ * frequency. It must be >= 0. and <= 1.
+ * @param q must be > 0. and is generally >= 0.5 for audio
+ * filtering.
+ * @param gain is linear and must be > 0.
+ */
+void rta_biquad_coefs_fast_stride(
+  rta_real_t * b, const int b_stride,
+  rta_real_t * a, const int a_stride,
+  const rta_filter_t type,
+  const rta_real_t f0, const rta_real_t q,
+  const rta_real_t gain);
+
+/**
+ * Biquad coefficients calculation of many filters at once, as
+ * rta_biquad_coefs_fast for each filter.
+ *
+ * The sines and cosines of a group of filters are computed together,
+ * with vector instructions when available (see rta_biquadintern.h),
+ * before their coefficients. This is for many filters modulated at
+ * the same time, as for a bank of filters.
+ *
+ * \see rta_biquad_coefs_fast
+ *
+ * @param b is the vectors of feed-forward coefficients of the
+ * filters. Its size is 3 * 'size': b0, b1 and b2 of the first filter,
+ * then of the second, etc.
+ * @param a is the vectors of feed-backward coefficients of the
+ * filters. Its size is 2 * 'size': a1 and a2 of the first filter,
+ * then of the second, etc.
+ * @param types are the filter types (see rta_biquad_coefs). Its size
+ * is 'size'.
+ * @param f0 are the cutoff frequencies, normalised by the nyquist
+ * frequency. Each one must be >= 0. and <= 1. Its size is 'size'.
+ * @param q are the quality factors. Each one must be > 0. Its size
+ * is 'size'.
+ * @param gain are the linear gains. Each one must be > 0. Its size is
+ * 'size'.
+ * @param size is the number of filters
+ */
+void rta_biquad_coefs_batch(rta_real_t * b, rta_real_t * a,
+                            const rta_filter_t * types,
+                            const rta_real_t * f0, const rta_real_t * q,
+                            const rta_real_t * gain,
+                            const unsigned int size);
+
 /**
  * Biquad computation, using a direct form I.
  *
@@ -721,6 +805,229 @@ void rta_biquad_df2t_vector_stride(
   const rta_real_t * a, const int a_stride,
   rta_real_t * states, const int s_stride);
 
+/**
+ * Biquad computation on a vector of samples, using a direct form I,
+ * with coefficients interpolated over the vector.
+ *
+ * The coefficients move linearly, sample by sample, from the start
+ * values (excluded) to the end values (used by the last sample), so
+ * that consecutive vectors give a continuous ramp when the end values
+ * of a vector are the start values of the next one. This avoids the
+ * steps (zipper noise) of coefficients changed by vector, with only
+ * 2 coefficients calculations per vector (see rta_biquad_coefs) for
+ * a modulated filter. As the stability domain of (a1, a2) is convex,
+ * the filter stays stable between stable start and end values.
+ *
+ * The direct form I is preferable for fast modulations, as its
+ * states are only past inputs and outputs.
+ *
+ * \see rta_biquad_df1
+ *
+ * @param y is a vector of output samples. Its size is 'x_size'
+ * @param x is a vector of input samples. Its size is 'x_size'
+ * @param x_size is the size of 'y' and 'x'
+ * @param b_start is a vector of feed-forward coefficients before the
+ * first sample. b0 is b[0], b1 is b[1] and b2 is b[2].
+ * @param b_end is a vector of feed-forward coefficients of the last
+ * sample
+ * @param a_start is a vector of feed-backward coefficients before the
+ * first sample. Note that a1 is a[0] and a2 is a[1] (and a0 is
+ * supposed to be 1.).
+ * @param a_end is a vector of feed-backward coefficients of the last
+ * sample
+ * @param states is a vector of 4 elements: for an input 'x' and an
+ * output 'y', the states are, in that order, x(n-1), x(n-2), y(n-1),
+ * and y(n-2). Both can be initialised with 0. or the last computed
+ * values, which are updated by this function.
+ */
+void rta_biquad_df1_vector_ramp(rta_real_t * y,
+                                const rta_real_t * x, const unsigned int x_size,
+                                const rta_real_t * b_start, const rta_real_t * b_end,
+                                const rta_real_t * a_start, const rta_real_t * a_end,
+                                rta_real_t * states);
+
+/**
+ * Biquad computation on a vector of samples, using a transposed
+ * direct form II, with coefficients interpolated over the vector.
+ *
+ * The coefficients move linearly, sample by sample, from the start
+ * values (excluded) to the end values (used by the last sample), so
+ * that consecutive vectors give a continuous ramp when the end values
+ * of a vector are the start values of the next one. This avoids the
+ * steps (zipper noise) of coefficients changed by vector, with only
+ * 2 coefficients calculations per vector (see rta_biquad_coefs) for
+ * a modulated filter. As the stability domain of (a1, a2) is convex,
+ * the filter stays stable between stable start and end values.
+ *
+ * \see rta_biquad_df2t
+ *
+ * @param y is a vector of output samples. Its size is 'x_size'
+ * @param x is a vector of input samples. Its size is 'x_size'
+ * @param x_size is the size of 'y' and 'x'
+ * @param b_start is a vector of feed-forward coefficients before the
+ * first sample. b0 is b[0], b1 is b[1] and b2 is b[2].
+ * @param b_end is a vector of feed-forward coefficients of the last
+ * sample
+ * @param a_start is a vector of feed-backward coefficients before the
+ * first sample. Note that a1 is a[0] and a2 is a[1] (and a0 is
+ * supposed to be 1.).
+ * @param a_end is a vector of feed-backward coefficients of the last
+ * sample
+ * @param states is a vector of 2 elements: states[0] is the one
+ * sample delay state and states[1] is the two samples delay
+ * state. Both can be initialised with 0. or the last computed values,
+ * which are updated by this function.
+ */
+void rta_biquad_df2t_vector_ramp(rta_real_t * y,
+                                 const rta_real_t * x, const unsigned int x_size,
+                                 const rta_real_t * b_start, const rta_real_t * b_end,
+                                 const rta_real_t * a_start, const rta_real_t * a_end,
+                                 rta_real_t * states);
+
+/**
+ * Biquad computation on a vector of samples, using a direct form I,
+ * with coefficients interpolated over the vector.
+ *
+ * \see rta_biquad_df1_vector_ramp
+ *
+ * @param y is a vector of output samples. Its size is 'x_size'
+ * @param y_stride is 'y' stride
+ * @param x is a vector of input samples. Its size is 'x_size'
+ * @param x_stride is 'x' stride
+ * @param x_size is the size of 'y' and 'x'
+ * @param b_start is a vector of feed-forward coefficients before the
+ * first sample. b0 is b[0], b1 is b[1] and b2 is b[2].
+ * @param b_end is a vector of feed-forward coefficients of the last
+ * sample
+ * @param b_stride is 'b_start' and 'b_end' stride
+ * @param a_start is a vector of feed-backward coefficients before the
+ * first sample. Note that a1 is a[0] and a2 is a[1] (and a0 is
+ * supposed to be 1.).
+ * @param a_end is a vector of feed-backward coefficients of the last
+ * sample
+ * @param a_stride is 'a_start' and 'a_end' stride
+ * @param states is a vector of 4 elements: for an input 'x' and an
+ * output 'y', the states are, in that order, x(n-1), x(n-2), y(n-1),
+ * and y(n-2). Both can be initialised with 0. or the last computed
+ * values, which are updated by this function.
+ * @param s_stride is 'states' strides.
+ */
+void rta_biquad_df1_vector_ramp_stride(
+  rta_real_t * y, const int y_stride,
+  const rta_real_t * x, const int x_stride, const unsigned int x_size,
+  const rta_real_t * b_start, const rta_real_t * b_end, const int b_stride,
+  const rta_real_t * a_start, const rta_real_t * a_end, const int a_stride,
+  rta_real_t * states, const int s_stride);
+
+/**
+ * Biquad computation on a vector of samples, using a transposed
+ * direct form II, with coefficients interpolated over the vector.
+ *
+ * \see rta_biquad_df2t_vector_ramp
+ *
+ * @param y is a vector of output samples. Its size is 'x_size'
+ * @param y_stride is 'y' stride
+ * @param x is a vector of input samples. Its size is 'x_size'
+ * @param x_stride is 'x' stride
+ * @param x_size is the size of 'y' and 'x'
+ * @param b_start is a vector of feed-forward coefficients before the
+ * first sample. b0 is b[0], b1 is b[1] and b2 is b[2].
+ * @param b_end is a vector of feed-forward coefficients of the last
+ * sample
+ * @param b_stride is 'b_start' and 'b_end' stride
+ * @param a_start is a vector of feed-backward coefficients before the
+ * first sample. Note that a1 is a[0] and a2 is a[1] (and a0 is
+ * supposed to be 1.).
+ * @param a_end is a vector of feed-backward coefficients of the last
+ * sample
+ * @param a_stride is 'a_start' and 'a_end' stride
+ * @param states is a vector of 2 elements: states[0] is the one
+ * sample delay state and states[1] is the two samples delay
+ * state. Both can be initialised with 0. or the last computed values,
+ * which are updated by this function.
+ * @param s_stride is 'states' strides.
+ */
+void rta_biquad_df2t_vector_ramp_stride(
+  rta_real_t * y, const int y_stride,
+  const rta_real_t * x, const int x_stride, const unsigned int x_size,
+  const rta_real_t * b_start, const rta_real_t * b_end, const int b_stride,
+  const rta_real_t * a_start, const rta_real_t * a_end, const int a_stride,
+  rta_real_t * states, const int s_stride);
+
+/**
+ * Biquad computation on a vector of samples, using the state-space
+ * form of a transposed direct form II.
+ *
+ * The vector is processed by blocks of 8 samples: the outputs of a
+ * block are computed at once, with vector instructions, from its
+ * inputs and from the states at its start. The states are carried
+ * from a block to the next as by rta_biquad_df2t. This is much faster
+ * than rta_biquad_df2t_vector on long vectors, whose recursion is
+ * serial. Without vector instructions (see rta_biquadintern.h), this
+ * is rta_biquad_df2t_vector.
+ *
+ * The rounding errors differ from rta_biquad_df2t_vector, but do not
+ * accumulate over blocks for a stable filter. Compared to the same
+ * filter in higher precision, the maximum error on white noise is at
+ * most twice the error of rta_biquad_df2t_vector in single precision.
+ * Relative to the maximum output, this is 1e-7 to 1e-5 in single
+ * precision (1e-16 to 1e-13 in double precision), and up to 3e-3
+ * (4e-11) for a resonant low-pass filter at 0.001 of the Nyquist
+ * frequency, whose poles are close to 1. There, in double precision,
+ * the error is about 10 times the error of rta_biquad_df2t_vector.
+ *
+ * \see rta_biquad_df2t
+ *
+ * @param y is a vector of output samples. Its size is 'x_size'. It
+ * can be 'x' (in place).
+ * @param x is a vector of input samples. Its size is 'x_size'
+ * @param x_size is the size of 'y' and 'x'
+ * @param b is a vector of feed-forward coefficients. b0 is b[0], b1
+ * is b[1] and b2 is b[2].
+ * @param a is a vector of feed-backward coefficients. Note that a1 is
+ * a[0] and a2 is a[1] (and a0 is supposed to be 1.).
+ * @param states is a vector of 2 elements: states[0] is the one
+ * sample delay state and states[1] is the two samples delay
+ * state. Both can be initialised with 0. or the last computed values,
+ * which are updated by this function.
+ */
+void rta_biquad_df2t_vector_block(rta_real_t * y,
+                                  const rta_real_t * x,
+                                  const unsigned int x_size,
+                                  const rta_real_t * b, const rta_real_t * a,
+                                  rta_real_t * states);
+
+/**
+ * Biquad computation on a vector of samples, using the state-space
+ * form of a transposed direct form II.
+ *
+ * \see rta_biquad_df2t_vector_block
+ *
+ * @param y is a vector of output samples. Its size is 'x_size'. It
+ * can be 'x' (in place) with the same stride.
+ * @param y_stride is 'y' stride
+ * @param x is a vector of input samples. Its size is 'x_size'
+ * @param x_stride is 'x' stride
+ * @param x_size is the size of 'y' and 'x'
+ * @param b is a vector of feed-forward coefficients. b0 is b[0], b1
+ * is b[1] and b2 is b[2].
+ * @param b_stride is 'b' stride
+ * @param a is a vector of feed-backward coefficients. Note that a1 is
+ * a[0] and a2 is a[1] (and a0 is supposed to be 1.).
+ * @param a_stride is 'a' stride
+ * @param states is a vector of 2 elements: states[0] is the one
+ * sample delay state and states[1] is the two samples delay
+ * state. Both can be initialised with 0. or the last computed values,
+ * which are updated by this function.
+ * @param s_stride is 'states' strides.
+ */
+void rta_biquad_df2t_vector_block_stride(
+  rta_real_t * y, const int y_stride,
+  const rta_real_t * x, const int x_stride, const unsigned int x_size,
+  const rta_real_t * b, const int b_stride,
+  const rta_real_t * a, const int a_stride,
+  rta_real_t * states, const int s_stride);
+
 #ifdef __cplusplus
 }
 #endif
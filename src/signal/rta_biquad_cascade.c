@@ -0,0 +1,306 @@
+/**
+ * @file   rta_biquad_cascade.c
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_signal
+ *
+ * @brief  Cascades of biquad filters on many channels
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rta_biquad_cascade.h"
+#include "rta_biquadintern.h"
+#include "rta_stdlib.h" /* memory management */
+
+/* frames filtered by each section in turn, so that the buffer of */
+/* a group of channels stays in the cache */
+#define RTA_BIQUAD_CASCADE_BLOCK 64
+
+/* values of the coefficients and states of a section of a group */
+#define RTA_BIQUAD_CASCADE_COEFS (5 * RTA_BIQUAD_LANES)
+#define RTA_BIQUAD_CASCADE_STATES (2 * RTA_BIQUAD_LANES)
+
+struct rta_biquad_cascade_setup
+{
+  unsigned int sections;
+  unsigned int channels;
+  unsigned int groups; /* of RTA_BIQUAD_LANES channels */
+
+  /* for each group, each section: RTA_BIQUAD_LANES values of */
+  /* b0, b1, b2, a1 and a2, then of the 2 states */
+  rta_real_t * coefs;
+  rta_real_t * states;
+
+  rta_real_t * buffer; /* RTA_BIQUAD_CASCADE_BLOCK frames of a group */
+  rta_biquad_lanes_kernel_t df2t_lanes;
+};
+
+/* scalar version of the rta_biquad_lanes_kernel_t kernels */
+static void
+df2t_lanes(rta_real_t * buffer, const unsigned int frames,
+           const rta_real_t * coefs, rta_real_t * states)
+{
+  const unsigned int w = RTA_BIQUAD_LANES;
+  const rta_real_t * b0 = coefs;
+  const rta_real_t * b1 = coefs + w;
+  const rta_real_t * b2 = coefs + 2 * w;
+  const rta_real_t * a1 = coefs + 3 * w;
+  const rta_real_t * a2 = coefs + 4 * w;
+  rta_real_t * s0 = states;
+  rta_real_t * s1 = states + w;
+  unsigned int f, l;
+
+  for(f=0; f<frames; f++)
+  {
+    rta_real_t * x = buffer + f * w;
+
+    for(l=0; l<w; l++)
+    {
+      const rta_real_t y = b0[l] * x[l] + s0[l];
+
+      s0[l] = b1[l] * x[l] - a1[l] * y + s1[l];
+      s1[l] = b2[l] * x[l] - a2[l] * y;
+      x[l] = y;
+    }
+  }
+  return;
+}
+
+int
+rta_biquad_cascade_setup_new(rta_biquad_cascade_setup_t ** cascade_setup,
+                             const unsigned int sections,
+                             const unsigned int channels)
+{
+  int ret = 0;
+  rta_biquad_cascade_setup_t * s;
+
+  if(sections > 0 && channels > 0)
+  {
+    *cascade_setup = (rta_biquad_cascade_setup_t *)
+      rta_malloc(sizeof(rta_biquad_cascade_setup_t));
+  }
+  else
+  {
+    *cascade_setup = NULL;
+  }
+
+  s = *cascade_setup;
+  if(s != NULL)
+  {
+    const unsigned int groups =
+      (channels + RTA_BIQUAD_LANES - 1) / RTA_BIQUAD_LANES;
+    const rta_biquad_simd_t * simd = rta_biquad_simd_get();
+    unsigned int i;
+
+    s->sections = sections;
+    s->channels = channels;
+    s->groups = groups;
+    s->df2t_lanes = (simd != NULL) ? simd->df2t_lanes : df2t_lanes;
+
+    s->coefs = (rta_real_t *) rta_malloc(
+      sizeof(rta_real_t) * groups * sections * RTA_BIQUAD_CASCADE_COEFS);
+    s->states = (rta_real_t *) rta_malloc(
+      sizeof(rta_real_t) * groups * sections * RTA_BIQUAD_CASCADE_STATES);
+    s->buffer = (rta_real_t *) rta_malloc(
+      sizeof(rta_real_t) * RTA_BIQUAD_CASCADE_BLOCK * RTA_BIQUAD_LANES);
+
+    if(s->coefs != NULL && s->states != NULL && s->buffer != NULL)
+    {
+      /* identity, also for the unused lanes of the last group */
+      for(i=0; i<groups * sections * RTA_BIQUAD_CASCADE_COEFS; i++)
+      {
+        s->coefs[i] = (i % RTA_BIQUAD_CASCADE_COEFS < RTA_BIQUAD_LANES) ?
+          1. : 0.;
+      }
+      rta_biquad_cascade_setup_clear(s);
+      ret = 1;
+    }
+    else
+    {
+      rta_biquad_cascade_setup_delete(s);
+      *cascade_setup = NULL;
+    }
+  }
+
+  return ret;
+}
+
+void
+rta_biquad_cascade_setup_clear(rta_biquad_cascade_setup_t * cascade_setup)
+{
+  const unsigned int size = cascade_setup->groups * cascade_setup->sections *
+    RTA_BIQUAD_CASCADE_STATES;
+  unsigned int i;
+
+  for(i=0; i<size; i++)
+  {
+    cascade_setup->states[i] = 0.;
+  }
+  return;
+}
+
+void
+rta_biquad_cascade_setup_delete(rta_biquad_cascade_setup_t * cascade_setup)
+{
+  if(cascade_setup != NULL)
+  {
+    if(cascade_setup->coefs != NULL)
+    {
+      rta_free(cascade_setup->coefs);
+    }
+
+    if(cascade_setup->states != NULL)
+    {
+      rta_free(cascade_setup->states);
+    }
+
+    if(cascade_setup->buffer != NULL)
+    {
+      rta_free(cascade_setup->buffer);
+    }
+
+    rta_free(cascade_setup);
+  }
+  return;
+}
+
+int
+rta_biquad_cascade_set_coefs(rta_biquad_cascade_setup_t * cascade_setup,
+                             const unsigned int section,
+                             const unsigned int channel,
+                             const rta_real_t * b, const rta_real_t * a)
+{
+  return rta_biquad_cascade_set_coefs_stride(cascade_setup, section, channel,
+                                             b, 1, a, 1);
+}
+
+int
+rta_biquad_cascade_set_coefs_stride(
+  rta_biquad_cascade_setup_t * cascade_setup,
+  const unsigned int section, const unsigned int channel,
+  const rta_real_t * b, const int b_stride,
+  const rta_real_t * a, const int a_stride)
+{
+  int ret = 0;
+  rta_biquad_cascade_setup_t * s = cascade_setup;
+
+  if(section < s->sections && channel < s->channels)
+  {
+    rta_real_t * coefs = s->coefs + channel % RTA_BIQUAD_LANES +
+      ((channel / RTA_BIQUAD_LANES) * s->sections + section) *
+      RTA_BIQUAD_CASCADE_COEFS;
+
+    coefs[0] = b[0];
+    coefs[RTA_BIQUAD_LANES] = b[b_stride];
+    coefs[2 * RTA_BIQUAD_LANES] = b[2 * b_stride];
+    coefs[3 * RTA_BIQUAD_LANES] = a[0];
+    coefs[4 * RTA_BIQUAD_LANES] = a[a_stride];
+    ret = 1;
+  }
+
+  return ret;
+}
+
+void
+rta_biquad_cascade_process(rta_real_t * output, const rta_real_t * input,
+                           const unsigned int frames,
+                           rta_biquad_cascade_setup_t * cascade_setup)
+{
+  rta_biquad_cascade_process_stride(output, cascade_setup->channels,
+                                    input, cascade_setup->channels,
+                                    frames, cascade_setup);
+  return;
+}
+
+void
+rta_biquad_cascade_process_stride(
+  rta_real_t * output, const int o_stride,
+  const rta_real_t * input, const int i_stride,
+  const unsigned int frames,
+  rta_biquad_cascade_setup_t * cascade_setup)
+{
+  rta_biquad_cascade_setup_t * s = cascade_setup;
+  const unsigned int w = RTA_BIQUAD_LANES;
+  rta_real_t * buffer = s->buffer;
+  unsigned int start, size, g, n, lanes, f, l;
+
+  for(start=0; start<frames; start+=size)
+  {
+    size = frames - start;
+    if(size > RTA_BIQUAD_CASCADE_BLOCK)
+    {
+      size = RTA_BIQUAD_CASCADE_BLOCK;
+    }
+
+    for(g=0; g<s->groups; g++)
+    {
+      const rta_real_t * coefs =
+        s->coefs + g * s->sections * RTA_BIQUAD_CASCADE_COEFS;
+      rta_real_t * states =
+        s->states + g * s->sections * RTA_BIQUAD_CASCADE_STATES;
+      const rta_real_t * x = input + start * i_stride + g * w;
+      rta_real_t * y = output + start * o_stride + g * w;
+
+      lanes = (s->channels - g * w < w) ? s->channels - g * w : w;
+
+      /* the unused lanes of the last group filter zeros */
+      for(f=0; f<size; f++)
+      {
+        for(l=0; l<lanes; l++)
+        {
+          buffer[f * w + l] = x[f * i_stride + l];
+        }
+
+        for(; l<w; l++)
+        {
+          buffer[f * w + l] = 0.;
+        }
+      }
+
+      for(n=0; n<s->sections; n++)
+      {
+        (*s->df2t_lanes)(buffer, size,
+                         coefs + n * RTA_BIQUAD_CASCADE_COEFS,
+                         states + n * RTA_BIQUAD_CASCADE_STATES);
+      }
+
+      for(f=0; f<size; f++)
+      {
+        for(l=0; l<lanes; l++)
+        {
+          y[f * o_stride + l] = buffer[f * w + l];
+        }
+      }
+    }
+  }
+
+  return;
+}
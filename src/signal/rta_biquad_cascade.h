@@ -0,0 +1,197 @@
+/**
+ * @file   rta_biquad_cascade.h
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_signal
+ *
+ * @brief  Cascades of biquad filters on many channels
+ *
+ * Each channel of an interleaved signal is filtered by its own
+ * cascade of biquad sections, in transposed direct form II (see
+ * rta_biquad_df2t). The channels are processed together, by groups
+ * filling the vector registers, so that the serial time recursions of
+ * the different channels run in parallel. The coefficients and the
+ * states are stored by groups of channels (structure of arrays).
+ *
+ * For every function, a1 is a[0] and a2 is a[1]. b0 is b[0], b1 is
+ * b[1] and b2 is b[2] (see rta_biquad.h).
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _RTA_BIQUAD_CASCADE_H_
+#define _RTA_BIQUAD_CASCADE_H_ 1
+
+#include "rta.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* rta_biquad_cascade_setup is private (depends on implementation) */
+typedef struct rta_biquad_cascade_setup rta_biquad_cascade_setup_t;
+
+/**
+ * Allocate and initialize a setup for 'channels' cascades of
+ * 'sections' biquads each.
+ *
+ * All the sections pass their input unchanged (b0 = 1, the other
+ * coefficients are 0) and the states are cleared. All the memory is
+ * allocated here.
+ *
+ * \see rta_biquad_cascade_setup_delete
+ * \see rta_biquad_cascade_set_coefs
+ * \see rta_biquad_cascade_process
+ *
+ * @param cascade_setup is an address of a pointer to a private
+ * structure. This function allocates 'cascade_setup' and fills it.
+ * @param sections is the number of biquads of each channel. It must
+ * be > 0.
+ * @param channels is the number of channels. It must be > 0.
+ *
+ * @return 1 on success 0 on fail. If it fails, nothing should be done
+ * with 'cascade_setup' (even a delete).
+ */
+int
+rta_biquad_cascade_setup_new(rta_biquad_cascade_setup_t ** cascade_setup,
+                             const unsigned int sections,
+                             const unsigned int channels);
+
+/**
+ * Clear the states of all the biquads of a cascade setup, as after
+ * its allocation. The coefficients are kept.
+ *
+ * @param cascade_setup is a pointer to a private structure
+ */
+void
+rta_biquad_cascade_setup_clear(rta_biquad_cascade_setup_t * cascade_setup);
+
+/**
+ * Deallocate any (successfully) allocated cascade setup.
+ *
+ * @param cascade_setup is a pointer to a private structure
+ */
+void
+rta_biquad_cascade_setup_delete(rta_biquad_cascade_setup_t * cascade_setup);
+
+/**
+ * Set the coefficients of a biquad of a cascade setup. The states are
+ * kept.
+ *
+ * @param cascade_setup is a pointer to a private structure
+ * @param section is the index of the biquad in the cascade
+ * @param channel is the index of the channel
+ * @param b is a vector of feed-forward coefficients. b0 is b[0], b1
+ * is b[1] and b2 is b[2].
+ * @param a is a vector of feed-backward coefficients. Note that a1 is
+ * a[0] and a2 is a[1] (and a0 is supposed to be 1.).
+ *
+ * @return 1 on success 0 on fail ('section' or 'channel' out of
+ * range). If it fails, 'cascade_setup' is unchanged.
+ */
+int
+rta_biquad_cascade_set_coefs(rta_biquad_cascade_setup_t * cascade_setup,
+                             const unsigned int section,
+                             const unsigned int channel,
+                             const rta_real_t * b, const rta_real_t * a);
+
+/**
+ * Set the coefficients of a biquad of a cascade setup. The states are
+ * kept.
+ *
+ * @param cascade_setup is a pointer to a private structure
+ * @param section is the index of the biquad in the cascade
+ * @param channel is the index of the channel
+ * @param b is a vector of feed-forward coefficients. b0 is b[0], b1
+ * is b[1] and b2 is b[2].
+ * @param b_stride is 'b' stride
+ * @param a is a vector of feed-backward coefficients. Note that a1 is
+ * a[0] and a2 is a[1] (and a0 is supposed to be 1.).
+ * @param a_stride is 'a' stride
+ *
+ * @return 1 on success 0 on fail ('section' or 'channel' out of
+ * range). If it fails, 'cascade_setup' is unchanged.
+ */
+int
+rta_biquad_cascade_set_coefs_stride(
+  rta_biquad_cascade_setup_t * cascade_setup,
+  const unsigned int section, const unsigned int channel,
+  const rta_real_t * b, const int b_stride,
+  const rta_real_t * a, const int a_stride);
+
+/**
+ * Filter 'frames' frames of an interleaved signal, each channel by its
+ * cascade of biquads.
+ *
+ * This function can run in place if 'output' == 'input'. It allocates
+ * no memory.
+ *
+ * @param output size is 'frames' * 'channels', with the channels of a
+ * frame contiguous
+ * @param input size is 'frames' * 'channels', with the channels of a
+ * frame contiguous
+ * @param frames is the number of frames to filter
+ * @param cascade_setup is a pointer to a private structure
+ */
+void
+rta_biquad_cascade_process(rta_real_t * output, const rta_real_t * input,
+                           const unsigned int frames,
+                           rta_biquad_cascade_setup_t * cascade_setup);
+
+/**
+ * Filter 'frames' frames of an interleaved signal, each channel by its
+ * cascade of biquads.
+ *
+ * This function can run in place if 'output' == 'input' and
+ * 'o_stride' == 'i_stride'. It allocates no memory.
+ *
+ * @param output size is 'frames' * 'o_stride', with the channels of a
+ * frame contiguous
+ * @param o_stride is the distance between the frames of 'output'. It
+ * must be >= 'channels'.
+ * @param input size is 'frames' * 'i_stride', with the channels of a
+ * frame contiguous
+ * @param i_stride is the distance between the frames of 'input'. It
+ * must be >= 'channels'.
+ * @param frames is the number of frames to filter
+ * @param cascade_setup is a pointer to a private structure
+ */
+void
+rta_biquad_cascade_process_stride(
+  rta_real_t * output, const int o_stride,
+  const rta_real_t * input, const int i_stride,
+  const unsigned int frames,
+  rta_biquad_cascade_setup_t * cascade_setup);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTA_BIQUAD_CASCADE_H_ */
@@ -0,0 +1,149 @@
+/**
+ * @file   rta_biquadintern.h
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_signal
+ *
+ * @brief  private declarations for the biquad filters
+ *
+ * Vectorised (SIMD) biquad kernels, selected at run time by
+ * rta_biquad_cascade.c and rta_biquad.c.
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _RTA_BIQUADINTERN_H_
+#define _RTA_BIQUADINTERN_H_ 1
+
+#include "rta.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of channels filtered together (a multiple of any vector width) */
+#define RTA_BIQUAD_LANES 8
+
+/**
+ * Transposed direct form II biquad on RTA_BIQUAD_LANES channels.
+ *
+ * The time recursion is serial, each lane being a channel. The states
+ * stay in registers over the whole buffer.
+ *
+ * \param buffer holds 'frames' * RTA_BIQUAD_LANES values, frame after
+ * frame, filtered in place
+ * \param frames is the number of frames of 'buffer'
+ * \param coefs holds RTA_BIQUAD_LANES values of b0, then of b1, b2,
+ * a1 and a2
+ * \param states holds RTA_BIQUAD_LANES values of the one sample delay
+ * states, then of the two samples delay states. They are updated.
+ */
+typedef void (*rta_biquad_lanes_kernel_t)(rta_real_t * buffer,
+                                          const unsigned int frames,
+                                          const rta_real_t * coefs,
+                                          rta_real_t * states);
+
+/** Number of samples of a block of the state-space biquad */
+#define RTA_BIQUAD_BLOCK 8
+
+/**
+ * Transposed direct form II biquad on one channel, computing blocks of
+ * RTA_BIQUAD_BLOCK samples at once from the state-space form.
+ *
+ * The outputs of a block are the products of the inputs of the block
+ * and of the states at its start by 'matrix'. Only the states are
+ * carried from a block to the next: they are computed from the last 2
+ * inputs and outputs of the block, as by rta_biquad_df2t.
+ *
+ * \param y is the output, of size 'x_size'. It can be 'x' (in place).
+ * \param x is the input, of size 'x_size'
+ * \param x_size is the number of samples
+ * \param b is b0, b1 and b2
+ * \param a is a1 and a2
+ * \param matrix holds RTA_BIQUAD_BLOCK + 2 columns of RTA_BIQUAD_BLOCK
+ * values: the responses of the block to each of its input samples,
+ * then to the one and two samples delay states
+ * \param states are the one and two samples delay states. They are
+ * updated.
+ *
+ * \return the number of samples computed, a multiple of
+ * RTA_BIQUAD_BLOCK. The remaining samples are left to the scalar code.
+ */
+typedef unsigned int (*rta_biquad_block_kernel_t)(rta_real_t * y,
+                                                  const rta_real_t * x,
+                                                  const unsigned int x_size,
+                                                  const rta_real_t * b,
+                                                  const rta_real_t * a,
+                                                  const rta_real_t * matrix,
+                                                  rta_real_t * states);
+
+/**
+ * Sines and cosines of normalised frequencies, for the biquad
+ * coefficients, by the polynomials of rta_biquad.c.
+ *
+ * \param s is sin(M_PI * f0), of size 'size'
+ * \param c is cos(M_PI * f0), of size 'size'
+ * \param f0 are the frequencies, >= 0. and <= 1., of size 'size'
+ * \param size is the number of frequencies
+ *
+ * \return the number of frequencies computed, a multiple of the
+ * vector width. The remaining ones are left to the scalar code.
+ */
+typedef unsigned int (*rta_biquad_sincos_kernel_t)(rta_real_t * s,
+                                                   rta_real_t * c,
+                                                   const rta_real_t * f0,
+                                                   const unsigned int size);
+
+/** Set of vectorised kernels for an instruction set */
+typedef struct
+{
+  const char * name; /**< instruction set */
+  rta_biquad_lanes_kernel_t df2t_lanes;
+  rta_biquad_block_kernel_t df2t_block;
+  rta_biquad_sincos_kernel_t sincos;
+} rta_biquad_simd_t;
+
+/**
+ * Select the vectorised kernels for the running processor.
+ *
+ * AVX2 (with FMA) is detected at run time on x86 with GCC compatible
+ * compilers, NEON is used when compiled for ARM with NEON support and
+ * single precision.
+ *
+ * \return the kernels of the best available instruction set, or NULL
+ * if none is supported (then use the scalar code)
+ */
+const rta_biquad_simd_t * rta_biquad_simd_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTA_BIQUADINTERN_H_ */
@@ -0,0 +1,510 @@
+/**
+ * @file   rta_biquadsimd.c
+ * @date   Sun Oct 18 2026
+ *
+ * @brief  Vectorised biquad kernels
+ *
+ * AVX2 and NEON versions of the transposed direct form II of
+ * rta_biquad.c: on RTA_BIQUAD_LANES channels at once, each lane being
+ * a channel and the states staying in registers over a whole buffer;
+ * or on one channel, by blocks of RTA_BIQUAD_BLOCK samples of the
+ * state-space form. The sines and cosines of the biquad coefficients
+ * are computed by vectors of frequencies. The first and the last
+ * compute the same values as the scalar code, with the usual rounding
+ * differences (AVX2 uses fused multiply-add).
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rta_biquadintern.h"
+#include "rta_math.h" /* M_PI */
+
+#include <stddef.h> /* NULL */
+
+/* x86 kernels need the GCC (or clang) target attributes and CPU detection */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+  (RTA_REAL_TYPE == RTA_FLOAT_TYPE || RTA_REAL_TYPE == RTA_DOUBLE_TYPE)
+#define RTA_BIQUAD_USE_X86 1
+#include <immintrin.h>
+#endif
+
+#if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && \
+  (RTA_REAL_TYPE == RTA_FLOAT_TYPE)
+#define RTA_BIQUAD_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* ------- AVX2, single precision --------------------------------------- */
+#if defined(RTA_BIQUAD_USE_X86) && (RTA_REAL_TYPE == RTA_FLOAT_TYPE)
+
+/* one vector of 8 lanes */
+static __attribute__((target("avx2,fma"))) void
+df2t_lanes_avx2(rta_real_t * buffer, const unsigned int frames,
+                const rta_real_t * coefs, rta_real_t * states)
+{
+  const unsigned int w = RTA_BIQUAD_LANES;
+  const __m256 b0 = _mm256_loadu_ps(coefs);
+  const __m256 b1 = _mm256_loadu_ps(coefs + w);
+  const __m256 b2 = _mm256_loadu_ps(coefs + 2 * w);
+  const __m256 a1 = _mm256_loadu_ps(coefs + 3 * w);
+  const __m256 a2 = _mm256_loadu_ps(coefs + 4 * w);
+  __m256 s0 = _mm256_loadu_ps(states);
+  __m256 s1 = _mm256_loadu_ps(states + w);
+  unsigned int f;
+
+  for(f=0; f<frames; f++)
+  {
+    const __m256 x = _mm256_loadu_ps(buffer + f * w);
+    const __m256 y = _mm256_fmadd_ps(b0, x, s0);
+
+    s0 = _mm256_fnmadd_ps(a1, y, _mm256_fmadd_ps(b1, x, s1));
+    s1 = _mm256_fnmadd_ps(a2, y, _mm256_mul_ps(b2, x));
+    _mm256_storeu_ps(buffer + f * w, y);
+  }
+
+  _mm256_storeu_ps(states, s0);
+  _mm256_storeu_ps(states + w, s1);
+  return;
+}
+
+/* the columns of the block matrix are vectors of 8 samples */
+static __attribute__((target("avx2,fma"))) unsigned int
+df2t_block_avx2(rta_real_t * y, const rta_real_t * x,
+                const unsigned int x_size,
+                const rta_real_t * b, const rta_real_t * a,
+                const rta_real_t * matrix, rta_real_t * states)
+{
+  const unsigned int n = RTA_BIQUAD_BLOCK;
+  rta_real_t s0 = states[0];
+  rta_real_t s1 = states[1];
+  unsigned int i, k;
+
+  for(i=0; i + n <= x_size; i += n)
+  {
+    const rta_real_t * xi = x + i;
+    const rta_real_t x1 = xi[n - 2];
+    const rta_real_t x0 = xi[n - 1];
+    __m256 y0 = _mm256_setzero_ps();
+    __m256 y1 = _mm256_setzero_ps();
+    rta_real_t yl1, yl0;
+
+    /* input part, independent of the previous blocks */
+    for(k=0; k<n; k+=2)
+    {
+      y0 = _mm256_fmadd_ps(_mm256_broadcast_ss(xi + k),
+                           _mm256_loadu_ps(matrix + k * n), y0);
+      y1 = _mm256_fmadd_ps(_mm256_broadcast_ss(xi + k + 1),
+                           _mm256_loadu_ps(matrix + (k + 1) * n), y1);
+    }
+
+    y0 = _mm256_fmadd_ps(_mm256_set1_ps(s0),
+                         _mm256_loadu_ps(matrix + n * n), y0);
+    y1 = _mm256_fmadd_ps(_mm256_set1_ps(s1),
+                         _mm256_loadu_ps(matrix + (n + 1) * n), y1);
+    _mm256_storeu_ps(y + i, _mm256_add_ps(y0, y1));
+
+    yl1 = y[i + n - 2];
+    yl0 = y[i + n - 1];
+    s0 = b[1] * x0 - a[0] * yl0 + b[2] * x1 - a[1] * yl1;
+    s1 = b[2] * x0 - a[1] * yl0;
+  }
+
+  states[0] = s0;
+  states[1] = s1;
+  return i;
+}
+
+static __attribute__((target("avx2,fma"))) unsigned int
+sincos_avx2(rta_real_t * s, rta_real_t * c, const rta_real_t * f0,
+            const unsigned int size)
+{
+  const __m256 one = _mm256_set1_ps(1.);
+  const __m256 half = _mm256_set1_ps(0.5);
+  const __m256 quarter = _mm256_set1_ps(0.25);
+  const __m256 pi = _mm256_set1_ps(M_PI);
+  const __m256 sign = _mm256_set1_ps(-0.);
+  unsigned int i;
+
+  for(i=0; i + 8 <= size; i += 8)
+  {
+    const __m256 f0v = _mm256_loadu_ps(f0 + i);
+    const __m256 upper = _mm256_cmp_ps(f0v, half, _CMP_GT_OQ);
+    const __m256 f = _mm256_blendv_ps(f0v, _mm256_sub_ps(one, f0v), upper);
+    const __m256 swap = _mm256_cmp_ps(f, quarter, _CMP_GT_OQ);
+    const __m256 x =
+      _mm256_mul_ps(pi, _mm256_blendv_ps(f, _mm256_sub_ps(half, f), swap));
+    const __m256 x2 = _mm256_mul_ps(x, x);
+    __m256 ps = _mm256_set1_ps(-1. / 39916800.);
+    __m256 pc = _mm256_set1_ps(1. / 479001600.);
+
+    ps = _mm256_fmadd_ps(ps, x2, _mm256_set1_ps(1. / 362880.));
+    ps = _mm256_fmadd_ps(ps, x2, _mm256_set1_ps(-1. / 5040.));
+    ps = _mm256_fmadd_ps(ps, x2, _mm256_set1_ps(1. / 120.));
+    ps = _mm256_fmadd_ps(ps, x2, _mm256_set1_ps(-1. / 6.));
+    ps = _mm256_fmadd_ps(ps, x2, one);
+    ps = _mm256_mul_ps(ps, x);
+
+    pc = _mm256_fmadd_ps(pc, x2, _mm256_set1_ps(-1. / 3628800.));
+    pc = _mm256_fmadd_ps(pc, x2, _mm256_set1_ps(1. / 40320.));
+    pc = _mm256_fmadd_ps(pc, x2, _mm256_set1_ps(-1. / 720.));
+    pc = _mm256_fmadd_ps(pc, x2, _mm256_set1_ps(1. / 24.));
+    pc = _mm256_fmadd_ps(pc, x2, _mm256_set1_ps(-0.5));
+    pc = _mm256_fmadd_ps(pc, x2, one);
+
+    _mm256_storeu_ps(s + i, _mm256_blendv_ps(ps, pc, swap));
+    _mm256_storeu_ps(c + i, _mm256_xor_ps(_mm256_blendv_ps(pc, ps, swap),
+                                          _mm256_and_ps(upper, sign)));
+  }
+
+  return i;
+}
+
+#endif /* single precision x86 */
+
+/* ------- AVX2, double precision --------------------------------------- */
+#if defined(RTA_BIQUAD_USE_X86) && (RTA_REAL_TYPE == RTA_DOUBLE_TYPE)
+
+/* two vectors of 4 lanes, for independent recursions in flight */
+static __attribute__((target("avx2,fma"))) void
+df2t_lanes_avx2(rta_real_t * buffer, const unsigned int frames,
+                const rta_real_t * coefs, rta_real_t * states)
+{
+  const unsigned int w = RTA_BIQUAD_LANES;
+  const __m256d b0l = _mm256_loadu_pd(coefs);
+  const __m256d b0h = _mm256_loadu_pd(coefs + 4);
+  const __m256d b1l = _mm256_loadu_pd(coefs + w);
+  const __m256d b1h = _mm256_loadu_pd(coefs + w + 4);
+  const __m256d b2l = _mm256_loadu_pd(coefs + 2 * w);
+  const __m256d b2h = _mm256_loadu_pd(coefs + 2 * w + 4);
+  const __m256d a1l = _mm256_loadu_pd(coefs + 3 * w);
+  const __m256d a1h = _mm256_loadu_pd(coefs + 3 * w + 4);
+  const __m256d a2l = _mm256_loadu_pd(coefs + 4 * w);
+  const __m256d a2h = _mm256_loadu_pd(coefs + 4 * w + 4);
+  __m256d s0l = _mm256_loadu_pd(states);
+  __m256d s0h = _mm256_loadu_pd(states + 4);
+  __m256d s1l = _mm256_loadu_pd(states + w);
+  __m256d s1h = _mm256_loadu_pd(states + w + 4);
+  unsigned int f;
+
+  for(f=0; f<frames; f++)
+  {
+    const __m256d xl = _mm256_loadu_pd(buffer + f * w);
+    const __m256d xh = _mm256_loadu_pd(buffer + f * w + 4);
+    const __m256d yl = _mm256_fmadd_pd(b0l, xl, s0l);
+    const __m256d yh = _mm256_fmadd_pd(b0h, xh, s0h);
+
+    s0l = _mm256_fnmadd_pd(a1l, yl, _mm256_fmadd_pd(b1l, xl, s1l));
+    s0h = _mm256_fnmadd_pd(a1h, yh, _mm256_fmadd_pd(b1h, xh, s1h));
+    s1l = _mm256_fnmadd_pd(a2l, yl, _mm256_mul_pd(b2l, xl));
+    s1h = _mm256_fnmadd_pd(a2h, yh, _mm256_mul_pd(b2h, xh));
+    _mm256_storeu_pd(buffer + f * w, yl);
+    _mm256_storeu_pd(buffer + f * w + 4, yh);
+  }
+
+  _mm256_storeu_pd(states, s0l);
+  _mm256_storeu_pd(states + 4, s0h);
+  _mm256_storeu_pd(states + w, s1l);
+  _mm256_storeu_pd(states + w + 4, s1h);
+  return;
+}
+
+/* the columns of the block matrix are 2 vectors of 4 samples */
+static __attribute__((target("avx2,fma"))) unsigned int
+df2t_block_avx2(rta_real_t * y, const rta_real_t * x,
+                const unsigned int x_size,
+                const rta_real_t * b, const rta_real_t * a,
+                const rta_real_t * matrix, rta_real_t * states)
+{
+  const unsigned int n = RTA_BIQUAD_BLOCK;
+  rta_real_t s0 = states[0];
+  rta_real_t s1 = states[1];
+  unsigned int i, k;
+
+  for(i=0; i + n <= x_size; i += n)
+  {
+    const rta_real_t * xi = x + i;
+    const rta_real_t x1 = xi[n - 2];
+    const rta_real_t x0 = xi[n - 1];
+    __m256d yl = _mm256_mul_pd(_mm256_set1_pd(s0),
+                               _mm256_loadu_pd(matrix + n * n));
+    __m256d yh = _mm256_mul_pd(_mm256_set1_pd(s0),
+                               _mm256_loadu_pd(matrix + n * n + 4));
+    rta_real_t yl1, yl0;
+
+    yl = _mm256_fmadd_pd(_mm256_set1_pd(s1),
+                         _mm256_loadu_pd(matrix + (n + 1) * n), yl);
+    yh = _mm256_fmadd_pd(_mm256_set1_pd(s1),
+                         _mm256_loadu_pd(matrix + (n + 1) * n + 4), yh);
+
+    for(k=0; k<n; k++)
+    {
+      const __m256d xk = _mm256_broadcast_sd(xi + k);
+
+      yl = _mm256_fmadd_pd(xk, _mm256_loadu_pd(matrix + k * n), yl);
+      yh = _mm256_fmadd_pd(xk, _mm256_loadu_pd(matrix + k * n + 4), yh);
+    }
+
+    _mm256_storeu_pd(y + i, yl);
+    _mm256_storeu_pd(y + i + 4, yh);
+
+    yl1 = y[i + n - 2];
+    yl0 = y[i + n - 1];
+    s0 = b[1] * x0 - a[0] * yl0 + b[2] * x1 - a[1] * yl1;
+    s1 = b[2] * x0 - a[1] * yl0;
+  }
+
+  states[0] = s0;
+  states[1] = s1;
+  return i;
+}
+
+static __attribute__((target("avx2,fma"))) unsigned int
+sincos_avx2(rta_real_t * s, rta_real_t * c, const rta_real_t * f0,
+            const unsigned int size)
+{
+  const __m256d one = _mm256_set1_pd(1.);
+  const __m256d half = _mm256_set1_pd(0.5);
+  const __m256d quarter = _mm256_set1_pd(0.25);
+  const __m256d pi = _mm256_set1_pd(M_PI);
+  const __m256d sign = _mm256_set1_pd(-0.);
+  unsigned int i;
+
+  for(i=0; i + 4 <= size; i += 4)
+  {
+    const __m256d f0v = _mm256_loadu_pd(f0 + i);
+    const __m256d upper = _mm256_cmp_pd(f0v, half, _CMP_GT_OQ);
+    const __m256d f = _mm256_blendv_pd(f0v, _mm256_sub_pd(one, f0v), upper);
+    const __m256d swap = _mm256_cmp_pd(f, quarter, _CMP_GT_OQ);
+    const __m256d x =
+      _mm256_mul_pd(pi, _mm256_blendv_pd(f, _mm256_sub_pd(half, f), swap));
+    const __m256d x2 = _mm256_mul_pd(x, x);
+    __m256d ps = _mm256_set1_pd(-1. / 39916800.);
+    __m256d pc = _mm256_set1_pd(1. / 479001600.);
+
+    ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(1. / 362880.));
+    ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(-1. / 5040.));
+    ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(1. / 120.));
+    ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(-1. / 6.));
+    ps = _mm256_fmadd_pd(ps, x2, one);
+    ps = _mm256_mul_pd(ps, x);
+
+    pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(-1. / 3628800.));
+    pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(1. / 40320.));
+    pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(-1. / 720.));
+    pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(1. / 24.));
+    pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(-0.5));
+    pc = _mm256_fmadd_pd(pc, x2, one);
+
+    _mm256_storeu_pd(s + i, _mm256_blendv_pd(ps, pc, swap));
+    _mm256_storeu_pd(c + i, _mm256_xor_pd(_mm256_blendv_pd(pc, ps, swap),
+                                          _mm256_and_pd(upper, sign)));
+  }
+
+  return i;
+}
+
+#endif /* double precision x86 */
+
+#if defined(RTA_BIQUAD_USE_X86)
+static const rta_biquad_simd_t biquad_simd_avx2 =
+{
+  "avx2",
+  df2t_lanes_avx2,
+  df2t_block_avx2,
+  sincos_avx2
+};
+#endif /* RTA_BIQUAD_USE_X86 */
+
+/* ------- NEON, single precision --------------------------------------- */
+#if defined(RTA_BIQUAD_USE_NEON)
+
+/* two vectors of 4 lanes, for independent recursions in flight */
+static void
+df2t_lanes_neon(rta_real_t * buffer, const unsigned int frames,
+                const rta_real_t * coefs, rta_real_t * states)
+{
+  const unsigned int w = RTA_BIQUAD_LANES;
+  const float32x4_t b0l = vld1q_f32(coefs);
+  const float32x4_t b0h = vld1q_f32(coefs + 4);
+  const float32x4_t b1l = vld1q_f32(coefs + w);
+  const float32x4_t b1h = vld1q_f32(coefs + w + 4);
+  const float32x4_t b2l = vld1q_f32(coefs + 2 * w);
+  const float32x4_t b2h = vld1q_f32(coefs + 2 * w + 4);
+  const float32x4_t a1l = vld1q_f32(coefs + 3 * w);
+  const float32x4_t a1h = vld1q_f32(coefs + 3 * w + 4);
+  const float32x4_t a2l = vld1q_f32(coefs + 4 * w);
+  const float32x4_t a2h = vld1q_f32(coefs + 4 * w + 4);
+  float32x4_t s0l = vld1q_f32(states);
+  float32x4_t s0h = vld1q_f32(states + 4);
+  float32x4_t s1l = vld1q_f32(states + w);
+  float32x4_t s1h = vld1q_f32(states + w + 4);
+  unsigned int f;
+
+  for(f=0; f<frames; f++)
+  {
+    const float32x4_t xl = vld1q_f32(buffer + f * w);
+    const float32x4_t xh = vld1q_f32(buffer + f * w + 4);
+    const float32x4_t yl = vmlaq_f32(s0l, b0l, xl);
+    const float32x4_t yh = vmlaq_f32(s0h, b0h, xh);
+
+    s0l = vmlsq_f32(vmlaq_f32(s1l, b1l, xl), a1l, yl);
+    s0h = vmlsq_f32(vmlaq_f32(s1h, b1h, xh), a1h, yh);
+    s1l = vmlsq_f32(vmulq_f32(b2l, xl), a2l, yl);
+    s1h = vmlsq_f32(vmulq_f32(b2h, xh), a2h, yh);
+    vst1q_f32(buffer + f * w, yl);
+    vst1q_f32(buffer + f * w + 4, yh);
+  }
+
+  vst1q_f32(states, s0l);
+  vst1q_f32(states + 4, s0h);
+  vst1q_f32(states + w, s1l);
+  vst1q_f32(states + w + 4, s1h);
+  return;
+}
+
+/* the columns of the block matrix are 2 vectors of 4 samples */
+static unsigned int
+df2t_block_neon(rta_real_t * y, const rta_real_t * x,
+                const unsigned int x_size,
+                const rta_real_t * b, const rta_real_t * a,
+                const rta_real_t * matrix, rta_real_t * states)
+{
+  const unsigned int n = RTA_BIQUAD_BLOCK;
+  rta_real_t s0 = states[0];
+  rta_real_t s1 = states[1];
+  unsigned int i, k;
+
+  for(i=0; i + n <= x_size; i += n)
+  {
+    const rta_real_t * xi = x + i;
+    const rta_real_t x1 = xi[n - 2];
+    const rta_real_t x0 = xi[n - 1];
+    float32x4_t yl = vmulq_n_f32(vld1q_f32(matrix + n * n), s0);
+    float32x4_t yh = vmulq_n_f32(vld1q_f32(matrix + n * n + 4), s0);
+    rta_real_t yl1, yl0;
+
+    yl = vmlaq_n_f32(yl, vld1q_f32(matrix + (n + 1) * n), s1);
+    yh = vmlaq_n_f32(yh, vld1q_f32(matrix + (n + 1) * n + 4), s1);
+
+    for(k=0; k<n; k++)
+    {
+      yl = vmlaq_n_f32(yl, vld1q_f32(matrix + k * n), xi[k]);
+      yh = vmlaq_n_f32(yh, vld1q_f32(matrix + k * n + 4), xi[k]);
+    }
+
+    vst1q_f32(y + i, yl);
+    vst1q_f32(y + i + 4, yh);
+
+    yl1 = y[i + n - 2];
+    yl0 = y[i + n - 1];
+    s0 = b[1] * x0 - a[0] * yl0 + b[2] * x1 - a[1] * yl1;
+    s1 = b[2] * x0 - a[1] * yl0;
+  }
+
+  states[0] = s0;
+  states[1] = s1;
+  return i;
+}
+
+static unsigned int
+sincos_neon(rta_real_t * s, rta_real_t * c, const rta_real_t * f0,
+            const unsigned int size)
+{
+  const float32x4_t one = vdupq_n_f32(1.);
+  const float32x4_t half = vdupq_n_f32(0.5);
+  const float32x4_t quarter = vdupq_n_f32(0.25);
+  unsigned int i;
+
+  for(i=0; i + 4 <= size; i += 4)
+  {
+    const float32x4_t f0v = vld1q_f32(f0 + i);
+    const uint32x4_t upper = vcgtq_f32(f0v, half);
+    const float32x4_t f = vbslq_f32(upper, vsubq_f32(one, f0v), f0v);
+    const uint32x4_t swap = vcgtq_f32(f, quarter);
+    const float32x4_t x =
+      vmulq_n_f32(vbslq_f32(swap, vsubq_f32(half, f), f), M_PI);
+    const float32x4_t x2 = vmulq_f32(x, x);
+    float32x4_t ps = vdupq_n_f32(-1. / 39916800.);
+    float32x4_t pc = vdupq_n_f32(1. / 479001600.);
+    float32x4_t sv, cv;
+
+    ps = vmlaq_f32(vdupq_n_f32(1. / 362880.), ps, x2);
+    ps = vmlaq_f32(vdupq_n_f32(-1. / 5040.), ps, x2);
+    ps = vmlaq_f32(vdupq_n_f32(1. / 120.), ps, x2);
+    ps = vmlaq_f32(vdupq_n_f32(-1. / 6.), ps, x2);
+    ps = vmlaq_f32(one, ps, x2);
+    ps = vmulq_f32(ps, x);
+
+    pc = vmlaq_f32(vdupq_n_f32(-1. / 3628800.), pc, x2);
+    pc = vmlaq_f32(vdupq_n_f32(1. / 40320.), pc, x2);
+    pc = vmlaq_f32(vdupq_n_f32(-1. / 720.), pc, x2);
+    pc = vmlaq_f32(vdupq_n_f32(1. / 24.), pc, x2);
+    pc = vmlaq_f32(vdupq_n_f32(-0.5), pc, x2);
+    pc = vmlaq_f32(one, pc, x2);
+
+    sv = vbslq_f32(swap, pc, ps);
+    cv = vbslq_f32(swap, ps, pc);
+    vst1q_f32(s + i, sv);
+    vst1q_f32(c + i, vbslq_f32(upper, vnegq_f32(cv), cv));
+  }
+
+  return i;
+}
+
+static const rta_biquad_simd_t biquad_simd_neon =
+{
+  "neon",
+  df2t_lanes_neon,
+  df2t_block_neon,
+  sincos_neon
+};
+
+#endif /* RTA_BIQUAD_USE_NEON */
+
+
+const rta_biquad_simd_t *
+rta_biquad_simd_get(void)
+{
+  const rta_biquad_simd_t * ret = NULL;
+
+#if defined(RTA_BIQUAD_USE_X86)
+  __builtin_cpu_init();
+
+  if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+  {
+    ret = &biquad_simd_avx2;
+  }
+#elif defined(RTA_BIQUAD_USE_NEON)
+  ret = &biquad_simd_neon;
+#endif
+
+  return ret;
+}
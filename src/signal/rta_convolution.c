@@ -0,0 +1,317 @@
+/**
+ * @file   rta_convolution.c
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_signal
+ *
+ * @brief  Block convolution by a long impulse response
+ *
+ * Uniformly partitioned overlap-save convolution.
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rta_convolution.h"
+#include "rta_fft.h"
+#include "rta_stdlib.h" /* memory management */
+
+struct rta_convolution_setup
+{
+  unsigned int block_size;
+  unsigned int impulse_size; /* maximum */
+  unsigned int fft_size; /* >= 2 * block_size */
+  unsigned int partitions; /* of block_size points of the impulse */
+  unsigned int current; /* delay line index of the last input spectrum */
+
+  /* packed real spectra of fft_size values (see rta_fft_real_execute) */
+  rta_real_t * impulse_spectra; /* partitions, scaled by 1 / fft_size */
+  rta_real_t * input_spectra; /* delay line of partitions */
+  rta_real_t * input; /* last fft_size input points */
+  rta_real_t * output; /* fft_size values */
+
+  rta_fft_plan_t * fft_plan;
+  rta_fft_setup_t * forward; /* in place, packed format */
+  rta_fft_setup_t * inverse; /* in place, packed format */
+  rta_real_t scale; /* 1, for the FFT setups */
+};
+
+/* accumulation of the products of packed spectra of 'size' values: */
+/* the first two values are the real DC and Nyquist values */
+static void
+spectrum_multiply_add(rta_real_t * accumulator,
+                      const rta_real_t * x, const rta_real_t * h,
+                      const unsigned int size)
+{
+  unsigned int i;
+
+  accumulator[0] += x[0] * h[0];
+  accumulator[1] += x[1] * h[1];
+
+  for(i=2; i<size; i+=2)
+  {
+    accumulator[i] += x[i] * h[i] - x[i+1] * h[i+1];
+    accumulator[i+1] += x[i] * h[i+1] + x[i+1] * h[i];
+  }
+  return;
+}
+
+int
+rta_convolution_setup_new(rta_convolution_setup_t ** convolution_setup,
+                          const rta_real_t * impulse,
+                          const unsigned int impulse_size,
+                          const unsigned int block_size)
+{
+  int ret = 0;
+  rta_convolution_setup_t * s;
+
+  if(impulse_size > 0 && block_size > 0)
+  {
+    *convolution_setup = (rta_convolution_setup_t *)
+      rta_malloc(sizeof(rta_convolution_setup_t));
+  }
+  else
+  {
+    *convolution_setup = NULL;
+  }
+
+  s = *convolution_setup;
+  if(s != NULL)
+  {
+    const unsigned int fft_size =
+      rta_fft_size(rta_fft_real_to_complex_1d, 2 * block_size);
+    const unsigned int partitions = (impulse_size + block_size - 1) / block_size;
+
+    s->block_size = block_size;
+    s->impulse_size = impulse_size;
+    s->fft_size = fft_size;
+    s->partitions = partitions;
+    s->scale = 1.;
+
+    s->impulse_spectra = (rta_real_t *)
+      rta_malloc(sizeof(rta_real_t) * partitions * fft_size);
+    s->input_spectra = (rta_real_t *)
+      rta_malloc(sizeof(rta_real_t) * partitions * fft_size);
+    s->input = (rta_real_t *) rta_malloc(sizeof(rta_real_t) * fft_size);
+    s->output = (rta_real_t *) rta_malloc(sizeof(rta_real_t) * fft_size);
+    s->forward = NULL;
+    s->inverse = NULL;
+
+    /* the direct and inverse setups share the plan of the real FFT */
+    if(s->impulse_spectra != NULL && s->input_spectra != NULL &&
+       s->input != NULL && s->output != NULL &&
+       rta_fft_plan_acquire(&s->fft_plan, rta_fft_real_to_complex_1d,
+                            fft_size) != 0)
+    {
+      ret = rta_fft_setup_new_with_plan(
+        &s->forward, s->fft_plan, rta_fft_real_to_complex_1d, &s->scale,
+        s->output, 1, fft_size, s->output, 1, NULL);
+
+      if(ret != 0)
+      {
+        ret = rta_fft_setup_new_with_plan(
+          &s->inverse, s->fft_plan, rta_fft_complex_to_real_1d, &s->scale,
+          s->output, 1, fft_size >> 1, s->output, 1, NULL);
+      }
+    }
+    else
+    {
+      s->fft_plan = NULL;
+    }
+
+    if(ret != 0)
+    {
+      rta_convolution_setup_set_impulse(
+        s, impulse, (impulse != NULL) ? impulse_size : 0);
+      rta_convolution_setup_clear(s);
+    }
+    else
+    {
+      rta_convolution_setup_delete(s);
+      *convolution_setup = NULL;
+    }
+  }
+
+  return ret;
+}
+
+int
+rta_convolution_setup_set_impulse(
+  rta_convolution_setup_t * convolution_setup,
+  const rta_real_t * impulse, const unsigned int impulse_size)
+{
+  int ret = 0;
+  rta_convolution_setup_t * s = convolution_setup;
+  const rta_real_t normalisation = 1. / (rta_real_t) s->fft_size;
+  unsigned int p, i, size;
+
+  if(impulse_size <= s->impulse_size)
+  {
+    for(p=0; p<s->partitions; p++)
+    {
+      rta_real_t * h = s->impulse_spectra + p * s->fft_size;
+
+      /* partition of block_size points, zero-padded */
+      size = (impulse_size > p * s->block_size) ?
+        impulse_size - p * s->block_size : 0;
+      if(size > s->block_size)
+      {
+        size = s->block_size;
+      }
+
+      for(i=0; i<size; i++)
+      {
+        h[i] = impulse[p * s->block_size + i] * normalisation;
+      }
+
+      rta_fft_real_execute(h, h, size, s->forward, NULL);
+    }
+    ret = 1;
+  }
+
+  return ret;
+}
+
+void
+rta_convolution_setup_clear(rta_convolution_setup_t * convolution_setup)
+{
+  rta_convolution_setup_t * s = convolution_setup;
+  unsigned int i;
+
+  for(i=0; i<s->fft_size; i++)
+  {
+    s->input[i] = 0.;
+  }
+
+  for(i=0; i<s->partitions * s->fft_size; i++)
+  {
+    s->input_spectra[i] = 0.;
+  }
+
+  s->current = 0;
+  return;
+}
+
+void
+rta_convolution_setup_delete(rta_convolution_setup_t * convolution_setup)
+{
+  rta_convolution_setup_t * s = convolution_setup;
+
+  if(s != NULL)
+  {
+    if(s->fft_plan != NULL)
+    {
+      rta_fft_setup_delete(s->forward);
+      rta_fft_setup_delete(s->inverse);
+      rta_fft_plan_release(s->fft_plan);
+    }
+
+    if(s->impulse_spectra != NULL)
+    {
+      rta_free(s->impulse_spectra);
+    }
+
+    if(s->input_spectra != NULL)
+    {
+      rta_free(s->input_spectra);
+    }
+
+    if(s->input != NULL)
+    {
+      rta_free(s->input);
+    }
+
+    if(s->output != NULL)
+    {
+      rta_free(s->output);
+    }
+
+    rta_free(s);
+  }
+  return;
+}
+
+void
+rta_convolution_process(rta_real_t * output, const rta_real_t * input,
+                        rta_convolution_setup_t * convolution_setup)
+{
+  rta_convolution_process_stride(output, 1, input, 1, convolution_setup);
+  return;
+}
+
+void
+rta_convolution_process_stride(
+  rta_real_t * output, const int o_stride,
+  const rta_real_t * input, const int i_stride,
+  rta_convolution_setup_t * convolution_setup)
+{
+  rta_convolution_setup_t * s = convolution_setup;
+  const unsigned int n = s->fft_size;
+  const unsigned int old_size = n - s->block_size;
+  rta_real_t * x = s->input_spectra + s->current * n;
+  unsigned int i, p, d;
+  int j;
+
+  /* slide the input by a block */
+  for(i=0; i<old_size; i++)
+  {
+    s->input[i] = s->input[i + s->block_size];
+  }
+
+  for(i=old_size, j=0; i<n; i++, j+=i_stride)
+  {
+    s->input[i] = input[j];
+  }
+
+  rta_fft_real_execute(x, s->input, n, s->forward, NULL);
+
+  /* partition p of the impulse by the input spectrum of p blocks ago */
+  for(i=0; i<n; i++)
+  {
+    s->output[i] = 0.;
+  }
+
+  for(p=0, d=s->current; p<s->partitions; p++)
+  {
+    spectrum_multiply_add(s->output, s->input_spectra + d * n,
+                          s->impulse_spectra + p * n, n);
+    d = (d > 0) ? d - 1 : s->partitions - 1;
+  }
+
+  rta_fft_real_execute(s->output, s->output, n >> 1, s->inverse, NULL);
+
+  /* overlap-save: the last block is free of circular aliasing */
+  for(i=old_size, j=0; i<n; i++, j+=o_stride)
+  {
+    output[j] = s->output[i];
+  }
+
+  s->current = (s->current + 1 < s->partitions) ? s->current + 1 : 0;
+  return;
+}
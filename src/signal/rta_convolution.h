@@ -0,0 +1,172 @@
+/**
+ * @file   rta_convolution.h
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_signal
+ *
+ * @brief  Block convolution by a long impulse response
+ *
+ * Uniformly partitioned overlap-save convolution, for real-time
+ * processing by blocks of a fixed size: the impulse response is cut
+ * into partitions of the block size, whose spectra are multiplied by
+ * the spectra of the previous input blocks (frequency-domain delay
+ * line). The output of a block is available at the end of its
+ * processing, without any latency other than the block itself.
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _RTA_CONVOLUTION_H_
+#define _RTA_CONVOLUTION_H_ 1
+
+#include "rta.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* rta_convolution_setup is private (depends on implementation) */
+typedef struct rta_convolution_setup rta_convolution_setup_t;
+
+/**
+ * Allocate and initialize a convolution setup, for an impulse
+ * response of at most 'impulse_size' points, processed by blocks of
+ * 'block_size' points.
+ *
+ * The cost of a block is 2 real FFTs of 2 * 'block_size' points (or
+ * more, see rta_fft_size) and a complex multiplication per point and
+ * per partition of 'block_size' points of the impulse response. All
+ * the memory is allocated here, and the state is cleared.
+ *
+ * A correlation by a fixed filter is the convolution by the reversed
+ * filter.
+ *
+ * \see rta_convolution_setup_delete
+ * \see rta_convolution_process
+ *
+ * @param convolution_setup is an address of a pointer to a private
+ * structure. This function allocates 'convolution_setup' and fills it.
+ * @param impulse is the impulse response, of size 'impulse_size'. It
+ * may be NULL, and set later (see rta_convolution_setup_set_impulse).
+ * @param impulse_size is the maximum size of the impulse response. It
+ * must be > 0.
+ * @param block_size is the number of points of each processing. It
+ * must be > 0.
+ *
+ * @return 1 on success 0 on fail. If it fails, nothing should be done
+ * with 'convolution_setup' (even a delete).
+ */
+int
+rta_convolution_setup_new(rta_convolution_setup_t ** convolution_setup,
+                          const rta_real_t * impulse,
+                          const unsigned int impulse_size,
+                          const unsigned int block_size);
+
+/**
+ * Change the impulse response of a convolution setup, without any
+ * memory allocation. The previous input blocks are kept, and convolved
+ * by the new impulse response from the next block on.
+ *
+ * @param convolution_setup is a pointer to a private structure
+ * @param impulse is the impulse response, of size 'impulse_size'
+ * @param impulse_size must be <= the 'impulse_size' of the setup. The
+ * impulse response is zero-padded.
+ *
+ * @return 1 on success 0 on fail ('impulse_size' too large). If it
+ * fails, 'convolution_setup' is unchanged.
+ */
+int
+rta_convolution_setup_set_impulse(
+  rta_convolution_setup_t * convolution_setup,
+  const rta_real_t * impulse, const unsigned int impulse_size);
+
+/**
+ * Clear the input blocks of a convolution setup, as after its
+ * allocation.
+ *
+ * @param convolution_setup is a pointer to a private structure
+ */
+void
+rta_convolution_setup_clear(rta_convolution_setup_t * convolution_setup);
+
+/**
+ * Deallocate any (successfully) allocated convolution setup.
+ *
+ * @param convolution_setup is a pointer to a private structure
+ */
+void
+rta_convolution_setup_delete(rta_convolution_setup_t * convolution_setup);
+
+/**
+ * Convolve the next block of 'block_size' points of a signal by the
+ * impulse response of 'convolution_setup'.
+ *
+ * \f$y(n) = \sum_{i=0}^{impulse\_size-1} h(i) \cdot x(n-i)\f$
+ *
+ * where x is the concatenation of all the input blocks since the
+ * setup (or since rta_convolution_setup_clear). This function can
+ * run in place if 'output' == 'input'. It allocates no memory.
+ *
+ * @param output size is 'block_size'
+ * @param input size is 'block_size'
+ * @param convolution_setup is a pointer to a private structure
+ */
+void
+rta_convolution_process(rta_real_t * output, const rta_real_t * input,
+                        rta_convolution_setup_t * convolution_setup);
+
+/**
+ * Convolve the next block of 'block_size' points of a signal by the
+ * impulse response of 'convolution_setup'.
+ *
+ * \f$y(n) = \sum_{i=0}^{impulse\_size-1} h(i) \cdot x(n-i)\f$
+ *
+ * where x is the concatenation of all the input blocks since the
+ * setup (or since rta_convolution_setup_clear). This function can
+ * run in place if 'output' == 'input' and 'o_stride' == 'i_stride'.
+ * It allocates no memory.
+ *
+ * @param output size is 'block_size'
+ * @param o_stride is 'output' stride
+ * @param input size is 'block_size'
+ * @param i_stride is 'input' stride
+ * @param convolution_setup is a pointer to a private structure
+ */
+void
+rta_convolution_process_stride(
+  rta_real_t * output, const int o_stride,
+  const rta_real_t * input, const int i_stride,
+  rta_convolution_setup_t * convolution_setup);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTA_CONVOLUTION_H_ */
@@ -37,6 +37,10 @@
  */
 
 #include "rta_correlation.h"
+#include "rta_correlationintern.h" /* vectorised kernels */
+#include "rta_fft.h" /* FFT correlation */
+#include "rta_int.h" /* integer log2 function */
+#include "rta_stdlib.h" /* memory management */
 
 
 /* specific implementations */
@@ -70,15 +74,22 @@ void rta_correlation_fast(
   {
 #endif /* RTA_USE_VECLIB */
 
-/* Base algorithm */
+/* Base algorithm, vectorised lags first */
+    const rta_correlation_simd_t * simd = rta_correlation_simd_get();
     unsigned int c,f;
-    for(c=0; c<c_size; c++)
+
+    c = (simd != NULL) ?
+      simd->fast(correlation, 1, c_size, input_vector_a, input_vector_b,
+                 filter_size) : 0;
+
+    for(; c<c_size; c++)
     {
-      correlation[c] = 0.0;
+      rta_real_t sum = 0.0;
       for(f=0; f<filter_size; f++)
       {
-        correlation[c] += input_vector_a[f+c] * input_vector_b[f];
+        sum += input_vector_a[f+c] * input_vector_b[f];
       }
+      correlation[c] = sum;
     } /* end of base algorithm */
 
 #if defined(RTA_USE_VECLIB)
@@ -87,6 +98,31 @@ void rta_correlation_fast(
   return;
 }
 
+void rta_correlation_fast_double(
+  double * correlation, const unsigned int c_size,
+  const rta_real_t * input_vector_a,
+  const rta_real_t * input_vector_b,
+  const unsigned int filter_size)
+{
+  const rta_correlation_simd_t * simd = rta_correlation_simd_get();
+  unsigned int c,f;
+
+  c = (simd != NULL && simd->fast_double != NULL) ?
+    simd->fast_double(correlation, c_size, input_vector_a, input_vector_b,
+                      filter_size) : 0;
+
+  for(; c<c_size; c++)
+  {
+    double sum = 0.0;
+    for(f=0; f<filter_size; f++)
+    {
+      sum += (double) input_vector_a[f+c] * input_vector_b[f];
+    }
+    correlation[c] = sum;
+  }
+  return;
+}
+
 /* Requirement: {a_size*a_stride, b_size*b_stride} >= */
 /* (c_size+filter_size)*c_stride */
 /* Warning: for VecLib, a_size is required to be aligned on a multiple */
@@ -113,16 +149,28 @@ void rta_correlation_fast_stride(
   {
 #endif /* RTA_USE_VECLIB */
 
-/* Base algorithm */
+/* Base algorithm, vectorised lags first for contiguous inputs */
+    const rta_correlation_simd_t * simd =
+      (a_stride == 1 && b_stride == 1) ? rta_correlation_simd_get() : NULL;
+    unsigned int first = 0;
     int c, ca, fa, fb;
-    for (c = 0, ca = 0; c < (int) c_size * c_stride; c += c_stride, ca += a_stride)
+
+    if(simd != NULL)
     {
-      correlation[c] = 0.0;
+      first = simd->fast(correlation, c_stride, c_size,
+                         input_vector_a, input_vector_b, filter_size);
+    }
+
+    for (c = first * c_stride, ca = first * a_stride;
+         c < (int) c_size * c_stride;
+         c += c_stride, ca += a_stride)
+    {
+      rta_real_t sum = 0.0;
       for (fa = 0, fb = 0; fa < (int) filter_size * a_stride; fa += a_stride, fb += b_stride)
       {
-        correlation[c] +=
-          input_vector_a[fa+ca] * input_vector_b[fb];
+        sum += input_vector_a[fa+ca] * input_vector_b[fb];
       }
+      correlation[c] = sum;
     } /* end of base algorithm */
 
 #if defined(RTA_USE_VECLIB)
@@ -131,6 +179,32 @@ void rta_correlation_fast_stride(
   return;
 }
 
+/* Requirement: c_stride >= channels, i_stride >= channels */
+void rta_correlation_fast_interleaved(
+  rta_real_t * correlation, const int c_stride, const unsigned int c_size,
+  const rta_real_t * input_vector_a,
+  const rta_real_t * input_vector_b,
+  const int i_stride, const unsigned int channels,
+  const unsigned int filter_size)
+{
+  /* vectorised channels first, then channel by channel */
+  const rta_correlation_simd_t * simd = rta_correlation_simd_get();
+  unsigned int k;
+
+  k = (simd != NULL) ?
+    simd->interleaved(correlation, c_stride, c_size,
+                      input_vector_a, input_vector_b, i_stride,
+                      channels, filter_size) : 0;
+
+  for(; k<channels; k++)
+  {
+    rta_correlation_fast_stride(correlation + k, c_stride, c_size,
+                                input_vector_a + k, i_stride,
+                                input_vector_b + k, i_stride, filter_size);
+  }
+  return;
+}
+
 /* Requirement: (a_size, b_size) >= max_filter_size > c_size */
 void rta_correlation_raw(
   rta_real_t * correlation, const unsigned int c_size,
@@ -323,3 +397,280 @@ void rta_correlation_raw_scaled_stride(
   return;
 }
 
+
+/* cost of an FFT correlation, in multiplications of the direct one */
+/* per point and per pass (log2 of the size, rounded up) of its 3 */
+/* real FFTs */
+#define RTA_CORRELATION_FFT_COST 2
+
+/* same, with the vectorised direct correlation */
+#define RTA_CORRELATION_FFT_COST_SIMD 40
+
+struct rta_correlation_setup
+{
+  unsigned int c_size;
+  unsigned int filter_size;
+  rta_correlation_method_t method; /* direct or FFT, once chosen */
+
+  /* FFT method, allocated on first selection */
+  unsigned int fft_size;
+  rta_fft_plan_t * fft_plan;
+  rta_fft_setup_t * forward; /* in place, packed format */
+  rta_fft_setup_t * inverse; /* in place, packed format */
+  rta_real_t * spectrum_a; /* 'fft_size' values */
+  rta_real_t * spectrum_b; /* 'fft_size' values */
+  rta_real_t scale; /* 1, for the FFT setups */
+};
+
+static int
+fft_method_new(rta_correlation_setup_t * correlation_setup)
+{
+  int ret = 0;
+  rta_correlation_setup_t * s = correlation_setup;
+  const unsigned int fft_size = rta_fft_size(rta_fft_real_to_complex_1d,
+                                             s->c_size + s->filter_size);
+
+  s->scale = 1.;
+  s->spectrum_a = (rta_real_t *) rta_malloc(sizeof(rta_real_t) * fft_size);
+  s->spectrum_b = (rta_real_t *) rta_malloc(sizeof(rta_real_t) * fft_size);
+
+  /* the direct and inverse setups share the plan of the real FFT */
+  if(s->spectrum_a != NULL && s->spectrum_b != NULL &&
+     rta_fft_plan_acquire(&s->fft_plan, rta_fft_real_to_complex_1d,
+                          fft_size) != 0)
+  {
+    ret = rta_fft_setup_new_with_plan(
+      &s->forward, s->fft_plan, rta_fft_real_to_complex_1d, &s->scale,
+      s->spectrum_a, 1, fft_size, s->spectrum_a, 1, NULL);
+
+    if(ret != 0)
+    {
+      ret = rta_fft_setup_new_with_plan(
+        &s->inverse, s->fft_plan, rta_fft_complex_to_real_1d, &s->scale,
+        s->spectrum_a, 1, fft_size >> 1, s->spectrum_a, 1, NULL);
+
+      if(ret == 0)
+      {
+        rta_fft_setup_delete(s->forward);
+      }
+    }
+
+    if(ret == 0)
+    {
+      rta_fft_plan_release(s->fft_plan);
+    }
+  }
+
+  if(ret != 0)
+  {
+    s->fft_size = fft_size;
+  }
+  else
+  {
+    if(s->spectrum_a != NULL)
+    {
+      rta_free(s->spectrum_a);
+    }
+
+    if(s->spectrum_b != NULL)
+    {
+      rta_free(s->spectrum_b);
+    }
+    s->fft_plan = NULL;
+    s->spectrum_a = NULL;
+    s->spectrum_b = NULL;
+  }
+
+  return ret;
+}
+
+int
+rta_correlation_setup_new(rta_correlation_setup_t ** correlation_setup,
+                          const unsigned int c_size,
+                          const unsigned int filter_size)
+{
+  int ret = 0;
+
+  *correlation_setup = (rta_correlation_setup_t *)
+    rta_malloc(sizeof(rta_correlation_setup_t));
+
+  if(*correlation_setup != NULL)
+  {
+    (*correlation_setup)->c_size = c_size;
+    (*correlation_setup)->filter_size = filter_size;
+    (*correlation_setup)->method = rta_correlation_direct;
+    (*correlation_setup)->fft_plan = NULL;
+    (*correlation_setup)->spectrum_a = NULL;
+    (*correlation_setup)->spectrum_b = NULL;
+
+    ret = rta_correlation_setup_set_method(*correlation_setup,
+                                           rta_correlation_auto);
+    if(ret == 0)
+    {
+      rta_free(*correlation_setup);
+      *correlation_setup = NULL;
+    }
+  }
+
+  return ret;
+}
+
+int
+rta_correlation_setup_set_method(
+  rta_correlation_setup_t * correlation_setup,
+  const rta_correlation_method_t method)
+{
+  int ret = 1;
+  rta_correlation_method_t m = method;
+
+  if(m == rta_correlation_auto)
+  {
+    const unsigned int fft_size = rta_fft_size(
+      rta_fft_real_to_complex_1d,
+      correlation_setup->c_size + correlation_setup->filter_size);
+    const double fft_cost = (rta_correlation_simd_get() != NULL) ?
+      RTA_CORRELATION_FFT_COST_SIMD : RTA_CORRELATION_FFT_COST;
+
+    m = ((double) correlation_setup->c_size * correlation_setup->filter_size >
+         fft_cost * fft_size * (rta_ilog2(fft_size) + 1)) ?
+      rta_correlation_fft : rta_correlation_direct;
+  }
+
+  switch(m)
+  {
+    case rta_correlation_direct:
+      break;
+
+    case rta_correlation_fft:
+      if(correlation_setup->fft_plan == NULL)
+      {
+        ret = fft_method_new(correlation_setup);
+      }
+      break;
+
+    default:
+      ret = 0;
+      break;
+  }
+
+  if(ret != 0)
+  {
+    correlation_setup->method = m;
+  }
+
+  return ret;
+}
+
+void
+rta_correlation_setup_delete(rta_correlation_setup_t * correlation_setup)
+{
+  if(correlation_setup != NULL)
+  {
+    if(correlation_setup->fft_plan != NULL)
+    {
+      rta_fft_setup_delete(correlation_setup->forward);
+      rta_fft_setup_delete(correlation_setup->inverse);
+      rta_fft_plan_release(correlation_setup->fft_plan);
+      rta_free(correlation_setup->spectrum_a);
+      rta_free(correlation_setup->spectrum_b);
+    }
+    rta_free(correlation_setup);
+  }
+  return;
+}
+
+/* A(f+i) * B(f) sums as the inverse FFT of FFT(A) * conj(FFT(B)), */
+/* zero-padded to avoid any circular overlap: 'fft_size' >= */
+/* 'c_size' + 'filter_size' */
+static void
+correlation_fft(rta_real_t * correlation, const int c_stride,
+                const rta_real_t * input_vector_a, const int a_stride,
+                const rta_real_t * input_vector_b, const int b_stride,
+                rta_correlation_setup_t * correlation_setup)
+{
+  rta_correlation_setup_t * s = correlation_setup;
+  rta_real_t * a = s->spectrum_a;
+  rta_real_t * b = s->spectrum_b;
+  const unsigned int a_size = s->c_size + s->filter_size;
+  const rta_real_t normalisation = 1. / (rta_real_t) s->fft_size;
+  unsigned int i;
+  int ia;
+
+  for(i=0, ia=0; i<a_size; i++, ia+=a_stride)
+  {
+    a[i] = input_vector_a[ia];
+  }
+
+  for(i=0, ia=0; i<s->filter_size; i++, ia+=b_stride)
+  {
+    b[i] = input_vector_b[ia];
+  }
+
+  /* packed spectra: nyquist value in the first imaginary value */
+  rta_fft_real_execute(a, a, a_size, s->forward, NULL);
+  rta_fft_real_execute(b, b, s->filter_size, s->forward, NULL);
+
+  a[0] *= b[0] * normalisation;
+  a[1] *= b[1] * normalisation;
+
+  for(i=2; i<s->fft_size; i+=2)
+  {
+    const rta_real_t re = (a[i] * b[i] + a[i+1] * b[i+1]) * normalisation;
+    const rta_real_t im = (a[i+1] * b[i] - a[i] * b[i+1]) * normalisation;
+    a[i] = re;
+    a[i+1] = im;
+  }
+
+  rta_fft_real_execute(a, a, s->fft_size >> 1, s->inverse, NULL);
+
+  for(i=0, ia=0; i<s->c_size; i++, ia+=c_stride)
+  {
+    correlation[ia] = a[i];
+  }
+
+  return;
+}
+
+void
+rta_correlation_fast_execute(
+  rta_real_t * correlation,
+  const rta_real_t * input_vector_a,
+  const rta_real_t * input_vector_b,
+  rta_correlation_setup_t * correlation_setup)
+{
+  if(correlation_setup->method == rta_correlation_fft)
+  {
+    correlation_fft(correlation, 1, input_vector_a, 1, input_vector_b, 1,
+                    correlation_setup);
+  }
+  else
+  {
+    rta_correlation_fast(correlation, correlation_setup->c_size,
+                         input_vector_a, input_vector_b,
+                         correlation_setup->filter_size);
+  }
+  return;
+}
+
+void
+rta_correlation_fast_execute_stride(
+  rta_real_t * correlation, const int c_stride,
+  const rta_real_t * input_vector_a, const int a_stride,
+  const rta_real_t * input_vector_b, const int b_stride,
+  rta_correlation_setup_t * correlation_setup)
+{
+  if(correlation_setup->method == rta_correlation_fft)
+  {
+    correlation_fft(correlation, c_stride, input_vector_a, a_stride,
+                    input_vector_b, b_stride, correlation_setup);
+  }
+  else
+  {
+    rta_correlation_fast_stride(correlation, c_stride,
+                                correlation_setup->c_size,
+                                input_vector_a, a_stride,
+                                input_vector_b, b_stride,
+                                correlation_setup->filter_size);
+  }
+  return;
+}
@@ -61,6 +61,10 @@ extern "C" {
  * 'filter_size' is much greater than 'c_size', like ('filter_size' /
  * 'c_size' > 20).
  *
+ * Blocks of consecutive lags are computed by vectors (AVX2 or NEON)
+ * when available. For long correlations, see
+ * rta_correlation_fast_execute.
+ *
  * @param correlation size is 'c_size'
  * @param c_size is the 'correlation' order + 1, 'c_size' must be > 0
  * @param input_vector_a size a_size must be >= 'c_size' + 'filter_size'
@@ -75,6 +79,33 @@ rta_correlation_fast(
   const rta_real_t * input_vector_b,
   const unsigned int filter_size);
 
+/**
+ * Compute correlation between 'input_vector_a' and 'input_vector_b' into
+ * 'correlation', as rta_correlation_fast, with the products and the
+ * sums in double precision. The products of single precision values
+ * are then exact, which matters when correlations are accumulated and
+ * updated over long signals.
+ *
+ * \f$C(i) = \sum_{f=0}^{filter\_size-1} A(f+i) \cdot B(f), i=\{0,c\_size-1\}\f$
+ *
+ * Blocks of consecutive lags are computed by vectors (AVX2) when
+ * available.
+ *
+ * \see rta_correlation_fast
+ *
+ * @param correlation size is 'c_size'
+ * @param c_size is the 'correlation' order + 1, 'c_size' must be > 0
+ * @param input_vector_a size a_size must be >= 'c_size' + 'filter_size'
+ * @param input_vector_b size b_size must be >= 'filter_size'
+ * @param filter_size is the number of products of each lag
+ */
+void
+rta_correlation_fast_double(
+  double * correlation, const unsigned int c_size,
+  const rta_real_t * input_vector_a,
+  const rta_real_t * input_vector_b,
+  const unsigned int filter_size);
+
 
 /**
  * Compute correlation between 'input_vector_a' and 'input_vector_b' into
@@ -107,6 +138,36 @@ rta_correlation_fast_stride(
   const rta_real_t * input_vector_b, const int b_stride,
   const unsigned int filter_size);
 
+/**
+ * Compute the correlations of 'channels' interleaved channels of
+ * 'input_vector_a' and 'input_vector_b' into 'correlation', as
+ * rta_correlation_fast_stride for each channel. The channels are
+ * vectorised together. This function can not run in place.
+ *
+ * \f$C(i, k) = \sum_{f=0}^{filter\_size-1} A(f+i, k) \cdot B(f, k), i=\{0,c\_size-1\}, k=\{0,channels-1\}\f$
+ *
+ * @param correlation size is 'c_size' * 'c_stride'. The lag i of the
+ * channel k is 'correlation'[i * 'c_stride' + k].
+ * @param c_stride is the distance between the lags of 'correlation'.
+ * It must be >= 'channels'.
+ * @param c_size is the 'correlation' order + 1, 'c_size' must be > 0
+ * @param input_vector_a size must be >= ('c_size' + 'filter_size') *
+ * 'i_stride'. The point f of the channel k is 'input_vector_a'[f *
+ * 'i_stride' + k].
+ * @param input_vector_b size must be >= 'filter_size' * 'i_stride'
+ * @param i_stride is the distance between the points of a channel of
+ * the inputs. It must be >= 'channels'.
+ * @param channels is the number of channels
+ * @param filter_size is the number of products of each lag
+ */
+void
+rta_correlation_fast_interleaved(
+  rta_real_t * correlation, const int c_stride, const unsigned int c_size,
+  const rta_real_t * input_vector_a,
+  const rta_real_t * input_vector_b,
+  const int i_stride, const unsigned int channels,
+  const unsigned int filter_size);
+
 /**
  * Compute correlation between 'input_vector_a' and 'input_vector_b' into
  * 'correlation'. If 'input_vector_a' == 'input_vector_b', it computes
@@ -365,6 +426,117 @@ rta_correlation_raw_scaled_stride(
   const rta_real_t * input_vector_b, const int b_stride,
   const unsigned int max_filter_size, const rta_real_t scale);
 
+/** Computation of the correlation by a setup */
+typedef enum
+{
+  rta_correlation_auto = 0,   /**< cheapest of direct and FFT (default) */
+  rta_correlation_direct = 1, /**< direct sums, as rta_correlation_fast */
+  rta_correlation_fft = 2     /**< product of real FFTs */
+} rta_correlation_method_t;
+
+/* rta_correlation_setup is private (depends on implementation) */
+typedef struct rta_correlation_setup rta_correlation_setup_t;
+
+/**
+ * Allocate and initialize a correlation setup, to compute the same
+ * correlation as rta_correlation_fast for given sizes, many times.
+ *
+ * The direct computation costs 'c_size' * 'filter_size'
+ * multiplications, the FFT one costs 3 real FFTs of 'c_size' +
+ * 'filter_size' points (or more, see rta_fft_size), which is much
+ * cheaper for long correlations (like 2048 lags of a 2048 points
+ * window). The cheapest method is chosen for the sizes of the setup.
+ *
+ * \see rta_correlation_setup_delete
+ * \see rta_correlation_fast_execute
+ *
+ * @param correlation_setup is an address of a pointer to a private
+ * structure. This function allocates 'correlation_setup' and fills it.
+ * @param c_size is the 'correlation' order + 1, 'c_size' must be > 0
+ * @param filter_size is the maximum shift for 'input_vector_a'
+ *
+ * @return 1 on success 0 on fail. If it fails, nothing should be done
+ * with 'correlation_setup' (even a delete).
+ */
+int
+rta_correlation_setup_new(rta_correlation_setup_t ** correlation_setup,
+                          const unsigned int c_size,
+                          const unsigned int filter_size);
+
+/**
+ * Force the computation method of a correlation setup. The FFT setups
+ * and buffers are allocated on the first selection of
+ * rta_correlation_fft, and the plan of the FFT is shared with the
+ * other setups of the same size (see rta_fft_plan_acquire).
+ *
+ * @param correlation_setup is a pointer to a private structure
+ * @param method is rta_correlation_auto, rta_correlation_direct or
+ * rta_correlation_fft
+ *
+ * @return 1 on success 0 on fail (unknown method or memory allocation
+ * failure). If it fails, 'correlation_setup' is unchanged.
+ */
+int
+rta_correlation_setup_set_method(
+  rta_correlation_setup_t * correlation_setup,
+  const rta_correlation_method_t method);
+
+/**
+ * Deallocate any (successfully) allocated correlation setup.
+ *
+ * @param correlation_setup is a pointer to a private structure
+ */
+void
+rta_correlation_setup_delete(rta_correlation_setup_t * correlation_setup);
+
+/**
+ * Correlation of 'input_vector_a' and 'input_vector_b', as
+ * rta_correlation_fast with the 'c_size' and 'filter_size' of
+ * 'correlation_setup', by its computation method. It allocates no
+ * memory. This function can run in place if 'correlation' ==
+ * 'input_vector_a' or 'correlation' == 'input_vector_b'.
+ *
+ * \f$C(i) = \sum_{f=0}^{filter\_size-1} A(f+i) \cdot B(f), i=\{0,c\_size-1\}\f$
+ *
+ * Results of the FFT method differ from the direct sums by rounding
+ * errors, relative to the energy of the inputs.
+ *
+ * @param correlation size is 'c_size'
+ * @param input_vector_a size must be >= 'c_size' + 'filter_size'
+ * @param input_vector_b size must be >= 'filter_size'
+ * @param correlation_setup is a pointer to a private structure
+ */
+void
+rta_correlation_fast_execute(
+  rta_real_t * correlation,
+  const rta_real_t * input_vector_a,
+  const rta_real_t * input_vector_b,
+  rta_correlation_setup_t * correlation_setup);
+
+/**
+ * Correlation of 'input_vector_a' and 'input_vector_b', as
+ * rta_correlation_fast_stride with the 'c_size' and 'filter_size' of
+ * 'correlation_setup', by its computation method. It allocates no
+ * memory. This function can run in place if 'correlation' ==
+ * 'input_vector_a' or 'correlation' == 'input_vector_b'.
+ *
+ * \f$C(i) = \sum_{f=0}^{filter\_size-1} A(f+i) \cdot B(f), i=\{0,c\_size-1\}\f$
+ *
+ * @param correlation size is 'c_size'
+ * @param c_stride is 'correlation' stride
+ * @param input_vector_a size must be >= 'c_size' + 'filter_size'
+ * @param a_stride is 'input_vector_a' stride
+ * @param input_vector_b size must be >= 'filter_size'
+ * @param b_stride is 'input_vector_b' stride
+ * @param correlation_setup is a pointer to a private structure
+ */
+void
+rta_correlation_fast_execute_stride(
+  rta_real_t * correlation, const int c_stride,
+  const rta_real_t * input_vector_a, const int a_stride,
+  const rta_real_t * input_vector_b, const int b_stride,
+  rta_correlation_setup_t * correlation_setup);
+
 #ifdef __cplusplus
 }
 #endif
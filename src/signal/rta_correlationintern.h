@@ -0,0 +1,146 @@
+/**
+ * @file   rta_correlationintern.h
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_signal
+ *
+ * @brief  private declarations for the correlation
+ *
+ * Vectorised (SIMD) correlation kernels, selected at run time by
+ * rta_correlation.c.
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _RTA_CORRELATIONINTERN_H_
+#define _RTA_CORRELATIONINTERN_H_ 1
+
+#include "rta.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Vectorised part of rta_correlation_fast, for contiguous inputs.
+ *
+ * The correlation values are computed by blocks of consecutive lags,
+ * accumulated in registers over the whole filter: each step multiplies
+ * a vector of 'input_vector_a' values by one 'input_vector_b' value.
+ *
+ * \param correlation size is 'c_size'
+ * \param c_stride is 'correlation' stride
+ * \param c_size is the number of lags
+ * \param input_vector_a size must be >= 'c_size' + 'filter_size'
+ * \param input_vector_b size must be >= 'filter_size'
+ * \param filter_size is the number of products of each lag
+ *
+ * \return the first lag that was not computed. The remaining lags
+ * (less than a vector) are left to the scalar code.
+ */
+typedef unsigned int (*rta_correlation_fast_kernel_t)(
+  rta_real_t * correlation, const int c_stride, const unsigned int c_size,
+  const rta_real_t * input_vector_a,
+  const rta_real_t * input_vector_b,
+  const unsigned int filter_size);
+
+/**
+ * Vectorised part of rta_correlation_fast_interleaved.
+ *
+ * Each vector holds consecutive channels of a lag, accumulated over
+ * the whole filter for a block of lags.
+ *
+ * \param correlation size is 'c_size' * 'c_stride'
+ * \param c_stride is the distance between the lags in 'correlation'
+ * \param c_size is the number of lags
+ * \param input_vector_a size must be >= ('c_size' + 'filter_size') *
+ * 'i_stride'
+ * \param input_vector_b size must be >= 'filter_size' * 'i_stride'
+ * \param i_stride is the distance between the points of a channel
+ * \param channels is the number of channels
+ * \param filter_size is the number of products of each lag
+ *
+ * \return the first channel that was not computed: 'channels', or
+ * 0 if 'channels' is less than a vector. The last vector overlaps the
+ * previous channels.
+ */
+typedef unsigned int (*rta_correlation_interleaved_kernel_t)(
+  rta_real_t * correlation, const int c_stride, const unsigned int c_size,
+  const rta_real_t * input_vector_a,
+  const rta_real_t * input_vector_b,
+  const int i_stride, const unsigned int channels,
+  const unsigned int filter_size);
+
+/**
+ * Vectorised part of rta_correlation_fast_double: as
+ * rta_correlation_fast_kernel_t, with the products and the sums in
+ * double precision.
+ *
+ * \param correlation size is 'c_size'
+ * \param c_size is the number of lags
+ * \param input_vector_a size must be >= 'c_size' + 'filter_size'
+ * \param input_vector_b size must be >= 'filter_size'
+ * \param filter_size is the number of products of each lag
+ *
+ * \return the first lag that was not computed. The remaining lags
+ * (less than a vector) are left to the scalar code.
+ */
+typedef unsigned int (*rta_correlation_double_kernel_t)(
+  double * correlation, const unsigned int c_size,
+  const rta_real_t * input_vector_a,
+  const rta_real_t * input_vector_b,
+  const unsigned int filter_size);
+
+/** Set of vectorised kernels for an instruction set */
+typedef struct
+{
+  const char * name; /**< instruction set */
+  rta_correlation_fast_kernel_t fast;
+  rta_correlation_interleaved_kernel_t interleaved;
+  rta_correlation_double_kernel_t fast_double; /**< NULL if not supported */
+} rta_correlation_simd_t;
+
+/**
+ * Select the vectorised kernels for the running processor.
+ *
+ * AVX2 (with FMA) is detected at run time on x86 with GCC compatible
+ * compilers, NEON is used when compiled for ARM with NEON support and
+ * single precision.
+ *
+ * \return the kernels of the best available instruction set, or NULL
+ * if none is supported (then use the scalar code)
+ */
+const rta_correlation_simd_t * rta_correlation_simd_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTA_CORRELATIONINTERN_H_ */
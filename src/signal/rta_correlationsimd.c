@@ -0,0 +1,656 @@
+/**
+ * @file   rta_correlationsimd.c
+ * @date   Sun Oct 18 2026
+ *
+ * @brief  Vectorised correlation kernels
+ *
+ * AVX2 and NEON versions of the direct correlation of rta_correlation.c.
+ * Each vector holds consecutive lags, and blocks of 4 vectors stay in
+ * registers over the whole filter. They compute the same values as
+ * the scalar code, with the usual rounding differences (AVX2 uses
+ * fused multiply-add).
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rta_correlationintern.h"
+
+#include <stddef.h> /* NULL */
+
+/* x86 kernels need the GCC (or clang) target attributes and CPU detection */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+  (RTA_REAL_TYPE == RTA_FLOAT_TYPE || RTA_REAL_TYPE == RTA_DOUBLE_TYPE)
+#define RTA_CORRELATION_USE_X86 1
+#include <immintrin.h>
+#endif
+
+#if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && \
+  (RTA_REAL_TYPE == RTA_FLOAT_TYPE)
+#define RTA_CORRELATION_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* lags per block of vectors */
+#define RTA_CORRELATION_BLOCK 4
+
+/* ------- AVX2, single precision --------------------------------------- */
+#if defined(RTA_CORRELATION_USE_X86) && (RTA_REAL_TYPE == RTA_FLOAT_TYPE)
+
+#define RTA_CORRELATION_AVX2_WIDTH 8
+
+static inline __attribute__((target("avx"), always_inline)) void
+store_lags_avx2(rta_real_t * correlation, const int c_stride,
+                const __m256 v)
+{
+  if(c_stride == 1)
+  {
+    _mm256_storeu_ps(correlation, v);
+  }
+  else
+  {
+    rta_real_t lags[RTA_CORRELATION_AVX2_WIDTH];
+    int l;
+
+    _mm256_storeu_ps(lags, v);
+    for(l=0; l<RTA_CORRELATION_AVX2_WIDTH; l++)
+    {
+      correlation[l * c_stride] = lags[l];
+    }
+  }
+  return;
+}
+
+static __attribute__((target("avx2,fma"))) unsigned int
+correlation_fast_avx2(rta_real_t * correlation, const int c_stride,
+                      const unsigned int c_size,
+                      const rta_real_t * input_vector_a,
+                      const rta_real_t * input_vector_b,
+                      const unsigned int filter_size)
+{
+  const unsigned int w = RTA_CORRELATION_AVX2_WIDTH;
+  unsigned int c, f;
+
+  for(c=0; c + RTA_CORRELATION_BLOCK * w <= c_size;
+      c += RTA_CORRELATION_BLOCK * w)
+  {
+    const rta_real_t * a = input_vector_a + c;
+    __m256 s0 = _mm256_setzero_ps();
+    __m256 s1 = _mm256_setzero_ps();
+    __m256 s2 = _mm256_setzero_ps();
+    __m256 s3 = _mm256_setzero_ps();
+
+    for(f=0; f<filter_size; f++)
+    {
+      const __m256 b = _mm256_broadcast_ss(input_vector_b + f);
+
+      s0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + f), b, s0);
+      s1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + f + w), b, s1);
+      s2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + f + 2 * w), b, s2);
+      s3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + f + 3 * w), b, s3);
+    }
+
+    store_lags_avx2(correlation + c * c_stride, c_stride, s0);
+    store_lags_avx2(correlation + (c + w) * c_stride, c_stride, s1);
+    store_lags_avx2(correlation + (c + 2 * w) * c_stride, c_stride, s2);
+    store_lags_avx2(correlation + (c + 3 * w) * c_stride, c_stride, s3);
+  }
+
+  /* remaining vectors, the last one overlapping the previous lags */
+  /* (unless in place) */
+  for(; c < c_size; c += w)
+  {
+    const rta_real_t * a;
+    __m256 s0 = _mm256_setzero_ps();
+
+    if(c + w > c_size)
+    {
+      if(c_size < w || correlation == input_vector_a)
+      {
+        break;
+      }
+      c = c_size - w;
+    }
+
+    a = input_vector_a + c;
+
+    for(f=0; f<filter_size; f++)
+    {
+      s0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + f),
+                           _mm256_broadcast_ss(input_vector_b + f), s0);
+    }
+
+    store_lags_avx2(correlation + c * c_stride, c_stride, s0);
+  }
+
+  return c;
+}
+
+static __attribute__((target("avx2,fma"))) unsigned int
+correlation_interleaved_avx2(rta_real_t * correlation, const int c_stride,
+                             const unsigned int c_size,
+                             const rta_real_t * input_vector_a,
+                             const rta_real_t * input_vector_b,
+                             const int i_stride, const unsigned int channels,
+                             const unsigned int filter_size)
+{
+  const unsigned int w = RTA_CORRELATION_AVX2_WIDTH;
+  unsigned int ch, c, f;
+
+  /* the last vector overlaps the previous channels */
+  for(ch=0; ch < channels; ch += w)
+  {
+    if(ch + w > channels)
+    {
+      if(channels < w)
+      {
+        break;
+      }
+      ch = channels - w;
+    }
+
+    for(c=0; c + RTA_CORRELATION_BLOCK <= c_size; c += RTA_CORRELATION_BLOCK)
+    {
+      const rta_real_t * a = input_vector_a + c * i_stride + ch;
+      const rta_real_t * b = input_vector_b + ch;
+      __m256 s0 = _mm256_setzero_ps();
+      __m256 s1 = _mm256_setzero_ps();
+      __m256 s2 = _mm256_setzero_ps();
+      __m256 s3 = _mm256_setzero_ps();
+
+      for(f=0; f<filter_size; f++, a += i_stride, b += i_stride)
+      {
+        const __m256 vb = _mm256_loadu_ps(b);
+
+        s0 = _mm256_fmadd_ps(_mm256_loadu_ps(a), vb, s0);
+        s1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i_stride), vb, s1);
+        s2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + 2 * i_stride), vb, s2);
+        s3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + 3 * i_stride), vb, s3);
+      }
+
+      _mm256_storeu_ps(correlation + c * c_stride + ch, s0);
+      _mm256_storeu_ps(correlation + (c + 1) * c_stride + ch, s1);
+      _mm256_storeu_ps(correlation + (c + 2) * c_stride + ch, s2);
+      _mm256_storeu_ps(correlation + (c + 3) * c_stride + ch, s3);
+    }
+
+    for(; c < c_size; c++)
+    {
+      const rta_real_t * a = input_vector_a + c * i_stride + ch;
+      const rta_real_t * b = input_vector_b + ch;
+      __m256 s0 = _mm256_setzero_ps();
+
+      for(f=0; f<filter_size; f++, a += i_stride, b += i_stride)
+      {
+        s0 = _mm256_fmadd_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b), s0);
+      }
+
+      _mm256_storeu_ps(correlation + c * c_stride + ch, s0);
+    }
+  }
+
+  return ch;
+}
+
+/* single precision inputs, converted to double precision */
+static __attribute__((target("avx2,fma"))) unsigned int
+correlation_double_avx2(double * correlation, const unsigned int c_size,
+                        const rta_real_t * input_vector_a,
+                        const rta_real_t * input_vector_b,
+                        const unsigned int filter_size)
+{
+  const unsigned int w = 4; /* doubles per vector */
+  unsigned int c, f;
+
+  for(c=0; c + RTA_CORRELATION_BLOCK * w <= c_size;
+      c += RTA_CORRELATION_BLOCK * w)
+  {
+    const rta_real_t * a = input_vector_a + c;
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd();
+    __m256d s3 = _mm256_setzero_pd();
+
+    for(f=0; f<filter_size; f++)
+    {
+      const __m256d b = _mm256_set1_pd(input_vector_b[f]);
+
+      s0 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(a + f)), b, s0);
+      s1 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(a + f + w)), b, s1);
+      s2 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(a + f + 2 * w)), b,
+                           s2);
+      s3 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(a + f + 3 * w)), b,
+                           s3);
+    }
+
+    _mm256_storeu_pd(correlation + c, s0);
+    _mm256_storeu_pd(correlation + c + w, s1);
+    _mm256_storeu_pd(correlation + c + 2 * w, s2);
+    _mm256_storeu_pd(correlation + c + 3 * w, s3);
+  }
+
+  /* remaining vectors, the last one overlapping the previous lags */
+  for(; c < c_size; c += w)
+  {
+    const rta_real_t * a;
+    __m256d s0 = _mm256_setzero_pd();
+
+    if(c + w > c_size)
+    {
+      if(c_size < w)
+      {
+        break;
+      }
+      c = c_size - w;
+    }
+
+    a = input_vector_a + c;
+
+    for(f=0; f<filter_size; f++)
+    {
+      s0 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(a + f)),
+                           _mm256_set1_pd(input_vector_b[f]), s0);
+    }
+
+    _mm256_storeu_pd(correlation + c, s0);
+  }
+
+  return c;
+}
+
+#endif /* single precision x86 */
+
+/* ------- AVX2, double precision --------------------------------------- */
+#if defined(RTA_CORRELATION_USE_X86) && (RTA_REAL_TYPE == RTA_DOUBLE_TYPE)
+
+#define RTA_CORRELATION_AVX2_WIDTH 4
+
+static inline __attribute__((target("avx"), always_inline)) void
+store_lags_avx2(rta_real_t * correlation, const int c_stride,
+                const __m256d v)
+{
+  if(c_stride == 1)
+  {
+    _mm256_storeu_pd(correlation, v);
+  }
+  else
+  {
+    rta_real_t lags[RTA_CORRELATION_AVX2_WIDTH];
+    int l;
+
+    _mm256_storeu_pd(lags, v);
+    for(l=0; l<RTA_CORRELATION_AVX2_WIDTH; l++)
+    {
+      correlation[l * c_stride] = lags[l];
+    }
+  }
+  return;
+}
+
+static __attribute__((target("avx2,fma"))) unsigned int
+correlation_fast_avx2(rta_real_t * correlation, const int c_stride,
+                      const unsigned int c_size,
+                      const rta_real_t * input_vector_a,
+                      const rta_real_t * input_vector_b,
+                      const unsigned int filter_size)
+{
+  const unsigned int w = RTA_CORRELATION_AVX2_WIDTH;
+  unsigned int c, f;
+
+  for(c=0; c + RTA_CORRELATION_BLOCK * w <= c_size;
+      c += RTA_CORRELATION_BLOCK * w)
+  {
+    const rta_real_t * a = input_vector_a + c;
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd();
+    __m256d s3 = _mm256_setzero_pd();
+
+    for(f=0; f<filter_size; f++)
+    {
+      const __m256d b = _mm256_broadcast_sd(input_vector_b + f);
+
+      s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + f), b, s0);
+      s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + f + w), b, s1);
+      s2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + f + 2 * w), b, s2);
+      s3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + f + 3 * w), b, s3);
+    }
+
+    store_lags_avx2(correlation + c * c_stride, c_stride, s0);
+    store_lags_avx2(correlation + (c + w) * c_stride, c_stride, s1);
+    store_lags_avx2(correlation + (c + 2 * w) * c_stride, c_stride, s2);
+    store_lags_avx2(correlation + (c + 3 * w) * c_stride, c_stride, s3);
+  }
+
+  /* remaining vectors, the last one overlapping the previous lags */
+  /* (unless in place) */
+  for(; c < c_size; c += w)
+  {
+    const rta_real_t * a;
+    __m256d s0 = _mm256_setzero_pd();
+
+    if(c + w > c_size)
+    {
+      if(c_size < w || correlation == input_vector_a)
+      {
+        break;
+      }
+      c = c_size - w;
+    }
+
+    a = input_vector_a + c;
+
+    for(f=0; f<filter_size; f++)
+    {
+      s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + f),
+                           _mm256_broadcast_sd(input_vector_b + f), s0);
+    }
+
+    store_lags_avx2(correlation + c * c_stride, c_stride, s0);
+  }
+
+  return c;
+}
+
+static __attribute__((target("avx2,fma"))) unsigned int
+correlation_interleaved_avx2(rta_real_t * correlation, const int c_stride,
+                             const unsigned int c_size,
+                             const rta_real_t * input_vector_a,
+                             const rta_real_t * input_vector_b,
+                             const int i_stride, const unsigned int channels,
+                             const unsigned int filter_size)
+{
+  const unsigned int w = RTA_CORRELATION_AVX2_WIDTH;
+  unsigned int ch, c, f;
+
+  /* the last vector overlaps the previous channels */
+  for(ch=0; ch < channels; ch += w)
+  {
+    if(ch + w > channels)
+    {
+      if(channels < w)
+      {
+        break;
+      }
+      ch = channels - w;
+    }
+
+    for(c=0; c + RTA_CORRELATION_BLOCK <= c_size; c += RTA_CORRELATION_BLOCK)
+    {
+      const rta_real_t * a = input_vector_a + c * i_stride + ch;
+      const rta_real_t * b = input_vector_b + ch;
+      __m256d s0 = _mm256_setzero_pd();
+      __m256d s1 = _mm256_setzero_pd();
+      __m256d s2 = _mm256_setzero_pd();
+      __m256d s3 = _mm256_setzero_pd();
+
+      for(f=0; f<filter_size; f++, a += i_stride, b += i_stride)
+      {
+        const __m256d vb = _mm256_loadu_pd(b);
+
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a), vb, s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i_stride), vb, s1);
+        s2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + 2 * i_stride), vb, s2);
+        s3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + 3 * i_stride), vb, s3);
+      }
+
+      _mm256_storeu_pd(correlation + c * c_stride + ch, s0);
+      _mm256_storeu_pd(correlation + (c + 1) * c_stride + ch, s1);
+      _mm256_storeu_pd(correlation + (c + 2) * c_stride + ch, s2);
+      _mm256_storeu_pd(correlation + (c + 3) * c_stride + ch, s3);
+    }
+
+    for(; c < c_size; c++)
+    {
+      const rta_real_t * a = input_vector_a + c * i_stride + ch;
+      const rta_real_t * b = input_vector_b + ch;
+      __m256d s0 = _mm256_setzero_pd();
+
+      for(f=0; f<filter_size; f++, a += i_stride, b += i_stride)
+      {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b), s0);
+      }
+
+      _mm256_storeu_pd(correlation + c * c_stride + ch, s0);
+    }
+  }
+
+  return ch;
+}
+
+/* already in double precision */
+static unsigned int
+correlation_double_avx2(double * correlation, const unsigned int c_size,
+                        const rta_real_t * input_vector_a,
+                        const rta_real_t * input_vector_b,
+                        const unsigned int filter_size)
+{
+  return correlation_fast_avx2(correlation, 1, c_size,
+                               input_vector_a, input_vector_b, filter_size);
+}
+
+#endif /* double precision x86 */
+
+#if defined(RTA_CORRELATION_USE_X86)
+static const rta_correlation_simd_t correlation_simd_avx2 =
+{
+  "AVX2",
+  correlation_fast_avx2,
+  correlation_interleaved_avx2,
+  correlation_double_avx2
+};
+#endif /* RTA_CORRELATION_USE_X86 */
+
+/* ------- NEON, single precision --------------------------------------- */
+#if defined(RTA_CORRELATION_USE_NEON)
+
+#define RTA_CORRELATION_NEON_WIDTH 4
+
+static inline void
+store_lags_neon(rta_real_t * correlation, const int c_stride,
+                const float32x4_t v)
+{
+  if(c_stride == 1)
+  {
+    vst1q_f32(correlation, v);
+  }
+  else
+  {
+    rta_real_t lags[RTA_CORRELATION_NEON_WIDTH];
+    int l;
+
+    vst1q_f32(lags, v);
+    for(l=0; l<RTA_CORRELATION_NEON_WIDTH; l++)
+    {
+      correlation[l * c_stride] = lags[l];
+    }
+  }
+  return;
+}
+
+static unsigned int
+correlation_fast_neon(rta_real_t * correlation, const int c_stride,
+                      const unsigned int c_size,
+                      const rta_real_t * input_vector_a,
+                      const rta_real_t * input_vector_b,
+                      const unsigned int filter_size)
+{
+  const unsigned int w = RTA_CORRELATION_NEON_WIDTH;
+  unsigned int c, f;
+
+  for(c=0; c + RTA_CORRELATION_BLOCK * w <= c_size;
+      c += RTA_CORRELATION_BLOCK * w)
+  {
+    const rta_real_t * a = input_vector_a + c;
+    float32x4_t s0 = vdupq_n_f32(0.);
+    float32x4_t s1 = vdupq_n_f32(0.);
+    float32x4_t s2 = vdupq_n_f32(0.);
+    float32x4_t s3 = vdupq_n_f32(0.);
+
+    for(f=0; f<filter_size; f++)
+    {
+      const float b = input_vector_b[f];
+
+      s0 = vmlaq_n_f32(s0, vld1q_f32(a + f), b);
+      s1 = vmlaq_n_f32(s1, vld1q_f32(a + f + w), b);
+      s2 = vmlaq_n_f32(s2, vld1q_f32(a + f + 2 * w), b);
+      s3 = vmlaq_n_f32(s3, vld1q_f32(a + f + 3 * w), b);
+    }
+
+    store_lags_neon(correlation + c * c_stride, c_stride, s0);
+    store_lags_neon(correlation + (c + w) * c_stride, c_stride, s1);
+    store_lags_neon(correlation + (c + 2 * w) * c_stride, c_stride, s2);
+    store_lags_neon(correlation + (c + 3 * w) * c_stride, c_stride, s3);
+  }
+
+  /* remaining vectors, the last one overlapping the previous lags */
+  /* (unless in place) */
+  for(; c < c_size; c += w)
+  {
+    const rta_real_t * a;
+    float32x4_t s0 = vdupq_n_f32(0.);
+
+    if(c + w > c_size)
+    {
+      if(c_size < w || correlation == input_vector_a)
+      {
+        break;
+      }
+      c = c_size - w;
+    }
+
+    a = input_vector_a + c;
+
+    for(f=0; f<filter_size; f++)
+    {
+      s0 = vmlaq_n_f32(s0, vld1q_f32(a + f), input_vector_b[f]);
+    }
+
+    store_lags_neon(correlation + c * c_stride, c_stride, s0);
+  }
+
+  return c;
+}
+
+static unsigned int
+correlation_interleaved_neon(rta_real_t * correlation, const int c_stride,
+                             const unsigned int c_size,
+                             const rta_real_t * input_vector_a,
+                             const rta_real_t * input_vector_b,
+                             const int i_stride, const unsigned int channels,
+                             const unsigned int filter_size)
+{
+  const unsigned int w = RTA_CORRELATION_NEON_WIDTH;
+  unsigned int ch, c, f;
+
+  /* the last vector overlaps the previous channels */
+  for(ch=0; ch < channels; ch += w)
+  {
+    if(ch + w > channels)
+    {
+      if(channels < w)
+      {
+        break;
+      }
+      ch = channels - w;
+    }
+
+    for(c=0; c + RTA_CORRELATION_BLOCK <= c_size; c += RTA_CORRELATION_BLOCK)
+    {
+      const rta_real_t * a = input_vector_a + c * i_stride + ch;
+      const rta_real_t * b = input_vector_b + ch;
+      float32x4_t s0 = vdupq_n_f32(0.);
+      float32x4_t s1 = vdupq_n_f32(0.);
+      float32x4_t s2 = vdupq_n_f32(0.);
+      float32x4_t s3 = vdupq_n_f32(0.);
+
+      for(f=0; f<filter_size; f++, a += i_stride, b += i_stride)
+      {
+        const float32x4_t vb = vld1q_f32(b);
+
+        s0 = vmlaq_f32(s0, vld1q_f32(a), vb);
+        s1 = vmlaq_f32(s1, vld1q_f32(a + i_stride), vb);
+        s2 = vmlaq_f32(s2, vld1q_f32(a + 2 * i_stride), vb);
+        s3 = vmlaq_f32(s3, vld1q_f32(a + 3 * i_stride), vb);
+      }
+
+      vst1q_f32(correlation + c * c_stride + ch, s0);
+      vst1q_f32(correlation + (c + 1) * c_stride + ch, s1);
+      vst1q_f32(correlation + (c + 2) * c_stride + ch, s2);
+      vst1q_f32(correlation + (c + 3) * c_stride + ch, s3);
+    }
+
+    for(; c < c_size; c++)
+    {
+      const rta_real_t * a = input_vector_a + c * i_stride + ch;
+      const rta_real_t * b = input_vector_b + ch;
+      float32x4_t s0 = vdupq_n_f32(0.);
+
+      for(f=0; f<filter_size; f++, a += i_stride, b += i_stride)
+      {
+        s0 = vmlaq_f32(s0, vld1q_f32(a), vld1q_f32(b));
+      }
+
+      vst1q_f32(correlation + c * c_stride + ch, s0);
+    }
+  }
+
+  return ch;
+}
+
+static const rta_correlation_simd_t correlation_simd_neon =
+{
+  "NEON",
+  correlation_fast_neon,
+  correlation_interleaved_neon,
+  NULL /* no double precision vectors on 32-bit ARM */
+};
+
+#endif /* RTA_CORRELATION_USE_NEON */
+
+
+const rta_correlation_simd_t *
+rta_correlation_simd_get(void)
+{
+  const rta_correlation_simd_t * ret = NULL;
+
+#if defined(RTA_CORRELATION_USE_X86)
+  __builtin_cpu_init();
+
+  if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+  {
+    ret = &correlation_simd_avx2;
+  }
+#elif defined(RTA_CORRELATION_USE_NEON)
+  ret = &correlation_simd_neon;
+#endif
+
+  return ret;
+}
@@ -40,13 +40,77 @@
  */
 
 #include "rta_fft.h"
+#include "rta_fftintern.h" /* vectorised kernels */
 #include "rta_complex.h"
 #include "rta_stdlib.h" /* memory management */
 
 #include "rta_int.h"  /* integer log2 function */
 #include "rta_math.h" /* M_PI, cos, sin */
+#include "rta_thread.h" /* worker threads */
+
+#if defined(WIN32) || defined(_WIN32)
+#include <windows.h> /* plan cache lock */
+#else
+#include <pthread.h> /* plan cache lock */
+#endif
 
 /* -------  private (depends on implementation) ------ */
+
+/* maximum number of mixed radix passes (for sizes < 2^32) */
+#define RTA_FFT_FACTORS_MAX 32
+
+/* largest radix of the mixed radix passes */
+#define RTA_FFT_RADIX_MAX 7
+
+/* smallest complex FFT size computed in four steps (see routine: */
+/* fft_four_step_inplace()), as the buffer outgrows the L2 cache */
+#define RTA_FFT_FOUR_STEP_SIZE (1 << 17)
+
+/* rows or columns processed together by the four-step FFT */
+#define RTA_FFT_FOUR_STEP_BLOCK 16
+
+/* frames of a batch transformed together (see routine: */
+/* rta_fft_execute_batch()), a multiple of every vector width */
+#define RTA_FFT_BATCH_TILE 8
+
+/* largest complex FFT size of the batches transformed by tiles of */
+/* frames: beyond, the tile outgrows the L1 cache and the frames are */
+/* faster one by one (sooner in double precision, with half as many */
+/* values per vector) */
+#if (RTA_REAL_TYPE == RTA_FLOAT_TYPE)
+#define RTA_FFT_BATCH_SIZE_MAX 256
+#else
+#define RTA_FFT_BATCH_SIZE_MAX 64
+#endif
+
+/* tables, shared by the setups of the same size */
+struct rta_fft_plan
+{
+  unsigned int fft_size;
+  unsigned int log2_size;
+  unsigned int complex_size; /**< half of 'fft_size' for real transforms */
+  rta_real_t * cos;
+  rta_real_t * sin;
+  unsigned int * bitrev;
+  rta_real_t * twiddles;   /**< radix-4 or mixed radix coefficients, */
+                           /**< contiguous by pass */
+  const rta_fft_simd_t * simd; /**< vectorised kernels or NULL */
+  unsigned int factors[RTA_FFT_FACTORS_MAX]; /**< mixed radix passes */
+  unsigned int factors_size; /**< 0 for power of 2 sizes */
+  rta_real_t * stockham;   /**< Stockham coefficients of power of 2 */
+                           /**< sizes, computed on demand */
+  unsigned int stockham_factors[RTA_FFT_FACTORS_MAX];
+  unsigned int stockham_factors_size;
+  rta_fft_plan_t * columns; /**< four-step FFT of 'columns_size' points */
+  rta_fft_plan_t * rows;    /**< four-step FFT of 'rows_size' points */
+  unsigned int columns_size;
+  unsigned int rows_size;
+  rta_real_t * four_step;   /**< four-step coefficients of large power */
+                            /**< of 2 sizes, computed on demand */
+  unsigned int references; /**< acquisitions of a cached plan, 0 otherwise */
+  rta_fft_plan_t * next;   /**< next cached plan */
+};
+
 /* from FTS implementation (Butterfly) */
 struct rta_fft_setup
 {
@@ -56,13 +120,15 @@ struct rta_fft_setup
   void * input;
   int i_stride;
   unsigned int input_size;
-  unsigned int log2_size;
   rta_fft_t fft_type;
+  rta_fft_kernel_t kernel;
   rta_real_t * nyquist;    /**< last coefficient for real transforms */
   rta_real_t * scale;
-  rta_real_t * cos;
-  rta_real_t * sin;
-  unsigned int * bitrev;
+  rta_fft_plan_t * plan;   /**< read-only tables */
+  int plan_owner;          /**< plan released with the setup */
+  rta_real_t * scratch;    /**< mixed radix and four-step work buffer */
+  rta_thread_pool_t * thread_pool; /**< four-step blocks, or NULL */
+  rta_real_t * batch;      /**< tiles of frames of the batches, or NULL */
 }; /* from fft_lookup_t */
 
 
@@ -232,7 +298,7 @@ fft_inplace_stride(rta_complex_t * buf,
 
       int incr = 2 * up * b_stride;
 	  
-      for(m=j*b_stride, n=(j+up)*b_stride; m<size; m+=incr, n+=incr)
+      for(m=j*b_stride, n=(j+up)*b_stride; m<size*b_stride; m+=incr, n+=incr)
       {
         rta_complex_t A = buf[m];
         rta_complex_t B = buf[n];
@@ -304,7 +370,7 @@ fft_inplace_oversampled_coefficients_stride(rta_complex_t * buf,
 
       int incr = 2 * up * b_stride;
 	  
-      for(m=j*b_stride, n=(j+up)*b_stride; m<size; m+=incr, n+=incr)
+      for(m=j*b_stride, n=(j+up)*b_stride; m<size*b_stride; m+=incr, n+=incr)
       {
         rta_complex_t A = buf[m];
         rta_complex_t B = buf[n];
@@ -373,7 +439,7 @@ ifft_inplace_stride(rta_complex_t * buf,
 
       int incr = 2 * up * b_stride;
 	  
-      for(m=j*b_stride, n=(j+up)*b_stride; m<size; m+=incr, n+=incr)
+      for(m=j*b_stride, n=(j+up)*b_stride; m<size*b_stride; m+=incr, n+=incr)
       {
         rta_complex_t A = buf[m];
         rta_complex_t B = buf[n];
@@ -443,7 +509,7 @@ ifft_inplace_oversampled_coefficients_stride(rta_complex_t * buf,
 
       int incr = 2 * up * b_stride;
 	  
-      for(m=j*b_stride, n=(j+up)*b_stride; m<size; m+=incr, n+=incr)
+      for(m=j*b_stride, n=(j+up)*b_stride; m<size*b_stride; m+=incr, n+=incr)
       {
         rta_complex_t A = buf[m];
         rta_complex_t B = buf[n];
@@ -459,6 +525,689 @@ ifft_inplace_oversampled_coefficients_stride(rta_complex_t * buf,
   return;
 }
 
+/********************************************************************
+ * radix-4 pass on bit reversed shuffled data
+ *
+ *   Two radix-2 stages are merged into one pass of radix-4
+ *   butterflies, which saves a quarter of the complex
+ *   multiplications and half of the passes over the buffer.
+ *
+ *   buf ... interleaved real and imaginary values, 'size' complex points
+ *   twiddles ... coefficients of this pass: 'up' complex values for
+ *     each of W, W^2 and W^3, with W = exp(j*2*PI*n/(4*up))
+ *     (see routine: twiddles_new())
+ *   up ... half-size of the first merged radix-2 butterflies
+ *   direction ... -1 for FFT and 1 for IFFT
+ */
+static void
+radix_4_pass(rta_real_t * buf,
+             const rta_real_t * twiddles,
+             const unsigned int size,
+             const unsigned int up,
+             const rta_real_t direction)
+{
+  const unsigned int incr = 8 * up; /* 4 * up complex */
+  unsigned int j, m;
+
+  for(m=0; m<2*size; m+=incr)
+  {
+    rta_real_t * b0 = buf + m;
+    rta_real_t * b1 = b0 + 2 * up;
+    rta_real_t * b2 = b1 + 2 * up;
+    rta_real_t * b3 = b2 + 2 * up;
+
+    for(j=0; j<2*up; j+=2)
+    {
+      /* W = exp(direction * j*2*PI*n/(4*up)), W2 = W^2, W3 = W^3 */
+      const rta_real_t w1r = twiddles[j];
+      const rta_real_t w1i = direction * twiddles[j + 1];
+      const rta_real_t w2r = twiddles[2 * up + j];
+      const rta_real_t w2i = direction * twiddles[2 * up + j + 1];
+      const rta_real_t w3r = twiddles[4 * up + j];
+      const rta_real_t w3i = direction * twiddles[4 * up + j + 1];
+
+      /* bit reversed order: b0, b1, b2 and b3 hold the transforms */
+      /* of the samples 4n, 4n+2, 4n+1 and 4n+3 */
+      const rta_real_t c1r = b1[j] * w2r - b1[j+1] * w2i;
+      const rta_real_t c1i = b1[j] * w2i + b1[j+1] * w2r;
+      const rta_real_t c2r = b2[j] * w1r - b2[j+1] * w1i;
+      const rta_real_t c2i = b2[j] * w1i + b2[j+1] * w1r;
+      const rta_real_t c3r = b3[j] * w3r - b3[j+1] * w3i;
+      const rta_real_t c3i = b3[j] * w3i + b3[j+1] * w3r;
+
+      const rta_real_t s0r = b0[j] + c1r;
+      const rta_real_t s0i = b0[j+1] + c1i;
+      const rta_real_t d0r = b0[j] - c1r;
+      const rta_real_t d0i = b0[j+1] - c1i;
+      const rta_real_t s1r = c2r + c3r;
+      const rta_real_t s1i = c2i + c3i;
+
+      /* direction * j * (c2 - c3) */
+      const rta_real_t d1r = direction * (c3i - c2i);
+      const rta_real_t d1i = direction * (c2r - c3r);
+
+      b0[j]   = s0r + s1r;
+      b0[j+1] = s0i + s1i;
+      b1[j]   = d0r + d1r;
+      b1[j+1] = d0i + d1i;
+      b2[j]   = s0r - s1r;
+      b2[j+1] = s0i - s1i;
+      b3[j]   = d0r - d1r;
+      b3[j+1] = d0i - d1i;
+    }
+  }
+  return;
+}
+
+/********************************************************************
+ * radix-4 FFT on bit reversed shuffled data
+ *
+ *   A single radix-2 pass (with trivial coefficients) is done first
+ *   when log2('size') is odd, then radix-4 passes.
+ *
+ *   buf ... interleaved real and imaginary values, 'size' complex points
+ *   twiddles ... coefficients of all the radix-4 passes
+ *   direction ... -1 for FFT and 1 for IFFT
+ *   simd ... vectorised kernels, or NULL for scalar code only
+ */
+static void
+fft_radix_4_inplace(rta_real_t * buf,
+                    const rta_real_t * twiddles,
+                    const unsigned int size,
+                    const rta_real_t direction,
+                    const rta_fft_simd_t * simd)
+{
+  unsigned int up, m;
+
+  /* first radix-2 pass if log2(size) is odd */
+  if(rta_ilog2(size) & 1)
+  {
+    for(m=0; m<2*size; m+=4)
+    {
+      const rta_real_t ar = buf[m];
+      const rta_real_t ai = buf[m+1];
+      const rta_real_t br = buf[m+2];
+      const rta_real_t bi = buf[m+3];
+
+      buf[m]   = ar + br;
+      buf[m+1] = ai + bi;
+      buf[m+2] = ar - br;
+      buf[m+3] = ai - bi;
+    }
+    up = 2;
+  }
+  else
+  {
+    up = 1;
+  }
+
+  for(; up<size; up<<=2)
+  {
+    /* vectorised kernels need at least a full vector of butterflies */
+    if(simd != NULL && up >= simd->width)
+    {
+      simd->radix_4_pass(buf, twiddles, size, up, direction);
+    }
+    else
+    {
+      radix_4_pass(buf, twiddles, size, up, direction);
+    }
+    twiddles += 6 * up;
+  }
+  return;
+}
+
+
+/********************************************************************
+ * mixed radix pass (Stockham autosort, decimation in frequency)
+ *
+ *   Computes the 'n' / 'p' DFTs of size 'p' of the sub-sequences of
+ *   'x' and writes them in sorted order to 'y', multiplied by the
+ *   coefficients W^k, W = exp(direction * j*2*PI*n/'n'), k = 1..p-1.
+ *   The complex FFT is a sequence of such passes, with 'n' divided
+ *   and 's' multiplied by 'p' after each one. No bit reversal is
+ *   needed.
+ *
+ *   x, y ... interleaved real and imaginary values, must not overlap
+ *   twiddles ... coefficients of this pass: p-1 complex values
+ *     for each of the 'n' / 'p' butterfly groups
+ *     (see routine: mixed_radix_tables_new())
+ *   n ... size of the current sub-transforms
+ *   s ... stride of the current sub-transforms (product of the
+ *     factors of the previous passes)
+ *   p ... radix (2, 3, 4, 5 or 7)
+ *   direction ... -1 for FFT and 1 for IFFT
+ */
+
+/* b = (re + j * im) * (wr + j * wi) */
+#define fft_store_twiddled(b, re, im, wr, wi) \
+  ((b)[0] = (re) * (wr) - (im) * (wi), (b)[1] = (re) * (wi) + (im) * (wr))
+
+static void
+mixed_radix_pass(const rta_real_t * x, rta_real_t * y,
+                 const rta_real_t * twiddles,
+                 const unsigned int n, const unsigned int s,
+                 const unsigned int p, const rta_real_t direction)
+{
+  const unsigned int m = n / p;
+  const unsigned int x_step = 2 * s * m; /* between inputs of a DFT */
+  const unsigned int y_step = 2 * s;     /* between outputs of a DFT */
+  unsigned int j, q;
+
+  switch(p)
+  {
+    case 2:
+    {
+      for(j=0; j<m; j++)
+      {
+        const rta_real_t w1r = twiddles[2 * j];
+        const rta_real_t w1i = direction * twiddles[2 * j + 1];
+
+        for(q=0; q<s; q++)
+        {
+          const rta_real_t * a = x + 2 * (q + s * j);
+          rta_real_t * b = y + 2 * (q + s * p * j);
+
+          const rta_real_t a0r = a[0];
+          const rta_real_t a0i = a[1];
+          const rta_real_t a1r = a[x_step];
+          const rta_real_t a1i = a[x_step + 1];
+
+          b[0] = a0r + a1r;
+          b[1] = a0i + a1i;
+          fft_store_twiddled(b + y_step, a0r - a1r, a0i - a1i, w1r, w1i);
+        }
+      }
+      break;
+    }
+
+    case 3:
+    {
+      /* direction * sin(2*PI/3) */
+      const rta_real_t s1 = direction * 0.86602540378443864676;
+
+      for(j=0; j<m; j++)
+      {
+        const rta_real_t * w = twiddles + 4 * j;
+        const rta_real_t w1r = w[0];
+        const rta_real_t w1i = direction * w[1];
+        const rta_real_t w2r = w[2];
+        const rta_real_t w2i = direction * w[3];
+
+        for(q=0; q<s; q++)
+        {
+          const rta_real_t * a = x + 2 * (q + s * j);
+          rta_real_t * b = y + 2 * (q + s * p * j);
+
+          const rta_real_t t1r = a[x_step] + a[2 * x_step];
+          const rta_real_t t1i = a[x_step + 1] + a[2 * x_step + 1];
+          const rta_real_t t2r = a[0] - 0.5 * t1r;
+          const rta_real_t t2i = a[1] - 0.5 * t1i;
+          /* j * direction * sin(2*PI/3) * (a1 - a2) */
+          const rta_real_t t3r = -s1 * (a[x_step + 1] - a[2 * x_step + 1]);
+          const rta_real_t t3i = s1 * (a[x_step] - a[2 * x_step]);
+
+          b[0] = a[0] + t1r;
+          b[1] = a[1] + t1i;
+          fft_store_twiddled(b + y_step, t2r + t3r, t2i + t3i, w1r, w1i);
+          fft_store_twiddled(b + 2 * y_step, t2r - t3r, t2i - t3i, w2r, w2i);
+        }
+      }
+      break;
+    }
+
+    case 4:
+    {
+      for(j=0; j<m; j++)
+      {
+        const rta_real_t * w = twiddles + 6 * j;
+        const rta_real_t w1r = w[0];
+        const rta_real_t w1i = direction * w[1];
+        const rta_real_t w2r = w[2];
+        const rta_real_t w2i = direction * w[3];
+        const rta_real_t w3r = w[4];
+        const rta_real_t w3i = direction * w[5];
+
+        for(q=0; q<s; q++)
+        {
+          const rta_real_t * a = x + 2 * (q + s * j);
+          rta_real_t * b = y + 2 * (q + s * p * j);
+
+          const rta_real_t s0r = a[0] + a[2 * x_step];
+          const rta_real_t s0i = a[1] + a[2 * x_step + 1];
+          const rta_real_t d0r = a[0] - a[2 * x_step];
+          const rta_real_t d0i = a[1] - a[2 * x_step + 1];
+          const rta_real_t s1r = a[x_step] + a[3 * x_step];
+          const rta_real_t s1i = a[x_step + 1] + a[3 * x_step + 1];
+          /* j * direction * (a1 - a3) */
+          const rta_real_t d1r = -direction * (a[x_step + 1] - a[3 * x_step + 1]);
+          const rta_real_t d1i = direction * (a[x_step] - a[3 * x_step]);
+
+          b[0] = s0r + s1r;
+          b[1] = s0i + s1i;
+          fft_store_twiddled(b + y_step, d0r + d1r, d0i + d1i, w1r, w1i);
+          fft_store_twiddled(b + 2 * y_step, s0r - s1r, s0i - s1i, w2r, w2i);
+          fft_store_twiddled(b + 3 * y_step, d0r - d1r, d0i - d1i, w3r, w3i);
+        }
+      }
+      break;
+    }
+
+    case 5:
+    {
+      /* cos(2*PI/5), cos(4*PI/5), direction * sin(2*PI/5) and sin(4*PI/5) */
+      const rta_real_t c1 = 0.30901699437494742410;
+      const rta_real_t c2 = -0.80901699437494742410;
+      const rta_real_t s1 = direction * 0.95105651629515357212;
+      const rta_real_t s2 = direction * 0.58778525229247312917;
+
+      for(j=0; j<m; j++)
+      {
+        const rta_real_t * w = twiddles + 8 * j;
+
+        for(q=0; q<s; q++)
+        {
+          const rta_real_t * a = x + 2 * (q + s * j);
+          rta_real_t * b = y + 2 * (q + s * p * j);
+
+          const rta_real_t t1r = a[x_step] + a[4 * x_step];
+          const rta_real_t t1i = a[x_step + 1] + a[4 * x_step + 1];
+          const rta_real_t t2r = a[2 * x_step] + a[3 * x_step];
+          const rta_real_t t2i = a[2 * x_step + 1] + a[3 * x_step + 1];
+          const rta_real_t t3r = a[x_step] - a[4 * x_step];
+          const rta_real_t t3i = a[x_step + 1] - a[4 * x_step + 1];
+          const rta_real_t t4r = a[2 * x_step] - a[3 * x_step];
+          const rta_real_t t4i = a[2 * x_step + 1] - a[3 * x_step + 1];
+
+          const rta_real_t u1r = a[0] + c1 * t1r + c2 * t2r;
+          const rta_real_t u1i = a[1] + c1 * t1i + c2 * t2i;
+          const rta_real_t u2r = a[0] + c2 * t1r + c1 * t2r;
+          const rta_real_t u2i = a[1] + c2 * t1i + c1 * t2i;
+
+          /* j * direction * (sin(2*PI/5) * t3 + sin(4*PI/5) * t4) */
+          const rta_real_t v1r = -(s1 * t3i + s2 * t4i);
+          const rta_real_t v1i = s1 * t3r + s2 * t4r;
+          /* j * direction * (sin(4*PI/5) * t3 - sin(2*PI/5) * t4) */
+          const rta_real_t v2r = -(s2 * t3i - s1 * t4i);
+          const rta_real_t v2i = s2 * t3r - s1 * t4r;
+
+          b[0] = a[0] + t1r + t2r;
+          b[1] = a[1] + t1i + t2i;
+          fft_store_twiddled(b + y_step, u1r + v1r, u1i + v1i,
+                             w[0], direction * w[1]);
+          fft_store_twiddled(b + 2 * y_step, u2r + v2r, u2i + v2i,
+                             w[2], direction * w[3]);
+          fft_store_twiddled(b + 3 * y_step, u2r - v2r, u2i - v2i,
+                             w[4], direction * w[5]);
+          fft_store_twiddled(b + 4 * y_step, u1r - v1r, u1i - v1i,
+                             w[6], direction * w[7]);
+        }
+      }
+      break;
+    }
+
+    default:
+    {
+      /* direct DFT of size p (radix 7) */
+      rta_real_t omega_real[RTA_FFT_RADIX_MAX];
+      rta_real_t omega_imag[RTA_FFT_RADIX_MAX];
+      unsigned int k, r;
+
+      /* exp(direction * j*2*PI*k/p), k = 0..p-1 */
+      for(k=0; k<p; k++)
+      {
+        omega_real[k] = rta_cos(2. * M_PI * k / p);
+        omega_imag[k] = direction * rta_sin(2. * M_PI * k / p);
+      }
+
+      for(j=0; j<m; j++)
+      {
+        const rta_real_t * w = twiddles + 2 * (p - 1) * j;
+
+        for(q=0; q<s; q++)
+        {
+          const rta_real_t * a = x + 2 * (q + s * j);
+          rta_real_t * b = y + 2 * (q + s * p * j);
+
+          for(k=0; k<p; k++)
+          {
+            rta_real_t sum_real = 0.;
+            rta_real_t sum_imag = 0.;
+            unsigned int t = 0; /* r * k modulo p */
+
+            for(r=0; r<p; r++)
+            {
+              const rta_real_t ar = a[r * x_step];
+              const rta_real_t ai = a[r * x_step + 1];
+
+              sum_real += ar * omega_real[t] - ai * omega_imag[t];
+              sum_imag += ar * omega_imag[t] + ai * omega_real[t];
+
+              t += k;
+              if(t >= p)
+              {
+                t -= p;
+              }
+            }
+
+            if(k == 0)
+            {
+              b[0] = sum_real;
+              b[1] = sum_imag;
+            }
+            else
+            {
+              fft_store_twiddled(b + k * y_step, sum_real, sum_imag,
+                                 w[2 * (k - 1)], direction * w[2 * (k - 1) + 1]);
+            }
+          }
+        }
+      }
+      break;
+    }
+  }
+  return;
+}
+
+/********************************************************************
+ * Stockham passes of a mixed radix FFT
+ *
+ *   x ... input, 'size' * 's' complex points: 's' interleaved
+ *     sequences of 'size' points
+ *   y ... work buffer of the same size
+ *   twiddles ... coefficients of all the passes
+ *   factors ... radix of each pass
+ *   size ... number of complex points of each sequence
+ *   s ... number of interleaved sequences: 1 for a single FFT
+ *   direction ... -1 for FFT and 1 for IFFT
+ *   simd ... vectorised kernels for the radix-4 passes, or NULL
+ *
+ *   return the result, 'x' or 'y', in natural order and interleaved
+ *   as the input
+ */
+static rta_real_t *
+stockham_passes(rta_real_t * x, rta_real_t * y,
+                const rta_real_t * twiddles,
+                const unsigned int * factors,
+                const unsigned int factors_size,
+                const unsigned int size, const unsigned int s,
+                const rta_real_t direction,
+                const rta_fft_simd_t * simd)
+{
+  unsigned int f;
+  unsigned int n = size;
+  unsigned int stride = s;
+
+  for(f=0; f<factors_size; f++)
+  {
+    const unsigned int p = factors[f];
+    rta_real_t * tmp;
+
+    if(p == 4 && simd != NULL && stride % simd->width == 0)
+    {
+      simd->stockham_4_pass(x, y, twiddles, n, stride, direction);
+    }
+    else
+    {
+      mixed_radix_pass(x, y, twiddles, n, stride, p, direction);
+    }
+    twiddles += 2 * (p - 1) * (n / p);
+    n /= p;
+    stride *= p;
+
+    /* ping-pong */
+    tmp = x;
+    x = y;
+    y = tmp;
+  }
+  return x;
+}
+
+/********************************************************************
+ * mixed radix FFT in natural order
+ *
+ *   buf ... 'size' complex points, with stride 'b_stride'
+ *   twiddles ... coefficients of all the passes
+ *   factors ... radix of each pass
+ *   scratch ... work buffer of 2 * 'size' complex points
+ *   size ... number of complex points
+ *   direction ... -1 for FFT and 1 for IFFT
+ *   simd ... vectorised kernels for the radix-4 passes, or NULL
+ */
+static void
+fft_mixed_radix_inplace(rta_complex_t * buf, const int b_stride,
+                        const rta_real_t * twiddles,
+                        const unsigned int * factors,
+                        const unsigned int factors_size,
+                        rta_real_t * scratch,
+                        const unsigned int size,
+                        const rta_real_t direction,
+                        const rta_fft_simd_t * simd)
+{
+  rta_real_t * x;
+  unsigned int i;
+
+  if(b_stride == 1)
+  {
+    x = (rta_real_t *) buf;
+  }
+  else
+  {
+    /* gather into the second half of the work buffer */
+    x = scratch + 2 * size;
+    for(i=0; i<size; i++)
+    {
+      x[2 * i] = rta_creal(buf[i * b_stride]);
+      x[2 * i + 1] = rta_cimag(buf[i * b_stride]);
+    }
+  }
+
+  x = stockham_passes(x, scratch, twiddles, factors, factors_size,
+                      size, 1, direction, simd);
+
+  if(b_stride == 1)
+  {
+    if(x != (rta_real_t *) buf)
+    {
+      for(i=0; i<2*size; i++)
+      {
+        ((rta_real_t *) buf)[i] = x[i];
+      }
+    }
+  }
+  else
+  {
+    for(i=0; i<size; i++)
+    {
+      buf[i * b_stride] = rta_make_complex(x[2 * i], x[2 * i + 1]);
+    }
+  }
+  return;
+}
+
+
+/* complex FFT of a power of 2 plan, in place, in natural order */
+static void
+fft_plan_inplace(rta_real_t * buf, const rta_fft_plan_t * fft_plan,
+                 const rta_real_t direction, const rta_fft_simd_t * simd)
+{
+  bitreversal_inplace((rta_complex_t *) buf, fft_plan->bitrev,
+                      fft_plan->complex_size);
+  fft_radix_4_inplace(buf, fft_plan->twiddles, fft_plan->complex_size,
+                      direction, simd);
+  return;
+}
+
+/********************************************************************
+ * four-step FFT of large power of 2 sizes
+ *
+ *   The 'size' = N1 * N2 points are seen as a matrix of N1 rows and
+ *   N2 columns. With n = N2 * n1 + n2 and k = k1 + N1 * k2:
+ *   1. N2 FFTs of N1 points on the columns, in place
+ *   2. multiplication by W^(n2 * k1), W = exp(direction * j*2*PI/N)
+ *   3. N1 FFTs of N2 points on the rows
+ *   4. transposition to the output, in natural order
+ *   Each small FFT stays in cache, where the direct FFT would sweep
+ *   the whole buffer at each pass. The columns (and the rows) are
+ *   gathered by blocks of RTA_FFT_FOUR_STEP_BLOCK, so that each
+ *   access to the buffer reads or writes whole cache lines. The
+ *   blocks are independent tasks, run by the threads of a pool.
+ *
+ *   buf ... 'size' complex points, with stride 'b_stride'
+ *   scratch ... work buffer of 'size' complex points, plus
+ *     RTA_FFT_FOUR_STEP_BLOCK * N2 complex points for each thread
+ *   direction ... -1 for FFT and 1 for IFFT
+ *   simd ... vectorised kernels, or NULL for scalar code only
+ *   thread_pool ... worker threads, or NULL
+ */
+typedef struct
+{
+  rta_complex_t * buf;
+  int b_stride;
+  const rta_fft_plan_t * fft_plan;
+  rta_complex_t * out;     /* transposed result */
+  rta_complex_t * work;    /* blocks of rows or columns, for each thread */
+  rta_real_t direction;
+  const rta_fft_simd_t * simd;
+} four_step_t;
+
+/* 1. and 2. for a block of columns */
+static void
+four_step_columns(void * data, const unsigned int task,
+                  const unsigned int thread)
+{
+  const four_step_t * f = (const four_step_t *) data;
+  const unsigned int block = RTA_FFT_FOUR_STEP_BLOCK;
+  const unsigned int n1 = f->fft_plan->columns_size;
+  const unsigned int n2 = f->fft_plan->rows_size;
+  const unsigned int i0 = task * block;
+  rta_complex_t * work = f->work + thread * block * n2;
+  unsigned int i, b, k;
+
+  /* N1 and N2 are multiples of the block size */
+  for(i=0; i<n1; i++)
+  {
+    const rta_complex_t * x = f->buf + (i * n2 + i0) * f->b_stride;
+
+    for(b=0; b<block; b++)
+    {
+      work[b * n1 + i] = x[b * f->b_stride];
+    }
+  }
+
+  for(b=0; b<block; b++)
+  {
+    rta_real_t * column = (rta_real_t *) (work + b * n1);
+    const rta_real_t * w = f->fft_plan->four_step + 2 * (i0 + b) * n1;
+
+    fft_plan_inplace(column, f->fft_plan->columns, f->direction, f->simd);
+
+    for(k=0; k<2*n1; k+=2)
+    {
+      const rta_real_t re = column[k];
+      const rta_real_t im = column[k + 1];
+      fft_store_twiddled(column + k, re, im, w[k], f->direction * w[k + 1]);
+    }
+  }
+
+  for(i=0; i<n1; i++)
+  {
+    rta_complex_t * x = f->buf + (i * n2 + i0) * f->b_stride;
+
+    for(b=0; b<block; b++)
+    {
+      x[b * f->b_stride] = work[b * n1 + i];
+    }
+  }
+  return;
+}
+
+/* 3. and 4. for a block of rows */
+static void
+four_step_rows(void * data, const unsigned int task,
+               const unsigned int thread)
+{
+  const four_step_t * f = (const four_step_t *) data;
+  const unsigned int block = RTA_FFT_FOUR_STEP_BLOCK;
+  const unsigned int n1 = f->fft_plan->columns_size;
+  const unsigned int n2 = f->fft_plan->rows_size;
+  const unsigned int i0 = task * block;
+  rta_complex_t * work = f->work + thread * block * n2;
+  unsigned int b, k;
+
+  for(b=0; b<block; b++)
+  {
+    const rta_complex_t * x = f->buf + (i0 + b) * n2 * f->b_stride;
+    rta_complex_t * row = work + b * n2;
+
+    for(k=0; k<n2; k++)
+    {
+      row[k] = x[k * f->b_stride];
+    }
+
+    fft_plan_inplace((rta_real_t *) row, f->fft_plan->rows,
+                     f->direction, f->simd);
+  }
+
+  for(k=0; k<n2; k++)
+  {
+    rta_complex_t * o = f->out + k * n1 + i0;
+
+    for(b=0; b<block; b++)
+    {
+      o[b] = work[b * n2 + k];
+    }
+  }
+  return;
+}
+
+/* copy of RTA_FFT_FOUR_STEP_BLOCK rows of N1 points of the result */
+static void
+four_step_copy(void * data, const unsigned int task,
+               const unsigned int thread)
+{
+  const four_step_t * f = (const four_step_t *) data;
+  const unsigned int block_size =
+    RTA_FFT_FOUR_STEP_BLOCK * f->fft_plan->columns_size;
+  const unsigned int i0 = task * block_size;
+  unsigned int i;
+
+  (void) thread; /* no scratch memory needed for the copy */
+
+  for(i=i0; i<i0+block_size; i++)
+  {
+    f->buf[i * f->b_stride] = f->out[i];
+  }
+  return;
+}
+
+static void
+fft_four_step_inplace(rta_complex_t * buf, const int b_stride,
+                      const rta_fft_plan_t * fft_plan,
+                      rta_real_t * scratch,
+                      const rta_real_t direction,
+                      const rta_fft_simd_t * simd,
+                      rta_thread_pool_t * thread_pool)
+{
+  const unsigned int block = RTA_FFT_FOUR_STEP_BLOCK;
+  four_step_t f;
+
+  f.buf = buf;
+  f.b_stride = b_stride;
+  f.fft_plan = fft_plan;
+  f.out = (rta_complex_t *) scratch;
+  f.work = f.out + fft_plan->columns_size * fft_plan->rows_size;
+  f.direction = direction;
+  f.simd = simd;
+
+  rta_thread_pool_run(thread_pool, four_step_columns, &f,
+                      fft_plan->rows_size / block);
+  rta_thread_pool_run(thread_pool, four_step_rows, &f,
+                      fft_plan->columns_size / block);
+  rta_thread_pool_run(thread_pool, four_step_copy, &f,
+                      fft_plan->rows_size / block);
+  return;
+}
 
 /* from rfft_shuffle_after_fft_inplc */
 /**************************************************************************
@@ -494,15 +1243,26 @@ static void
 shuffle_after_real_fft_inplace(rta_complex_t * buf, 
                                const rta_real_t * coef_real,
                                const rta_real_t * coef_imag,
-                               const int size)
+                               const int size,
+                               const rta_fft_simd_t * simd)
 {
   int idx, xdi;
   
   /* nyquist point coded in imaginary part first point  */
   buf[0] = rta_make_complex(rta_creal(buf[0]) + rta_cimag(buf[0]), rta_creal(buf[0]) - rta_cimag(buf[0]));
     
+  /* vectorised part, scalar code for the remaining points */
+  if(simd != NULL)
+  {
+    idx = simd->shuffle_after_real_fft(
+      (rta_real_t *) buf, coef_real, coef_imag, size);
+  }
+  else
+  {
+    idx = 1;
+  }
   
-  for(idx=1, xdi=size-1; idx<size/2; idx++, xdi--)
+  for(xdi=size-idx; idx<xdi; idx++, xdi--)
   {
     rta_real_t x1_real = 0.5*(rta_creal(buf[idx]) + rta_creal(buf[xdi]));
     rta_real_t x1_imag = 0.5*(rta_cimag(buf[idx]) - rta_cimag(buf[xdi]));
@@ -520,7 +1280,11 @@ shuffle_after_real_fft_inplace(rta_complex_t * buf,
     buf[xdi] = rta_make_complex(x1_real - x2Ej_real, x2Ej_imag - x1_imag);
   }
   
-  buf[idx] = rta_conj(buf[idx]);
+  /* middle point for even sizes */
+  if(idx == xdi)
+  {
+    buf[idx] = rta_conj(buf[idx]);
+  }
   return;
 }
 
@@ -538,7 +1302,7 @@ shuffle_after_real_fft_inplace_stride(rta_complex_t * buf,
   buf[0] = rta_make_complex(rta_creal(buf[0]) + rta_cimag(buf[0]), rta_creal(buf[0]) - rta_cimag(buf[0]));
     
   for(idx=1, idx_s=b_stride, xdi_s=(size-1)*b_stride;
-      idx<size/2;
+      idx<size-idx;
       idx++, idx_s+=b_stride, xdi_s-=b_stride)
   {
     rta_real_t x1_real = 0.5*(rta_creal(buf[idx_s]) + rta_creal(buf[xdi_s]));
@@ -557,7 +1321,11 @@ shuffle_after_real_fft_inplace_stride(rta_complex_t * buf,
     buf[xdi_s] = rta_make_complex(x1_real - x2Ej_real, x2Ej_imag - x1_imag);
   }
   
-  buf[idx_s] = rta_conj(buf[idx_s]);
+  /* middle point for even sizes */
+  if(2 * idx == size)
+  {
+    buf[idx_s] = rta_conj(buf[idx_s]);
+  }
   return;
 }
 
@@ -566,14 +1334,26 @@ static void
 shuffle_before_real_inverse_fft_inplace(rta_complex_t * buf,
                                         const rta_real_t *coef_real,
                                         const rta_real_t *coef_imag,
-                                        const int size)
+                                        const int size,
+                                        const rta_fft_simd_t * simd)
 {
   int idx, xdi;
   
   /* nyquist point coded in imaginary part of the first point */
   buf[0] = rta_make_complex(rta_creal(buf[0]) + rta_cimag(buf[0]), rta_creal(buf[0]) - rta_cimag(buf[0]));
 
-  for(idx=1, xdi=size-1; idx<size/2; idx++, xdi--)
+  /* vectorised part, scalar code for the remaining points */
+  if(simd != NULL)
+  {
+    idx = simd->shuffle_before_real_inverse_fft(
+      (rta_real_t *) buf, coef_real, coef_imag, size);
+  }
+  else
+  {
+    idx = 1;
+  }
+
+  for(xdi=size-idx; idx<xdi; idx++, xdi--)
   {
     rta_real_t x1_real = rta_creal(buf[idx]) + rta_creal(buf[xdi]);
     rta_real_t x1_imag = rta_cimag(buf[idx]) - rta_cimag(buf[xdi]);
@@ -594,7 +1374,11 @@ shuffle_before_real_inverse_fft_inplace(rta_complex_t * buf,
     buf[xdi] = rta_make_complex(x1_real + x2_imag, x2_real - x1_imag);
 
   }
-  buf[idx] = rta_mul_complex_real(rta_conj(buf[idx]), 2);
+  /* middle point for even sizes */
+  if(idx == xdi)
+  {
+    buf[idx] = rta_mul_complex_real(rta_conj(buf[idx]), 2);
+  }
   return;
 }
 
@@ -612,7 +1396,7 @@ shuffle_before_real_inverse_fft_inplace_stride(rta_complex_t * buf,
   buf[0] = rta_make_complex(rta_creal(buf[0]) + rta_cimag(buf[0]), rta_creal(buf[0]) - rta_cimag(buf[0]));
 
   for(idx=1, idx_s=b_stride, xdi_s=(size-1)*b_stride;
-      idx<size/2;
+      idx<size-idx;
       idx++, idx_s+=b_stride, xdi_s-=b_stride)
   {
     rta_real_t x1_real = rta_creal(buf[idx_s]) + rta_creal(buf[xdi_s]);
@@ -634,8 +1418,12 @@ shuffle_before_real_inverse_fft_inplace_stride(rta_complex_t * buf,
     buf[xdi_s] = rta_make_complex(x1_real + x2_imag, x2_real - x1_imag);
 
   }
-  buf[idx_s] = rta_mul_complex_real(rta_conj(buf[idx_s]), 2);
-  return;
+  /* middle point for even sizes */
+  if(2 * idx == size)
+  {
+    buf[idx_s] = rta_mul_complex_real(rta_conj(buf[idx_s]), 2);
+  }
+  return;
 }
 
 
@@ -962,6 +1750,38 @@ scale_real_zero_pad_in_place_stride(
   return;
 }
 
+/* Strided real values are 'b_stride' reals apart, while the complex */
+/* transform needs pairs of contiguous reals, 'b_stride' complex values */
+/* apart: real 2i stays in place, real 2i+1 moves next to it. */
+/* (2i+1)*b_stride never equals 2j*b_stride+1 for b_stride > 1, */
+/* so the order of the moves does not matter. */
+static void
+pack_real_stride(rta_real_t * buf, const int b_stride,
+                 const unsigned int size)
+{
+  unsigned int i;
+
+  for(i=0; i<size*b_stride; i+=2*b_stride)
+  {
+    buf[i+1] = buf[i+b_stride];
+  }
+  return;
+}
+
+/* inverse of pack_real_stride */
+static void
+unpack_real_stride(rta_real_t * buf, const int b_stride,
+                   const unsigned int size)
+{
+  unsigned int i;
+
+  for(i=0; i<size*b_stride; i+=2*b_stride)
+  {
+    buf[i+b_stride] = buf[i+1];
+  }
+  return;
+}
+
 
 static void
 scale_complex_zero_pad_in_place(rta_complex_t * buf, const unsigned int output_size,
@@ -1040,279 +1860,903 @@ scale_complex_zero_pad_in_place_stride(
 
 
 
-/* sine, cosine and bitreverse tables */
-/* retrun 1 on success, 0 on fail */
+/* mixed radix decomposition of 'size' into passes of radix 4, 2, 3, */
+/* 5 and 7 (see routine: fft_mixed_radix_inplace()) */
+/* return the number of factors, 0 if 'size' has other prime factors */
+static unsigned int
+factors_new(unsigned int * factors, unsigned int size)
+{
+  const unsigned int radix[] = {4, 2, 3, 5, 7};
+  unsigned int factors_size = 0;
+  unsigned int r;
+
+  for(r=0; r<sizeof(radix)/sizeof(radix[0]); r++)
+  {
+    while(size > 1 && size % radix[r] == 0 &&
+          factors_size < RTA_FFT_FACTORS_MAX)
+    {
+      factors[factors_size++] = radix[r];
+      size /= radix[r];
+    }
+  }
+
+  if(size != 1)
+  {
+    factors_size = 0;
+  }
+
+  return factors_size;
+}
+
+/* radix-4 coefficients, contiguous for each pass */
+/* (see routine: fft_radix_4_inplace()) */
+/* return 1 on success, 0 on fail */
 static int
-tables_new(rta_fft_setup_t * fft_setup)
+twiddles_new(rta_fft_plan_t * fft_plan)
 {
   int ret = 0;
-  /* sine (and cosine) table */
 
-  /* 1/4 more for cosine as phase shift and one more point at the end */
-  /* => total size is 5/4*sine_size + 1 */
-  fft_setup->sin = (rta_real_t *) rta_malloc(
-    sizeof(rta_real_t) * (fft_setup->fft_size * 5/4 + 1));
+  const unsigned int size = fft_plan->complex_size;
+
+  /* first radix-4 pass after a radix-2 one if log2(size) is odd */
+  const unsigned int first_up = (rta_ilog2(size) & 1) ? 2 : 1;
+  unsigned int up;
+  unsigned int twiddles_size = 0;
 
-  if(fft_setup->sin != NULL)
+  for(up=first_up; up<size; up<<=2)
   {
-    /* sine function from 0 to 2pi, inclusive (plus 1/4 for cosine) */
-    /* step = 5/4 * 2 pi / (5/4 * size) = 2 * pi / size */
-    const rta_real_t step = 2. * M_PI / fft_setup->fft_size;
-    unsigned int i;
-    for(i=0; i<=fft_setup->fft_size * 5/4; i++)
-    {
-      fft_setup->sin[i] = rta_sin(i*step);
-    }
+    twiddles_size += 6 * up; /* W, W^2 and W^3 */
+  }
 
-    /* cosine function is just a phase-shifted sine */
-    /* Memory is shared */
-    fft_setup->cos = fft_setup->sin + (fft_setup->fft_size / 4);
+  fft_plan->twiddles = (rta_real_t *) rta_malloc(
+    sizeof(rta_real_t) * (twiddles_size > 0 ? twiddles_size : 1));
 
-    /* Bit reversal table */
-    fft_setup->bitrev = (unsigned int *) rta_malloc(
-      sizeof(unsigned int) * fft_setup->fft_size);
+  if(fft_plan->twiddles != NULL)
+  {
+    rta_real_t * twiddles = fft_plan->twiddles;
 
-    if(fft_setup->bitrev != NULL)
+    for(up=first_up; up<size; up<<=2)
     {
-      unsigned int idx, xdi;
-      unsigned int i, j;
-          
-      for(i=0; i<fft_setup->fft_size; i++)
+      /* exp(j*2*PI*k*n/(4*up)) from the (oversampled) tables */
+      const unsigned int down = fft_plan->fft_size / (4 * up);
+      unsigned int j, k;
+
+      for(k=1; k<=3; k++)
       {
-        idx = i;
-        xdi = 0;
-    
-        for(j=1; j<fft_setup->log2_size; j++)
+        for(j=0; j<up; j++)
         {
-          xdi += (idx & 1);
-          xdi <<= 1;
-          idx >>= 1;
+          *twiddles++ = fft_plan->cos[k * j * down];
+          *twiddles++ = fft_plan->sin[k * j * down];
         }
-    
-        fft_setup->bitrev[i] = xdi + (idx & 1);
       }
-        
-      ret = 1; /* setup complete */
     }
-    else /* bitrev failed */
-      rta_free(fft_setup->sin);
+    ret = 1;
   }
-  /* else: sin failed */
-  
+
   return ret;
 }
 
-/* ------- end of private ---------------------------- */
-
-/* ------- Public functions -------------------------- */
-
-int
-rta_fft_real_setup_new(rta_fft_setup_t ** fft_setup,
-                       const rta_fft_t fft_type, rta_real_t * scale,
-                       void * input, const unsigned int input_size,
-                       void * output, const unsigned int fft_size,
-                       rta_real_t * nyquist)
-/* FFTW uses input and output to plan executions */
+/* mixed radix coefficients, contiguous for each pass */
+/* (see routine: mixed_radix_pass()) */
+/* return the allocated coefficients, NULL on fail */
+static rta_real_t *
+mixed_radix_twiddles_new(const unsigned int * factors,
+                         const unsigned int factors_size,
+                         const unsigned int size)
 {
-  int ret = 0;
+  rta_real_t * ret;
+  unsigned int twiddles_size = 0;
+  unsigned int f, n;
 
-  *fft_setup = (rta_fft_setup_t *) rta_malloc(sizeof(rta_fft_setup_t));
-
-  if(*fft_setup != NULL)
+  for(f=0, n=size; f<factors_size; n/=factors[f], f++)
   {
-    /* actual FFT size is the next power of 2 of the given argument */
-    (*fft_setup)->fft_size = rta_inextpow2(fft_size);
-    (*fft_setup)->log2_size = rta_ilog2((*fft_setup)->fft_size);
-    (*fft_setup)->input_size = input_size;
-
-    (*fft_setup)->output = output;
-    (*fft_setup)->o_stride = 1;
+    twiddles_size += 2 * (factors[f] - 1) * (n / factors[f]);
+  }
 
-    (*fft_setup)->input = input;
-    (*fft_setup)->i_stride = 1;
+  ret = (rta_real_t *) rta_malloc(
+    sizeof(rta_real_t) * (twiddles_size > 0 ? twiddles_size : 1));
 
-    (*fft_setup)->nyquist = nyquist;
+  if(ret != NULL)
+  {
+    rta_real_t * twiddles = ret;
 
-    (*fft_setup)->scale = scale;
-    (*fft_setup)->fft_type = fft_type;
-    
-    ret = tables_new(*fft_setup);
-    if(ret == 0)
+    for(f=0, n=size; f<factors_size; n/=factors[f], f++)
     {
-      rta_free(*fft_setup);
-      *fft_setup = NULL;
+      /* W^k = exp(j*2*PI*k*i/n), k = 1..p-1, i = 0..n/p-1 */
+      const unsigned int p = factors[f];
+      unsigned int i, k;
+
+      for(i=0; i<n/p; i++)
+      {
+        for(k=1; k<p; k++)
+        {
+          const double phase = 2. * M_PI * (double) (k * i) / n;
+          *twiddles++ = rta_cos(phase);
+          *twiddles++ = rta_sin(phase);
+        }
+      }
     }
   }
 
   return ret;
 }
 
-int
-rta_fft_real_setup_new_stride(
-  rta_fft_setup_t ** fft_setup,
-  const rta_fft_t fft_type, rta_real_t * scale,
-  void * input, const int i_stride, const unsigned int input_size,
-  void * output, const int o_stride, const unsigned int fft_size,
-  rta_real_t * nyquist)
-/* FFTW uses input and output to plan executions */
+/* mixed radix coefficients of the plan */
+/* return 1 on success, 0 on fail */
+static int
+mixed_radix_tables_new(rta_fft_plan_t * fft_plan)
+{
+  fft_plan->twiddles = mixed_radix_twiddles_new(
+    fft_plan->factors, fft_plan->factors_size, fft_plan->complex_size);
+
+  return (fft_plan->twiddles != NULL);
+}
+
+/* sine, cosine and bitreverse tables */
+/* retrun 1 on success, 0 on fail */
+static int
+tables_new(rta_fft_plan_t * fft_plan)
 {
   int ret = 0;
+  const unsigned int size = fft_plan->complex_size;
 
-  *fft_setup = (rta_fft_setup_t *) rta_malloc(sizeof(rta_fft_setup_t));
+  fft_plan->bitrev = NULL;
+  fft_plan->twiddles = NULL;
 
-  if(fft_setup != NULL)
+  /* mixed radix for sizes that are not a power of 2 */
+  if((size & (size - 1)) != 0)
   {
-    /* actual FFT size is the next power of 2 of the given argument */
-    (*fft_setup)->fft_size = rta_inextpow2(fft_size);
-    (*fft_setup)->log2_size = rta_ilog2((*fft_setup)->fft_size);
-    (*fft_setup)->input_size = input_size;
+    fft_plan->factors_size = factors_new(fft_plan->factors, size);
+  }
+  else
+  {
+    fft_plan->factors_size = 0;
+  }
 
-    (*fft_setup)->output = output;
-    (*fft_setup)->o_stride = o_stride;
+  /* sine (and cosine) table */
+  if(fft_plan->fft_size % 4 == 0)
+  {
+    /* 1/4 more for cosine as phase shift and one more point at the end */
+    /* => total size is 5/4*sine_size + 1 */
+    fft_plan->sin = (rta_real_t *) rta_malloc(
+      sizeof(rta_real_t) * (fft_plan->fft_size * 5/4 + 1));
+    
+    if(fft_plan->sin != NULL)
+    {
+      /* sine function from 0 to 2pi, inclusive (plus 1/4 for cosine) */
+      /* step = 5/4 * 2 pi / (5/4 * size) = 2 * pi / size */
+      const rta_real_t step = 2. * M_PI / fft_plan->fft_size;
+      unsigned int i;
+      for(i=0; i<=fft_plan->fft_size * 5/4; i++)
+      {
+        fft_plan->sin[i] = rta_sin(i*step);
+      }
+      
+      /* cosine function is just a phase-shifted sine */
+      /* Memory is shared */
+      fft_plan->cos = fft_plan->sin + (fft_plan->fft_size / 4);
+    }
+  }
+  else
+  {
+    /* no exact phase shift: sine and cosine from 0 to 2pi, inclusive, */
+    /* in the same memory */
+    fft_plan->sin = (rta_real_t *) rta_malloc(
+      sizeof(rta_real_t) * 2 * (fft_plan->fft_size + 1));
 
-    (*fft_setup)->input = input;
-    (*fft_setup)->i_stride = i_stride;
+    if(fft_plan->sin != NULL)
+    {
+      const double step = 2. * M_PI / fft_plan->fft_size;
+      unsigned int i;
 
-    (*fft_setup)->nyquist = nyquist;
+      fft_plan->cos = fft_plan->sin + fft_plan->fft_size + 1;
+      for(i=0; i<=fft_plan->fft_size; i++)
+      {
+        fft_plan->sin[i] = rta_sin(i*step);
+        fft_plan->cos[i] = rta_cos(i*step);
+      }
+    }
+  }
 
-    (*fft_setup)->scale = scale;
-    (*fft_setup)->fft_type = fft_type;
-    
-    ret = tables_new(*fft_setup);
-    if(ret == 0)
+  if(fft_plan->sin != NULL)
+  {
+    if(fft_plan->factors_size > 0)
     {
-      rta_free(*fft_setup);
-      *fft_setup = NULL;
+      ret = mixed_radix_tables_new(fft_plan);
+      if(ret == 0) /* mixed radix tables failed */
+      {
+        rta_free(fft_plan->sin);
+      }
+    }
+    else
+    {
+      /* Bit reversal table */
+      fft_plan->bitrev = (unsigned int *) rta_malloc(
+        sizeof(unsigned int) * fft_plan->fft_size);
+      
+      if(fft_plan->bitrev != NULL)
+      {
+        unsigned int idx, xdi;
+        unsigned int i, j;
+        
+        for(i=0; i<fft_plan->fft_size; i++)
+        {
+          idx = i;
+          xdi = 0;
+          
+          for(j=1; j<fft_plan->log2_size; j++)
+          {
+            xdi += (idx & 1);
+            xdi <<= 1;
+            idx >>= 1;
+          }
+          
+          fft_plan->bitrev[i] = xdi + (idx & 1);
+        }
+        
+        ret = twiddles_new(fft_plan);
+        if(ret == 0) /* twiddles failed */
+        {
+          rta_free(fft_plan->bitrev);
+          rta_free(fft_plan->sin);
+        }
+      }
+      else /* bitrev failed */
+        rta_free(fft_plan->sin);
     }
   }
-
+  /* else: sin failed */
+  
   return ret;
 }
 
-int
-rta_fft_setup_new(rta_fft_setup_t ** fft_setup,
-                  const rta_fft_t fft_type, rta_real_t * scale,
-                  rta_complex_t * input, const unsigned int input_size,
-                  rta_complex_t * output, const unsigned int fft_size)
-/* FFTW uses input and output to plan executions */
+/* four-step sub-plans and coefficients of large power of 2 sizes */
+/* (see routine: fft_four_step_inplace()) */
+/* return 1 on success, 0 on fail */
+static int
+four_step_tables_new(rta_fft_plan_t * fft_plan)
 {
-  int ret = 0;
+  const unsigned int size = fft_plan->complex_size;
+  /* N1 <= N2, both as close as possible to sqrt(size) */
+  const unsigned int n1 = 1 << (rta_ilog2(size) / 2);
+  const unsigned int n2 = size / n1;
+  /* the cosine and sine tables may be oversampled (real transforms) */
+  const unsigned int down = fft_plan->fft_size / size;
+  rta_real_t * w;
 
-  *fft_setup = (rta_fft_setup_t *) rta_malloc(sizeof(rta_fft_setup_t));
+  fft_plan->columns_size = n1;
+  fft_plan->rows_size = n2;
 
-  if(*fft_setup != NULL)
+  w = (rta_real_t *) rta_malloc(sizeof(rta_real_t) * 2 * size);
+
+  if(w != NULL &&
+     rta_fft_plan_new(&fft_plan->columns, rta_fft_complex_1d, n1) != 0)
   {
-    /* actual FFT size is the next power of 2 of the given argument */
-    (*fft_setup)->fft_size = rta_inextpow2(fft_size);
-    (*fft_setup)->log2_size = rta_ilog2((*fft_setup)->fft_size);
-    (*fft_setup)->input_size = input_size;
+    if(rta_fft_plan_new(&fft_plan->rows, rta_fft_complex_1d, n2) != 0)
+    {
+      unsigned int r, k;
 
-    (*fft_setup)->output = (void *) output;
-    (*fft_setup)->o_stride = 1;
+      /* W^(r * k), W = exp(j*2*PI/size), r = 0..N2-1, k = 0..N1-1 */
+      fft_plan->four_step = w;
+      for(r=0; r<n2; r++)
+      {
+        for(k=0; k<n1; k++)
+        {
+          const unsigned int idx = ((r * k) & (size - 1)) * down;
+          *w++ = fft_plan->cos[idx];
+          *w++ = fft_plan->sin[idx];
+        }
+      }
+    }
+    else /* rows failed */
+    {
+      rta_fft_plan_delete(fft_plan->columns);
+      fft_plan->columns = NULL;
+    }
+  }
 
-    (*fft_setup)->input = (void *) input;
-    (*fft_setup)->i_stride = 1;
+  if(fft_plan->four_step == NULL && w != NULL)
+  {
+    rta_free(w);
+  }
 
-    (*fft_setup)->nyquist = NULL;
+  return (fft_plan->four_step != NULL);
+}
 
-    (*fft_setup)->scale = scale;
-    (*fft_setup)->fft_type = fft_type;
-    
-    ret = tables_new(*fft_setup);
-    if(ret == 0)
-    {
-      rta_free(*fft_setup);
-      *fft_setup = NULL;
-    }
+/* ------- end of private ---------------------------- */
+
+/* ------- Public functions -------------------------- */
+
+unsigned int
+rta_fft_size(const rta_fft_t fft_type, const unsigned int fft_size)
+{
+  unsigned int factors[RTA_FFT_FACTORS_MAX];
+  unsigned int ret;
+
+  switch(fft_type)
+  {
+    /* the real transforms use a complex FFT of half size */
+    case rta_fft_real_to_complex_1d:
+    case rta_fft_complex_to_real_1d:
+      if(fft_size > 2 && fft_size % 2 == 0 && factors_new(factors, fft_size / 2) > 0)
+      {
+        ret = fft_size;
+      }
+      else
+      {
+        ret = rta_inextpow2(fft_size);
+      }
+      break;
+      
+    default:
+      if(fft_size > 1 && factors_new(factors, fft_size) > 0)
+      {
+        ret = fft_size;
+      }
+      else
+      {
+        ret = rta_inextpow2(fft_size);
+      }
+      break;
   }
 
   return ret;
 }
 
 int
-rta_fft_setup_new_stride(
-  rta_fft_setup_t ** fft_setup,
-  const rta_fft_t fft_type, rta_real_t * scale,
-  rta_complex_t * input, const int i_stride, const unsigned int input_size,
-  rta_complex_t * output, const int o_stride, const unsigned int fft_size)
-/* FFTW uses input and output to plan executions */
+rta_fft_plan_new(rta_fft_plan_t ** fft_plan,
+                 const rta_fft_t fft_type, const unsigned int fft_size)
 {
   int ret = 0;
 
-  *fft_setup = (rta_fft_setup_t *) rta_malloc(sizeof(rta_fft_setup_t));
+  *fft_plan = (rta_fft_plan_t *) rta_malloc(sizeof(rta_fft_plan_t));
 
-  if(*fft_setup != NULL)
+  if(*fft_plan != NULL)
   {
-    /* actual FFT size is the next power of 2 of the given argument */
-    (*fft_setup)->fft_size = rta_inextpow2(fft_size);
-    (*fft_setup)->log2_size = rta_ilog2((*fft_setup)->fft_size);
-    (*fft_setup)->input_size = input_size;
+    /* actual FFT size is the given argument for mixed radix sizes, */
+    /* the next power of 2 otherwise */
+    (*fft_plan)->fft_size = rta_fft_size(fft_type, fft_size);
+    (*fft_plan)->log2_size = rta_ilog2((*fft_plan)->fft_size);
 
-    (*fft_setup)->output = (void *) output;
-    (*fft_setup)->o_stride = o_stride;
-
-    (*fft_setup)->input = (void *) input;
-    (*fft_setup)->i_stride = i_stride;
+    /* the real transforms use a complex FFT of half size */
+    (*fft_plan)->complex_size =
+      (fft_type == rta_fft_real_to_complex_1d ||
+       fft_type == rta_fft_complex_to_real_1d) ?
+      (*fft_plan)->fft_size >> 1 : (*fft_plan)->fft_size;
 
-    (*fft_setup)->nyquist = NULL;
+    (*fft_plan)->simd = rta_fft_simd_get();
+    (*fft_plan)->stockham = NULL;
+    (*fft_plan)->stockham_factors_size = 0;
+    (*fft_plan)->columns = NULL;
+    (*fft_plan)->rows = NULL;
+    (*fft_plan)->four_step = NULL;
+    (*fft_plan)->references = 0;
+    (*fft_plan)->next = NULL;
 
-    (*fft_setup)->scale = scale;
-    (*fft_setup)->fft_type = fft_type;
-    
-    ret = tables_new(*fft_setup);
+    ret = tables_new(*fft_plan);
     if(ret == 0)
     {
-      rta_free(*fft_setup);
-      *fft_setup = NULL;
+      rta_free(*fft_plan);
+      *fft_plan = NULL;
     }
   }
 
   return ret;
 }
 
-
 void
-rta_fft_setup_delete(rta_fft_setup_t * fft_setup)
+rta_fft_plan_delete(rta_fft_plan_t * fft_plan)
 {
-  if(fft_setup != NULL)
+  if(fft_plan != NULL)
   {
-    if(fft_setup->sin != NULL)
+    if(fft_plan->sin != NULL)
     {
-      rta_free(fft_setup->sin);
+      rta_free(fft_plan->sin);
     }
 
-    if(fft_setup->bitrev != NULL)
+    if(fft_plan->bitrev != NULL)
     {
-      rta_free(fft_setup->bitrev);
+      rta_free(fft_plan->bitrev);
     }
 
-    rta_free(fft_setup);
+    if(fft_plan->twiddles != NULL)
+    {
+      rta_free(fft_plan->twiddles);
+    }
+
+    if(fft_plan->stockham != NULL)
+    {
+      rta_free(fft_plan->stockham);
+    }
+
+    if(fft_plan->four_step != NULL)
+    {
+      rta_free(fft_plan->four_step);
+    }
+
+    rta_fft_plan_delete(fft_plan->columns);
+    rta_fft_plan_delete(fft_plan->rows);
+
+    rta_free(fft_plan);
   }
 
   return;
 }
 
+/* plans shared by the setups, see rta_fft_plan_acquire */
+static rta_fft_plan_t * plan_cache = NULL;
 
-void
-rta_fft_execute(void * output, void * input, const unsigned int input_size,
-                rta_fft_setup_t * fft_setup)
+#if defined(WIN32) || defined(_WIN32)
+static SRWLOCK plan_cache_lock = SRWLOCK_INIT;
+#define plan_cache_lock_acquire() AcquireSRWLockExclusive(&plan_cache_lock)
+#define plan_cache_lock_release() ReleaseSRWLockExclusive(&plan_cache_lock)
+#else
+static pthread_mutex_t plan_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#define plan_cache_lock_acquire() pthread_mutex_lock(&plan_cache_lock)
+#define plan_cache_lock_release() pthread_mutex_unlock(&plan_cache_lock)
+#endif
+
+int
+rta_fft_plan_acquire(rta_fft_plan_t ** fft_plan,
+                     const rta_fft_t fft_type, const unsigned int fft_size)
 {
-  const unsigned int no_stride = 
-    fft_setup->i_stride == 1 && fft_setup->o_stride == 1;
-  unsigned int spectrum_size = fft_setup->fft_size >> 1;
-  fft_setup->input = input;
-  fft_setup->output = output;
-  fft_setup->input_size = input_size;
+  int ret = 0;
+  const unsigned int size = rta_fft_size(fft_type, fft_size);
+  const unsigned int complex_size =
+    (fft_type == rta_fft_real_to_complex_1d ||
+     fft_type == rta_fft_complex_to_real_1d) ? size >> 1 : size;
+  rta_fft_plan_t * plan;
 
-  switch(fft_setup->fft_type)
+  plan_cache_lock_acquire();
+
+  for(plan = plan_cache; plan != NULL; plan = plan->next)
   {
-    case rta_fft_real_to_complex_1d:
+    if(plan->fft_size == size && plan->complex_size == complex_size)
     {
-      rta_real_t * real_input = (rta_real_t *) fft_setup->input;
-      rta_complex_t * complex_output = (rta_complex_t *) fft_setup->output;
+      break;
+    }
+  }
 
-      /* out of place transform */
-      if(fft_setup->input != fft_setup->output)
+  if(plan != NULL)
+  {
+    plan->references++;
+    ret = 1;
+  }
+  else
+  {
+    /* tables are computed under the lock, so that concurrent */
+    /* acquisitions of the same size do not compute them twice */
+    ret = rta_fft_plan_new(&plan, fft_type, size);
+    if(ret != 0)
+    {
+      plan->references = 1;
+      plan->next = plan_cache;
+      plan_cache = plan;
+    }
+  }
+
+  plan_cache_lock_release();
+
+  *fft_plan = (ret != 0) ? plan : NULL;
+  return ret;
+}
+
+void
+rta_fft_plan_release(rta_fft_plan_t * fft_plan)
+{
+  rta_fft_plan_t ** p;
+
+  if(fft_plan != NULL)
+  {
+    plan_cache_lock_acquire();
+
+    fft_plan->references--;
+    if(fft_plan->references == 0)
+    {
+      for(p = &plan_cache; *p != NULL; p = &(*p)->next)
+      {
+        if(*p == fft_plan)
+        {
+          *p = fft_plan->next;
+          break;
+        }
+      }
+    }
+    else
+    {
+      fft_plan = NULL;
+    }
+
+    plan_cache_lock_release();
+
+    /* last reference */
+    rta_fft_plan_delete(fft_plan);
+  }
+
+  return;
+}
+
+int
+rta_fft_setup_new_with_plan(rta_fft_setup_t ** fft_setup,
+                            rta_fft_plan_t * fft_plan,
+                            const rta_fft_t fft_type, rta_real_t * scale,
+                            void * input, const int i_stride,
+                            const unsigned int input_size,
+                            void * output, const int o_stride,
+                            rta_real_t * nyquist)
+{
+  int ret = 0;
+  const unsigned int real_type =
+    (fft_type == rta_fft_real_to_complex_1d ||
+     fft_type == rta_fft_complex_to_real_1d);
+
+  /* a real plan computes complex transforms of half size */
+  if(fft_plan->complex_size ==
+     (real_type ? fft_plan->fft_size >> 1 : fft_plan->fft_size))
+  {
+    *fft_setup = (rta_fft_setup_t *) rta_malloc(sizeof(rta_fft_setup_t));
+  }
+  else
+  {
+    *fft_setup = NULL;
+  }
+
+  if(*fft_setup != NULL)
+  {
+    (*fft_setup)->fft_size = fft_plan->fft_size;
+    (*fft_setup)->input_size = input_size;
+
+    (*fft_setup)->output = output;
+    (*fft_setup)->o_stride = o_stride;
+
+    (*fft_setup)->input = input;
+    (*fft_setup)->i_stride = i_stride;
+
+    (*fft_setup)->nyquist = nyquist;
+
+    (*fft_setup)->scale = scale;
+    (*fft_setup)->fft_type = fft_type;
+    (*fft_setup)->kernel = rta_fft_radix_4;
+
+    (*fft_setup)->plan = fft_plan;
+    (*fft_setup)->plan_owner = 0;
+    (*fft_setup)->thread_pool = NULL;
+    (*fft_setup)->batch = NULL;
+
+    if(fft_plan->factors_size > 0)
+    {
+      /* 2 * size complex points: ping-pong and strided data */
+      (*fft_setup)->scratch = (rta_real_t *) rta_malloc(
+        sizeof(rta_real_t) * 4 * fft_plan->complex_size);
+      ret = ((*fft_setup)->scratch != NULL);
+    }
+    else
+    {
+      (*fft_setup)->scratch = NULL;
+      ret = 1;
+    }
+
+    if(ret == 0)
+    {
+      rta_free(*fft_setup);
+      *fft_setup = NULL;
+    }
+  }
+
+  return ret;
+}
+
+/* setup with a cached plan */
+static int
+setup_new(rta_fft_setup_t ** fft_setup,
+          const rta_fft_t fft_type, rta_real_t * scale,
+          void * input, const int i_stride, const unsigned int input_size,
+          void * output, const int o_stride, const unsigned int fft_size,
+          rta_real_t * nyquist)
+{
+  int ret = 0;
+  rta_fft_plan_t * fft_plan;
+
+  if(rta_fft_plan_acquire(&fft_plan, fft_type, fft_size) != 0)
+  {
+    ret = rta_fft_setup_new_with_plan(fft_setup, fft_plan, fft_type, scale,
+                                      input, i_stride, input_size,
+                                      output, o_stride, nyquist);
+    if(ret != 0)
+    {
+      (*fft_setup)->plan_owner = 1;
+    }
+    else
+    {
+      rta_fft_plan_release(fft_plan);
+    }
+  }
+  else
+  {
+    *fft_setup = NULL;
+  }
+
+  return ret;
+}
+
+int
+rta_fft_real_setup_new(rta_fft_setup_t ** fft_setup,
+                       const rta_fft_t fft_type, rta_real_t * scale,
+                       void * input, const unsigned int input_size,
+                       void * output, const unsigned int fft_size,
+                       rta_real_t * nyquist)
+/* FFTW uses input and output to plan executions */
+{
+  return setup_new(fft_setup, fft_type, scale,
+                   input, 1, input_size,
+                   output, 1, fft_size,
+                   nyquist);
+}
+
+int
+rta_fft_real_setup_new_stride(
+  rta_fft_setup_t ** fft_setup,
+  const rta_fft_t fft_type, rta_real_t * scale,
+  void * input, const int i_stride, const unsigned int input_size,
+  void * output, const int o_stride, const unsigned int fft_size,
+  rta_real_t * nyquist)
+/* FFTW uses input and output to plan executions */
+{
+  return setup_new(fft_setup, fft_type, scale,
+                   input, i_stride, input_size,
+                   output, o_stride, fft_size,
+                   nyquist);
+}
+
+int
+rta_fft_setup_new(rta_fft_setup_t ** fft_setup,
+                  const rta_fft_t fft_type, rta_real_t * scale,
+                  rta_complex_t * input, const unsigned int input_size,
+                  rta_complex_t * output, const unsigned int fft_size)
+/* FFTW uses input and output to plan executions */
+{
+  return setup_new(fft_setup, fft_type, scale,
+                   (void *) input, 1, input_size,
+                   (void *) output, 1, fft_size,
+                   NULL);
+}
+
+int
+rta_fft_setup_new_stride(
+  rta_fft_setup_t ** fft_setup,
+  const rta_fft_t fft_type, rta_real_t * scale,
+  rta_complex_t * input, const int i_stride, const unsigned int input_size,
+  rta_complex_t * output, const int o_stride, const unsigned int fft_size)
+/* FFTW uses input and output to plan executions */
+{
+  return setup_new(fft_setup, fft_type, scale,
+                   (void *) input, i_stride, input_size,
+                   (void *) output, o_stride, fft_size,
+                   NULL);
+}
+
+
+/* Stockham tables of a power of 2 plan, shared by its setups */
+/* return 1 on success, 0 on fail */
+static int
+stockham_tables_acquire(rta_fft_plan_t * fft_plan)
+{
+  int ret;
+
+  /* the plan may be used concurrently by other setups */
+  plan_cache_lock_acquire();
+
+  if(fft_plan->stockham == NULL && fft_plan->factors_size == 0)
+  {
+    fft_plan->stockham_factors_size =
+      factors_new(fft_plan->stockham_factors, fft_plan->complex_size);
+    fft_plan->stockham = mixed_radix_twiddles_new(
+      fft_plan->stockham_factors, fft_plan->stockham_factors_size,
+      fft_plan->complex_size);
+  }
+  ret = (fft_plan->stockham != NULL || fft_plan->factors_size > 0);
+
+  plan_cache_lock_release();
+
+  return ret;
+}
+
+/* four-step tables of a large power of 2 plan, shared by its setups */
+/* return 1 on success, 0 on fail */
+static int
+four_step_tables_acquire(rta_fft_plan_t * fft_plan)
+{
+  int ret = 1;
+
+  /* the plan may be used concurrently by other setups */
+  plan_cache_lock_acquire();
+
+  if(fft_plan->four_step == NULL && fft_plan->factors_size == 0 &&
+     fft_plan->complex_size >= RTA_FFT_FOUR_STEP_SIZE)
+  {
+    ret = four_step_tables_new(fft_plan);
+  }
+
+  plan_cache_lock_release();
+
+  return ret;
+}
+
+int
+rta_fft_setup_set_kernel(rta_fft_setup_t * fft_setup,
+                         const rta_fft_kernel_t kernel)
+{
+  int ret = 0;
+
+  switch(kernel)
+  {
+    case rta_fft_radix_2:
+    case rta_fft_radix_4:
+      fft_setup->kernel = kernel;
+      ret = 1;
+      break;
+
+    case rta_fft_stockham:
+      if(fft_setup->scratch == NULL)
+      {
+        fft_setup->scratch = (rta_real_t *) rta_malloc(
+          sizeof(rta_real_t) * 4 * fft_setup->plan->complex_size);
+      }
+
+      ret = (fft_setup->scratch != NULL &&
+             stockham_tables_acquire(fft_setup->plan) != 0);
+      if(ret != 0)
+      {
+        fft_setup->kernel = kernel;
+      }
+      break;
+
+    case rta_fft_four_step:
+      if(fft_setup->scratch == NULL)
+      {
+        fft_setup->scratch = (rta_real_t *) rta_malloc(
+          sizeof(rta_real_t) * 4 * fft_setup->plan->complex_size);
+      }
+
+      ret = (fft_setup->scratch != NULL &&
+             four_step_tables_acquire(fft_setup->plan) != 0);
+      if(ret != 0)
+      {
+        fft_setup->kernel = kernel;
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  return ret;
+}
+
+int
+rta_fft_setup_set_threads(rta_fft_setup_t * fft_setup,
+                          const unsigned int threads)
+{
+  int ret = 1;
+  rta_fft_plan_t * fft_plan = fft_setup->plan;
+  rta_thread_pool_t * thread_pool = NULL;
+  rta_real_t * scratch = NULL;
+
+  if(threads > 1)
+  {
+    ret = four_step_tables_acquire(fft_plan);
+
+    /* only the four-step FFT uses the threads */
+    if(ret != 0 && fft_plan->four_step != NULL)
+    {
+      /* result, and a block of rows for each thread */
+      unsigned int scratch_size = 2 * (fft_plan->complex_size +
+        threads * RTA_FFT_FOUR_STEP_BLOCK * fft_plan->rows_size);
+
+      if(scratch_size < 4 * fft_plan->complex_size)
+      {
+        scratch_size = 4 * fft_plan->complex_size;
+      }
+
+      scratch = (rta_real_t *) rta_malloc(sizeof(rta_real_t) * scratch_size);
+      ret = (scratch != NULL &&
+             rta_thread_pool_new(&thread_pool, threads) != 0);
+
+      if(ret == 0 && scratch != NULL)
+      {
+        rta_free(scratch);
+      }
+    }
+  }
+
+  if(ret != 0)
+  {
+    rta_thread_pool_delete(fft_setup->thread_pool);
+    fft_setup->thread_pool = thread_pool;
+
+    if(scratch != NULL)
+    {
+      if(fft_setup->scratch != NULL)
+      {
+        rta_free(fft_setup->scratch);
+      }
+      fft_setup->scratch = scratch;
+    }
+  }
+
+  return ret;
+}
+
+void
+rta_fft_setup_delete(rta_fft_setup_t * fft_setup)
+{
+  if(fft_setup != NULL)
+  {
+    if(fft_setup->scratch != NULL)
+    {
+      rta_free(fft_setup->scratch);
+    }
+
+    if(fft_setup->batch != NULL)
+    {
+      rta_free(fft_setup->batch);
+    }
+
+    if(fft_setup->plan_owner != 0)
+    {
+      rta_fft_plan_release(fft_setup->plan);
+    }
+
+    rta_thread_pool_delete(fft_setup->thread_pool);
+
+    rta_free(fft_setup);
+  }
+
+  return;
+}
+
+
+void
+rta_fft_execute(void * output, void * input, const unsigned int input_size,
+                rta_fft_setup_t * fft_setup)
+{
+  const unsigned int no_stride = 
+    fft_setup->i_stride == 1 && fft_setup->o_stride == 1;
+  unsigned int spectrum_size = fft_setup->fft_size >> 1;
+  const rta_fft_plan_t * fft_plan = fft_setup->plan;
+  /* the former radix-2 kernel is kept free of vectorised code */
+  const rta_fft_simd_t * simd =
+    fft_setup->kernel != rta_fft_radix_2 ? fft_plan->simd : NULL;
+  /* natural order (Stockham) passes: mixed radix sizes, or power of */
+  /* 2 sizes without bit reversal */
+  const unsigned int * factors = fft_plan->factors;
+  unsigned int factors_size = fft_plan->factors_size;
+  const rta_real_t * twiddles = fft_plan->twiddles;
+  /* large power of 2 sizes, see fft_four_step_inplace() */
+  const unsigned int four_step = fft_plan->four_step != NULL &&
+    (fft_setup->kernel == rta_fft_four_step ||
+     (fft_setup->kernel == rta_fft_radix_4 && fft_setup->thread_pool != NULL));
+
+  if(factors_size == 0 && fft_setup->kernel == rta_fft_stockham)
+  {
+    factors = fft_plan->stockham_factors;
+    factors_size = fft_plan->stockham_factors_size;
+    twiddles = fft_plan->stockham;
+  }
+
+  fft_setup->input = input;
+  fft_setup->output = output;
+  fft_setup->input_size = input_size;
+
+  switch(fft_setup->fft_type)
+  {
+    case rta_fft_real_to_complex_1d:
+    {
+      rta_real_t * real_input = (rta_real_t *) fft_setup->input;
+      rta_complex_t * complex_output = (rta_complex_t *) fft_setup->output;
+
+      /* out of place transform */
+      if(fft_setup->input != fft_setup->output)
       {
         /* at this moment, the output buffer is real, as the input one */
         if(no_stride)
@@ -1348,33 +2792,83 @@ rta_fft_execute(void * output, void * input, const unsigned int input_size,
        }
       }
 
-      if(fft_setup->o_stride == 1)
+      if(fft_setup->o_stride != 1)
+      {
+        pack_real_stride(
+          (rta_real_t *) complex_output, fft_setup->o_stride,
+          fft_setup->fft_size);
+      }
+
+      if(factors_size > 0 || four_step)
+      {
+        if(four_step)
+        {
+          fft_four_step_inplace(
+            complex_output, fft_setup->o_stride, fft_plan,
+            fft_setup->scratch, -1., simd,
+            fft_setup->thread_pool);
+        }
+        else
+        {
+          fft_mixed_radix_inplace(
+            complex_output, fft_setup->o_stride, twiddles,
+            factors, factors_size, fft_setup->scratch,
+            spectrum_size, -1., simd);
+        }
+
+        if(fft_setup->o_stride == 1)
+        {
+          shuffle_after_real_fft_inplace(
+            complex_output, fft_plan->cos, fft_plan->sin, spectrum_size,
+            simd);
+        }
+        else
+        {
+          shuffle_after_real_fft_inplace_stride(
+            complex_output, fft_setup->o_stride,
+            fft_plan->cos, fft_plan->sin, spectrum_size);
+        }
+      }
+      else if(fft_setup->o_stride == 1)
       {
         bitreversal_oversampled_inplace(
-          complex_output, fft_setup->bitrev, spectrum_size);
+          complex_output, fft_plan->bitrev, spectrum_size);
         
-        fft_inplace_oversampled_coefficients(
-          complex_output, fft_setup->cos, fft_setup->sin, spectrum_size);
+        if(fft_setup->kernel != rta_fft_radix_2)
+        {
+          fft_radix_4_inplace(
+            (rta_real_t *) complex_output, fft_plan->twiddles,
+            spectrum_size, -1., simd);
+        }
+        else
+        {
+          fft_inplace_oversampled_coefficients(
+            complex_output, fft_plan->cos, fft_plan->sin, spectrum_size);
+        }
           
         shuffle_after_real_fft_inplace(
-          complex_output, fft_setup->cos, fft_setup->sin, spectrum_size);
+          complex_output, fft_plan->cos, fft_plan->sin, spectrum_size, simd);
       }
       else
       {
         bitreversal_oversampled_inplace_stride(
-          complex_output, fft_setup->o_stride, fft_setup->bitrev, spectrum_size);
+          complex_output, fft_setup->o_stride, fft_plan->bitrev, spectrum_size);
         
         fft_inplace_oversampled_coefficients_stride(
           complex_output, fft_setup->o_stride,
-          fft_setup->cos, fft_setup->sin, spectrum_size);
+          fft_plan->cos, fft_plan->sin, spectrum_size);
           
         shuffle_after_real_fft_inplace_stride(
           complex_output, fft_setup->o_stride,
-          fft_setup->cos, fft_setup->sin, spectrum_size);
+          fft_plan->cos, fft_plan->sin, spectrum_size);
 
       }
-      *(fft_setup->nyquist) = rta_cimag(complex_output[0]);
-      rta_set_complex_real(complex_output[0], rta_creal(complex_output[0]));
+      /* packed format: nyquist value left in the first imaginary value */
+      if(fft_setup->nyquist != NULL)
+      {
+        *(fft_setup->nyquist) = rta_cimag(complex_output[0]);
+        rta_set_complex_real(complex_output[0], rta_creal(complex_output[0]));
+      }
 
       break;
     }
@@ -1423,39 +2917,88 @@ rta_fft_execute(void * output, void * input, const unsigned int input_size,
       /* nyquist value is coded on the first imaginary value */
       /* there is no stride here: real and imaginary values of the */
       /* complex type must be contiguous */
-      if(*(fft_setup->scale) != 1.)
+      /* (packed format: it is already there, and scaled) */
+      if(fft_setup->nyquist != NULL)
       {
-        real_output[1] = *(fft_setup->nyquist) * *(fft_setup->scale);
+        if(*(fft_setup->scale) != 1.)
+        {
+          real_output[1] = *(fft_setup->nyquist) * *(fft_setup->scale);
+        }
+        else
+        {
+          real_output[1] = *(fft_setup->nyquist);
+        }
       }
-      else
+      
+      if(factors_size > 0 || four_step)
       {
-        real_output[1] = *(fft_setup->nyquist);
+        if(fft_setup->o_stride == 1)
+        {
+          shuffle_before_real_inverse_fft_inplace(
+            complex_output, fft_plan->cos, fft_plan->sin, spectrum_size,
+            simd);
+        }
+        else
+        {
+          shuffle_before_real_inverse_fft_inplace_stride(
+            complex_output, fft_setup->o_stride,
+            fft_plan->cos, fft_plan->sin, spectrum_size);
+        }
+
+        if(four_step)
+        {
+          fft_four_step_inplace(
+            complex_output, fft_setup->o_stride, fft_plan,
+            fft_setup->scratch, 1., simd,
+            fft_setup->thread_pool);
+        }
+        else
+        {
+          fft_mixed_radix_inplace(
+            complex_output, fft_setup->o_stride, twiddles,
+            factors, factors_size, fft_setup->scratch,
+            spectrum_size, 1., simd);
+        }
       }
-      
-      if(fft_setup->o_stride == 1)
+      else if(fft_setup->o_stride == 1)
       {
         shuffle_before_real_inverse_fft_inplace(
-          complex_output, fft_setup->cos, fft_setup->sin, spectrum_size);
+          complex_output, fft_plan->cos, fft_plan->sin, spectrum_size, simd);
         
         bitreversal_oversampled_inplace(
-          complex_output, fft_setup->bitrev, spectrum_size);
+          complex_output, fft_plan->bitrev, spectrum_size);
         
-        ifft_inplace_oversampled_coefficients(
-          complex_output, fft_setup->cos, fft_setup->sin, spectrum_size);
+        if(fft_setup->kernel != rta_fft_radix_2)
+        {
+          fft_radix_4_inplace(
+            (rta_real_t *) complex_output, fft_plan->twiddles,
+            spectrum_size, 1., simd);
+        }
+        else
+        {
+          ifft_inplace_oversampled_coefficients(
+            complex_output, fft_plan->cos, fft_plan->sin, spectrum_size);
+        }
       }
       else
       {
         shuffle_before_real_inverse_fft_inplace_stride(
           complex_output, fft_setup->o_stride,
-          fft_setup->cos, fft_setup->sin, spectrum_size);
+          fft_plan->cos, fft_plan->sin, spectrum_size);
         
         bitreversal_oversampled_inplace_stride(
           complex_output, fft_setup->o_stride,
-          fft_setup->bitrev, spectrum_size);
+          fft_plan->bitrev, spectrum_size);
         
         ifft_inplace_oversampled_coefficients_stride(
           complex_output, fft_setup->o_stride,
-          fft_setup->cos, fft_setup->sin, spectrum_size);        
+          fft_plan->cos, fft_plan->sin, spectrum_size);        
+      }
+
+      if(fft_setup->o_stride != 1)
+      {
+        unpack_real_stride(real_output, fft_setup->o_stride,
+                           fft_setup->fft_size);
       }
 
       break;
@@ -1501,19 +3044,43 @@ rta_fft_execute(void * output, void * input, const unsigned int input_size,
        }
       }
       
-      if(fft_setup->o_stride == 1)
+      if(factors_size > 0)
       {
-        bitreversal_inplace(complex_output, fft_setup->bitrev, fft_setup->fft_size);
+        fft_mixed_radix_inplace(
+          complex_output, fft_setup->o_stride, twiddles,
+          factors, factors_size, fft_setup->scratch,
+          fft_setup->fft_size, -1., simd);
+      }
+      else if(four_step)
+      {
+        fft_four_step_inplace(
+          complex_output, fft_setup->o_stride, fft_plan,
+          fft_setup->scratch, -1., simd,
+          fft_setup->thread_pool);
+      }
+      else if(fft_setup->o_stride == 1)
+      {
+        bitreversal_inplace(complex_output, fft_plan->bitrev, fft_setup->fft_size);
 
-        fft_inplace(complex_output, fft_setup->cos, fft_setup->sin, fft_setup->fft_size);
+        if(fft_setup->kernel != rta_fft_radix_2)
+        {
+          fft_radix_4_inplace(
+            (rta_real_t *) complex_output, fft_plan->twiddles,
+            fft_setup->fft_size, -1., simd);
+        }
+        else
+        {
+          fft_inplace(complex_output, fft_plan->cos, fft_plan->sin,
+                      fft_setup->fft_size);
+        }
       }
       else
       {
         bitreversal_inplace_stride(complex_output, fft_setup->o_stride,
-          fft_setup->bitrev, fft_setup->fft_size);
+          fft_plan->bitrev, fft_setup->fft_size);
 
         fft_inplace_stride(complex_output, fft_setup->o_stride,
-                           fft_setup->cos, fft_setup->sin, fft_setup->fft_size);
+                           fft_plan->cos, fft_plan->sin, fft_setup->fft_size);
       }
 
       break;
@@ -1559,20 +3126,43 @@ rta_fft_execute(void * output, void * input, const unsigned int input_size,
         }
       }
 
-      if(fft_setup->o_stride == 1)
+      if(factors_size > 0)
+      {
+        fft_mixed_radix_inplace(
+          complex_output, fft_setup->o_stride, twiddles,
+          factors, factors_size, fft_setup->scratch,
+          fft_setup->fft_size, 1., simd);
+      }
+      else if(four_step)
+      {
+        fft_four_step_inplace(
+          complex_output, fft_setup->o_stride, fft_plan,
+          fft_setup->scratch, 1., simd,
+          fft_setup->thread_pool);
+      }
+      else if(fft_setup->o_stride == 1)
       {
         bitreversal_inplace(
-          complex_output, fft_setup->bitrev, fft_setup->fft_size);
+          complex_output, fft_plan->bitrev, fft_setup->fft_size);
 
-        ifft_inplace(
-          complex_output, fft_setup->cos, fft_setup->sin, fft_setup->fft_size);
+        if(fft_setup->kernel != rta_fft_radix_2)
+        {
+          fft_radix_4_inplace(
+            (rta_real_t *) complex_output, fft_plan->twiddles,
+            fft_setup->fft_size, 1., simd);
+        }
+        else
+        {
+          ifft_inplace(
+            complex_output, fft_plan->cos, fft_plan->sin, fft_setup->fft_size);
+        }
       }
       else
       {
         bitreversal_inplace_stride(complex_output, fft_setup->o_stride,
-                                   fft_setup->bitrev, fft_setup->fft_size);
+                                   fft_plan->bitrev, fft_setup->fft_size);
         ifft_inplace_stride(complex_output, fft_setup->o_stride, 
-                            fft_setup->cos, fft_setup->sin, fft_setup->fft_size);
+                            fft_plan->cos, fft_plan->sin, fft_setup->fft_size);
       }
       
       break;
@@ -1593,3 +3183,286 @@ rta_fft_real_execute(void * output, void * input, const unsigned int input_size,
   rta_fft_execute(output, input, input_size, fft_setup);
   return;    
 }
+
+/* size in bytes of the input and output values */
+static void
+frame_value_sizes(const rta_fft_t fft_type,
+                  size_t * input_value_size, size_t * output_value_size)
+{
+  *input_value_size = (fft_type == rta_fft_real_to_complex_1d) ?
+    sizeof(rta_real_t) : sizeof(rta_complex_t);
+  *output_value_size = (fft_type == rta_fft_complex_to_real_1d) ?
+    sizeof(rta_real_t) : sizeof(rta_complex_t);
+  return;
+}
+
+/* frames of a batch transformed by tiles, the remaining ones are */
+/* transformed one by one (see routine: execute_batch()) */
+static unsigned int
+batch_tiled_frames(rta_fft_setup_t * fft_setup, const unsigned int frames)
+{
+  rta_fft_plan_t * fft_plan = fft_setup->plan;
+
+  /* small and medium sizes only, where the cost of each execution */
+  /* is not negligible; the radix-2 kernel stays the frame by frame */
+  /* reference */
+  if(frames < RTA_FFT_BATCH_TILE ||
+     fft_plan->complex_size > RTA_FFT_BATCH_SIZE_MAX ||
+     fft_setup->i_stride != 1 || fft_setup->o_stride != 1 ||
+     fft_setup->kernel == rta_fft_radix_2)
+  {
+    return 0;
+  }
+
+  /* coefficients and work buffer on the first batch */
+  if(stockham_tables_acquire(fft_plan) == 0)
+  {
+    return 0;
+  }
+
+  if(fft_setup->batch == NULL)
+  {
+    /* 2 * RTA_FFT_BATCH_TILE * size complex points: ping-pong */
+    fft_setup->batch = (rta_real_t *) rta_malloc(
+      sizeof(rta_real_t) * 4 * RTA_FFT_BATCH_TILE * fft_plan->complex_size);
+    if(fft_setup->batch == NULL)
+    {
+      return 0;
+    }
+  }
+
+  return frames - frames % RTA_FFT_BATCH_TILE;
+}
+
+/* copy the 'used' first real values of a frame, scaled and zero */
+/* padded to 'size' complex points, to the column 't' of a tile */
+static void
+tile_fill_scale_zero_pad(rta_real_t * tile, const unsigned int t,
+                         const rta_real_t * input, const unsigned int used,
+                         const unsigned int size, const rta_real_t scale)
+{
+  rta_real_t * x = tile + 2 * t;
+  unsigned int i = 0;
+
+  for(; 2 * i + 1 < used; i++)
+  {
+    x[2 * RTA_FFT_BATCH_TILE * i] = input[2 * i] * scale;
+    x[2 * RTA_FFT_BATCH_TILE * i + 1] = input[2 * i + 1] * scale;
+  }
+
+  if(2 * i < used)
+  {
+    x[2 * RTA_FFT_BATCH_TILE * i] = input[2 * i] * scale;
+    x[2 * RTA_FFT_BATCH_TILE * i + 1] = 0.0;
+    i++;
+  }
+
+  /* zero padding */
+  for(; i < size; i++)
+  {
+    x[2 * RTA_FFT_BATCH_TILE * i] = 0.0;
+    x[2 * RTA_FFT_BATCH_TILE * i + 1] = 0.0;
+  }
+  return;
+}
+
+/********************************************************************
+ * FFT of a tile of frames
+ *
+ *   The RTA_FFT_BATCH_TILE frames are interleaved point by point:
+ *   the point i of the frame t is at i * RTA_FFT_BATCH_TILE + t. The
+ *   Stockham passes then see RTA_FFT_BATCH_TILE interleaved sequences,
+ *   and each butterfly is computed for all the frames at once, with
+ *   the same coefficients: the vectorised radix-4 passes apply from
+ *   the first one, whatever the size. The real transforms are
+ *   shuffled frame by frame, before or after the complex FFT.
+ *
+ *   output, input ... first frame of the tile
+ *   o_frame_stride, i_frame_stride ... in bytes
+ *   nyquist ... first Nyquist value of the tile, or NULL
+ *   nyquist_stride ... between the Nyquist values of the frames
+ */
+static void
+fft_batch_tile(char * output, const size_t o_frame_stride,
+               char * input, const size_t i_frame_stride,
+               const unsigned int input_size,
+               const rta_fft_setup_t * fft_setup,
+               rta_real_t * nyquist, const unsigned int nyquist_stride)
+{
+  const rta_fft_plan_t * fft_plan = fft_setup->plan;
+  const rta_fft_simd_t * simd = fft_plan->simd;
+  const unsigned int size = fft_plan->complex_size;
+  const unsigned int * factors = fft_plan->factors;
+  unsigned int factors_size = fft_plan->factors_size;
+  const rta_real_t * twiddles = fft_plan->twiddles;
+  const rta_real_t scale = *(fft_setup->scale);
+  rta_real_t * x = fft_setup->batch;
+  rta_real_t * y = fft_setup->batch + 2 * RTA_FFT_BATCH_TILE * size;
+  rta_real_t direction = -1.;
+  unsigned int t, i;
+
+  if(factors_size == 0)
+  {
+    factors = fft_plan->stockham_factors;
+    factors_size = fft_plan->stockham_factors_size;
+    twiddles = fft_plan->stockham;
+  }
+
+  switch(fft_setup->fft_type)
+  {
+    case rta_fft_real_to_complex_1d:
+    {
+      const unsigned int used = (input_size < fft_setup->fft_size) ?
+        input_size : fft_setup->fft_size;
+
+      for(t=0; t<RTA_FFT_BATCH_TILE; t++)
+      {
+        tile_fill_scale_zero_pad(
+          x, t, (rta_real_t *) (input + t * i_frame_stride), used,
+          size, scale);
+      }
+      break;
+    }
+
+    case rta_fft_complex_to_real_1d:
+    {
+      /* shuffled in the work buffer, before the passes */
+      rta_complex_t * frame = (rta_complex_t *) y;
+
+      for(t=0; t<RTA_FFT_BATCH_TILE; t++)
+      {
+        fill_complex_scale_zero_pad(
+          frame, size, (rta_complex_t *) (input + t * i_frame_stride),
+          input_size, scale);
+
+        /* nyquist value is coded on the first imaginary value */
+        if(nyquist != NULL)
+        {
+          ((rta_real_t *) frame)[1] = nyquist[t * nyquist_stride] * scale;
+        }
+
+        shuffle_before_real_inverse_fft_inplace(
+          frame, fft_plan->cos, fft_plan->sin, size, simd);
+        tile_fill_scale_zero_pad(x, t, y, 2 * size, size, 1.);
+      }
+      direction = 1.;
+      break;
+    }
+
+    default:
+    {
+      const unsigned int used = (input_size < size) ? input_size : size;
+
+      for(t=0; t<RTA_FFT_BATCH_TILE; t++)
+      {
+        tile_fill_scale_zero_pad(
+          x, t, (rta_real_t *) (input + t * i_frame_stride), 2 * used,
+          size, scale);
+      }
+
+      if(fft_setup->fft_type == rta_fft_complex_inverse_1d)
+      {
+        direction = 1.;
+      }
+      break;
+    }
+  }
+
+  x = stockham_passes(x, y, twiddles, factors, factors_size,
+                      size, RTA_FFT_BATCH_TILE, direction, simd);
+
+  for(t=0; t<RTA_FFT_BATCH_TILE; t++)
+  {
+    rta_real_t * frame_output = (rta_real_t *) (output + t * o_frame_stride);
+
+    for(i=0; i<size; i++)
+    {
+      frame_output[2 * i] = x[2 * (i * RTA_FFT_BATCH_TILE + t)];
+      frame_output[2 * i + 1] = x[2 * (i * RTA_FFT_BATCH_TILE + t) + 1];
+    }
+
+    if(fft_setup->fft_type == rta_fft_real_to_complex_1d)
+    {
+      rta_complex_t * spectrum = (rta_complex_t *) frame_output;
+
+      shuffle_after_real_fft_inplace(
+        spectrum, fft_plan->cos, fft_plan->sin, size, simd);
+
+      /* packed format: nyquist value left in the first imaginary value */
+      if(nyquist != NULL)
+      {
+        nyquist[t * nyquist_stride] = rta_cimag(spectrum[0]);
+        rta_set_complex_real(spectrum[0], rta_creal(spectrum[0]));
+      }
+    }
+  }
+  return;
+}
+
+/* frames of a batch by tiles, then one by one */
+static void
+execute_batch(void * output, const unsigned int o_frame_stride,
+              void * input, const unsigned int i_frame_stride,
+              const unsigned int input_size,
+              rta_fft_setup_t * fft_setup,
+              rta_real_t * nyquist, const unsigned int nyquist_stride,
+              const unsigned int frames)
+{
+  const unsigned int tiled_frames = batch_tiled_frames(fft_setup, frames);
+  rta_real_t * setup_nyquist = fft_setup->nyquist;
+  size_t input_value_size, output_value_size;
+  size_t o_bytes, i_bytes;
+  unsigned int f;
+
+  frame_value_sizes(fft_setup->fft_type,
+                    &input_value_size, &output_value_size);
+  o_bytes = (size_t) o_frame_stride * output_value_size;
+  i_bytes = (size_t) i_frame_stride * input_value_size;
+
+  /* same setup, tables and kernels for every frame */
+  for(f=0; f<tiled_frames; f+=RTA_FFT_BATCH_TILE)
+  {
+    fft_batch_tile(
+      (char *) output + f * o_bytes, o_bytes,
+      (char *) input + f * i_bytes, i_bytes, input_size, fft_setup,
+      (nyquist != NULL) ? nyquist + f * nyquist_stride : NULL,
+      nyquist_stride);
+  }
+
+  for(; f<frames; f++)
+  {
+    fft_setup->nyquist =
+      (nyquist != NULL) ? nyquist + f * nyquist_stride : NULL;
+    rta_fft_execute(
+      (char *) output + f * o_bytes, (char *) input + f * i_bytes,
+      input_size, fft_setup);
+  }
+  fft_setup->nyquist = setup_nyquist;
+  return;
+}
+
+void
+rta_fft_execute_batch(void * output, const unsigned int o_frame_stride,
+                      void * input, const unsigned int i_frame_stride,
+                      const unsigned int input_size,
+                      rta_fft_setup_t * fft_setup,
+                      const unsigned int frames)
+{
+  /* the same nyquist value of the setup for every frame */
+  execute_batch(output, o_frame_stride, input, i_frame_stride, input_size,
+                fft_setup, fft_setup->nyquist, 0, frames);
+  return;
+}
+
+void
+rta_fft_real_execute_batch(void * output, const unsigned int o_frame_stride,
+                           void * input, const unsigned int i_frame_stride,
+                           const unsigned int input_size,
+                           rta_fft_setup_t * fft_setup,
+                           rta_real_t * nyquist,
+                           const unsigned int frames)
+{
+  execute_batch(output, o_frame_stride, input, i_frame_stride, input_size,
+                fft_setup, nyquist, 1, frames);
+  return;
+}
@@ -58,18 +58,46 @@ typedef enum
   rta_fft_complex_inverse_1d = 4  /**< complex to complex inverse transform*/
 } rta_fft_t;
 
+typedef enum
+{
+  rta_fft_radix_2 = 0, /**< FTS radix-2 butterflies */
+  rta_fft_radix_4 = 1, /**< radix-4 butterflies (default) */
+  rta_fft_stockham = 2, /**< Stockham autosort, without bit reversal */
+  rta_fft_four_step = 3 /**< cache blocked, for very large sizes */
+} rta_fft_kernel_t;
+
 /* rta_fft_setup is private (depends on implementation) */
 typedef struct rta_fft_setup rta_fft_setup_t;
 
+/* rta_fft_plan is private (depends on implementation) */
+typedef struct rta_fft_plan rta_fft_plan_t;
+
+/**
+ * Actual FFT size used by the setup functions.
+ *
+ * Sizes with prime factors 2, 3, 5 and 7 only (like 960 or 1500
+ * points for 20 ms at 48 kHz and 75 kHz) are computed without
+ * padding, by a mixed radix FFT. The real transforms need an even
+ * size. Any other size is rounded to the next (or equal) power of 2.
+ *
+ * @param fft_type is the planned transform
+ * @param fft_size is the requested FFT size
+ *
+ * @return the size of the transform, to allocate the buffers
+ */
+unsigned int
+rta_fft_size(const rta_fft_t fft_type, const unsigned int fft_size);
+
 
 /**
  * Allocate and initialize an FFT setup for real to complex or complex
  * to real transform, according to the planned processes.
  *
- * The internal implementation always uses an FFT size of the next (or
- * equal) power of 2 of the given 'fft_size'. If the 'input_size is
- * smaller than the actual FFT size, it is zero-padded. The use of
- * external libraries may differ.
+ * The internal implementation uses the given 'fft_size' when it is a
+ * product of 2, 3, 5 and 7 (mixed radix, it must also be even for
+ * real transforms), and the next power of 2 otherwise (see
+ * rta_fft_size). If the 'input_size is smaller than the actual FFT
+ * size, it is zero-padded. The use of external libraries may differ.
  *
  * Processing can be in place if 'input' == 'output'. Any real input
  * data must be written as real (static cast).
@@ -97,7 +125,8 @@ typedef struct rta_fft_setup rta_fft_setup_t;
  * It may be used to determine a proper setup (FFTW) and its content
  * may be affected.
  * @param fft_size must be >= 'input_size'
- * @param nyquist is the last coefficient for real transforms
+ * @param nyquist is the last coefficient for real transforms (NULL
+ * for the packed format, see rta_fft_real_execute)
  *
  * @return 1 on success 0 on fail. If it fails, nothing should be done
  * with 'fft_setup' (even a delete).
@@ -113,14 +142,19 @@ rta_fft_real_setup_new(rta_fft_setup_t ** fft_setup,
  * Allocate and initialize an FFT setup for real to complex or complex
  * to real transform, according to the planned processes.
  *
- * The internal implementation always uses an FFT size of the next (or
- * equal) power of 2 of the given 'fft_size'. If the 'input_size is
- * smaller than the actual FFT size, it is zero-padded. The use of
- * external libraries may differ.
+ * The internal implementation uses the given 'fft_size' when it is a
+ * product of 2, 3, 5 and 7 (mixed radix, it must also be even for
+ * real transforms), and the next power of 2 otherwise (see
+ * rta_fft_size). If the 'input_size is smaller than the actual FFT
+ * size, it is zero-padded. The use of external libraries may differ.
  *
  * Processing can be in place if 'input' == 'output'. Any real input
  * data must be written as real (static cast), using 'o_stride'.
  *
+ * Strides count values of the array type: real values are 'stride'
+ * rta_real_t apart, complex values are 'stride' rta_complex_t apart
+ * (with contiguous real and imaginary parts).
+ *
  * For an out of place transform, 'input' and 'output' must not
  * overlap and 'i_stride' and 'o_stride' must be equal.
  *
@@ -146,7 +180,8 @@ rta_fft_real_setup_new(rta_fft_setup_t ** fft_setup,
  * may be affected.
  * @param o_stride is 'output' stride
  * @param fft_size must be >= 'input_size'
- * @param nyquist is the last coefficient for real transforms
+ * @param nyquist is the last coefficient for real transforms (NULL
+ * for the packed format, see rta_fft_real_execute)
  *
  * @return 1 on success 0 on fail. If it fails, nothing should be done
  * with 'fft_setup' (even a delete).
@@ -163,10 +198,11 @@ rta_fft_real_setup_new_stride(
  * Allocate and initialize an FFT setup for complex transform, direct
  * or inverse, according to the planned processes.
  *
- * The internal implementation always uses an FFT size of the next (or
- * equal) power of 2 of the given 'fft_size'. If the 'input_size is
- * smaller than the actual FFT size, it is zero-padded. The use of
- * external libraries may differ.
+ * The internal implementation uses the given 'fft_size' when it is a
+ * product of 2, 3, 5 and 7 (mixed radix, it must also be even for
+ * real transforms), and the next power of 2 otherwise (see
+ * rta_fft_size). If the 'input_size is smaller than the actual FFT
+ * size, it is zero-padded. The use of external libraries may differ.
  *
  * Processing can be in place if 'input' == 'output'. Any real input
  * data must be written as complex (real and imaginary values must be
@@ -207,10 +243,11 @@ rta_fft_setup_new(rta_fft_setup_t ** fft_setup,
  * Allocate and initialize an FFT setup for complex transform, direct
  * or inverse, according to the planned processes.
  *
- * The internal implementation always uses an FFT size of the next (or
- * equal) power of 2 of the given 'fft_size'. If the 'input_size is
- * smaller than the actual FFT size, it is zero-padded. The use of
- * external libraries may differ.
+ * The internal implementation uses the given 'fft_size' when it is a
+ * product of 2, 3, 5 and 7 (mixed radix, it must also be even for
+ * real transforms), and the next power of 2 otherwise (see
+ * rta_fft_size). If the 'input_size is smaller than the actual FFT
+ * size, it is zero-padded. The use of external libraries may differ.
  *
  * Processing can be in place if 'input' == 'output'. (real and
  * imaginary values must be contiguous no matter the strides).
@@ -250,6 +287,192 @@ rta_fft_setup_new_stride(
   rta_complex_t * input, const int i_stride, const unsigned int input_size,
   rta_complex_t * output, const int o_stride, const unsigned int fft_size);
 
+/**
+ * Allocate and initialize an FFT plan: the read-only tables
+ * (coefficients, bit reversal, mixed radix factors) of a transform
+ * size.
+ *
+ * A plan can be shared by many setups, including setups used
+ * concurrently by different threads, as the execution only reads
+ * it. Each thread needs its own setup (see
+ * rta_fft_setup_new_with_plan), as a setup holds the buffers of the
+ * transforms.
+ *
+ * \see rta_fft_plan_delete
+ * \see rta_fft_setup_new_with_plan
+ *
+ * @param fft_plan is an address of a pointer to a private structure,
+ * which may depend on the actual FFT implementation. This function
+ * allocates 'fft_plan' and fills it.
+ * @param fft_type may be any type: a plan for real_to_complex_1d
+ * serves complex_to_real_1d too, and a plan for rta_fft_complex_1d
+ * serves rta_fft_complex_inverse_1d too.
+ * @param fft_size is the requested FFT size (see rta_fft_size)
+ *
+ * @return 1 on success 0 on fail. If it fails, nothing should be done
+ * with 'fft_plan' (even a delete).
+ */
+int
+rta_fft_plan_new(rta_fft_plan_t ** fft_plan,
+                 const rta_fft_t fft_type, const unsigned int fft_size);
+
+/**
+ * Deallocate any FFT plan created by rta_fft_plan_new (not by
+ * rta_fft_plan_acquire). No setup created with this plan may be used
+ * after.
+ *
+ * \see rta_fft_plan_new
+ *
+ * @param fft_plan is a pointer to the memory wich will be released.
+ */
+void
+rta_fft_plan_delete(rta_fft_plan_t * fft_plan);
+
+/**
+ * Get a plan from the global cache, shared by all the callers that
+ * request the same transform size and kind (real or complex). The
+ * tables are computed by the first acquisition only, and they are
+ * deallocated when the last acquisition is released.
+ *
+ * The cache is thread-safe: plans may be acquired and released
+ * concurrently. rta_fft_setup_new and its variants use this cache.
+ *
+ * \see rta_fft_plan_release
+ * \see rta_fft_setup_new_with_plan
+ *
+ * @param fft_plan is an address of a pointer to a private structure,
+ * which is set to the shared plan. It must not be modified nor
+ * deleted with rta_fft_plan_delete.
+ * @param fft_type may be any type (see rta_fft_plan_new)
+ * @param fft_size is the requested FFT size (see rta_fft_size)
+ *
+ * @return 1 on success 0 on fail. If it fails, nothing should be done
+ * with 'fft_plan' (even a release).
+ */
+int
+rta_fft_plan_acquire(rta_fft_plan_t ** fft_plan,
+                     const rta_fft_t fft_type, const unsigned int fft_size);
+
+/**
+ * Release a plan obtained by rta_fft_plan_acquire. Each acquisition
+ * must be released once. No setup created with this plan may be used
+ * after.
+ *
+ * \see rta_fft_plan_acquire
+ *
+ * @param fft_plan is a pointer to the shared plan
+ */
+void
+rta_fft_plan_release(rta_fft_plan_t * fft_plan);
+
+/**
+ * Allocate and initialize a lightweight FFT setup using an existing
+ * plan, for real or complex transforms, according to the planned
+ * processes. Only the execution state is allocated (buffers, strides,
+ * scale, work buffer for mixed radix sizes).
+ *
+ * The FFT size is the one of the plan. The plan must outlive the
+ * setup, and rta_fft_setup_delete does not delete it.
+ *
+ * \see rta_fft_plan_new
+ * \see rta_fft_setup_delete
+ * \see rta_fft_real_setup_new_stride
+ *
+ * @param fft_setup is an address of a pointer to a private structure,
+ * which may depend on the actual FFT implementation. This function
+ * allocates 'fft_setup' and fills it.
+ * @param fft_plan is a plan created with a compatible 'fft_type'
+ * (real or complex)
+ * @param fft_type may be any type
+ * @param scale is the scale applied to the input (see
+ * rta_fft_setup_new)
+ * @param input can be an array of rta_real_t or rta_complex_t,
+ * depending on 'fft_type'.
+ * @param i_stride is 'input' stride
+ * @param input_size must be <= the FFT size
+ * @param output can be an array of rta_real_t or rta_complex_t,
+ * depending on 'fft_type'.
+ * @param o_stride is 'output' stride
+ * @param nyquist is the last coefficient for real transforms (NULL
+ * for complex ones)
+ *
+ * @return 1 on success 0 on fail (or if 'fft_type' does not match the
+ * plan). If it fails, nothing should be done with 'fft_setup' (even a
+ * delete).
+ */
+int
+rta_fft_setup_new_with_plan(rta_fft_setup_t ** fft_setup,
+                            rta_fft_plan_t * fft_plan,
+                            const rta_fft_t fft_type, rta_real_t * scale,
+                            void * input, const int i_stride,
+                            const unsigned int input_size,
+                            void * output, const int o_stride,
+                            rta_real_t * nyquist);
+
+/**
+ * Select the FFT kernel of a setup. Every setup uses the radix-4
+ * kernel by default, which computes the same transform as the
+ * radix-2 one with fewer multiplications and fewer passes over the
+ * buffer. It applies to non-strided power of 2 transforms only
+ * (mixed radix sizes always use their own kernel).
+ *
+ * The Stockham kernel computes power of 2 transforms in natural
+ * order, with the mixed radix passes: it avoids the bit reversal
+ * permutation, which scatters over the whole buffer, at the cost of a
+ * work buffer of twice the FFT size. It is worth it for large sizes
+ * (typically 64k points and more), and it applies to strided
+ * transforms too. Its coefficients are computed once per plan, on
+ * the first selection.
+ *
+ * The four-step kernel splits power of 2 transforms of 2^17 points
+ * and more (complex points, of the complex FFT inside the real
+ * transforms) into small FFTs on the columns then on the rows of a
+ * matrix, which stay in cache, and transposes the result. Smaller
+ * sizes use the radix-4 kernel. It is worth it when the buffer does
+ * not fit in the last level cache, and its blocks of rows and columns
+ * can be split across threads (see rta_fft_setup_set_threads). It
+ * needs a work buffer of twice the FFT size, and coefficients of the
+ * FFT size, computed once per plan on the first selection.
+ *
+ * \see rta_fft_setup_new
+ *
+ * @param fft_setup is a pointer to a private structure, which may
+ * depend on the actual FFT implementation.
+ * @param kernel is rta_fft_radix_2, rta_fft_radix_4, rta_fft_stockham
+ * or rta_fft_four_step
+ *
+ * @return 1 on success 0 on fail (unknown kernel or memory
+ * allocation failure). If it fails, 'fft_setup' is unchanged.
+ */
+int
+rta_fft_setup_set_kernel(rta_fft_setup_t * fft_setup,
+                         const rta_fft_kernel_t kernel);
+
+/**
+ * Split the execution of large transforms of a setup across a pool of
+ * worker threads. The power of 2 transforms of 2^17 complex points
+ * and more then use the four-step kernel (unless the radix-2 or
+ * Stockham kernel is selected), whose blocks of rows and columns are
+ * run by the threads. Smaller transforms use the calling thread only.
+ *
+ * The threads wait for the next execution between transforms, until
+ * the setup is deleted or the number of threads changes. The setup
+ * must still be executed by one thread at a time.
+ *
+ * \see rta_fft_setup_set_kernel
+ *
+ * @param fft_setup is a pointer to a private structure, which may
+ * depend on the actual FFT implementation.
+ * @param threads is the number of threads, including the calling one:
+ * 0 or 1 stops the worker threads.
+ *
+ * @return 1 on success 0 on fail (memory allocation or threads
+ * creation failure). If it fails, 'fft_setup' is unchanged.
+ */
+int
+rta_fft_setup_set_threads(rta_fft_setup_t * fft_setup,
+                          const unsigned int threads);
+
 /**
  * Deallocate any (sucessfully) allocated FFT setup.
  *
@@ -302,12 +525,106 @@ void rta_fft_execute(void * output, void * input, const unsigned int input_size,
  * depend on the actual FFT implementation.
  * @param nyquist is the address of the real transform value at the
  * Nyquist frequency (for direct and inverse real transforms).
+ *
+ * A real transform of 'fft_size' points is computed by a complex
+ * transform of 'fft_size' / 2 points, and its spectrum is the
+ * 'fft_size' / 2 complex values from the DC to the Nyquist frequency
+ * excluded. The real values at DC and Nyquist frequency are given by
+ * the real part of the first value and by 'nyquist'.
+ *
+ * If 'nyquist' is NULL, the packed format is used instead: the
+ * Nyquist value is the imaginary part of the first value (which is
+ * always 0). A direct transform leaves it there, and an inverse
+ * transform reads it from there, so that a spectrum can be passed
+ * back without any reformatting.
  */
 void
 rta_fft_real_execute(void * output, void * input, const unsigned int input_size,
                      rta_fft_setup_t * fft_setup,
                      rta_real_t * nyquist);
 
+/**
+ * Compute the FFT of many frames according to an FFT setup, as
+ * rta_fft_execute does for each frame. The setup and its tables are
+ * shared by all the frames of the batch, for offline analysis of
+ * whole files.
+ *
+ * Small transforms (up to 256 complex points in single precision, 64
+ * in double precision, including the complex FFT of half the size
+ * inside the real transforms) of non-strided setups are computed by
+ * tiles of 8 frames, interleaved point by point, so that each pass
+ * of the FFT runs on the frames of a tile at once, with vectorised
+ * butterflies whatever the size. The remaining frames, the larger or
+ * strided transforms and the radix-2 kernel are computed frame by
+ * frame. The first tiled batch of a setup allocates its work buffer
+ * of twice the tile, released with the setup, and the results only
+ * differ by rounding from a frame by frame execution.
+ *
+ * \see rta_fft_execute
+ *
+ * @param output is the first output frame. It can be an array of
+ * rta_real_t or rta_complex_t, depending on 'fft_type'.
+ * @param o_frame_stride is the distance between the beginnings of two
+ * consecutive output frames, as a number of output values
+ * (rta_real_t or rta_complex_t).
+ * @param input is the first input frame. It can be an array of
+ * rta_real_t or rta_complex_t, depending on 'fft_type'.
+ * @param i_frame_stride is the distance between the beginnings of two
+ * consecutive input frames, as a number of input values
+ * (rta_real_t or rta_complex_t).
+ * @param input_size is used to perform zero padding of each frame.
+ * @param fft_setup is a pointer to a private structure, which may
+ * depend on the actual FFT implementation.
+ * @param frames is the number of frames to transform
+ */
+void
+rta_fft_execute_batch(void * output, const unsigned int o_frame_stride,
+                      void * input, const unsigned int i_frame_stride,
+                      const unsigned int input_size,
+                      rta_fft_setup_t * fft_setup,
+                      const unsigned int frames);
+
+/**
+ * Compute the real FFT (direct or inverse) of many frames according
+ * to an FFT setup, as rta_fft_real_execute does for each frame.
+ *
+ * For example, the spectra of 'frames' contiguous frames of 'fft_size'
+ * samples are given by (with 'fft_size' / 2 complex values per
+ * spectrum):
+ *
+ *   rta_fft_real_execute_batch(spectra, fft_size / 2,
+ *                              samples, fft_size, fft_size,
+ *                              fft_setup, nyquists, frames);
+ *
+ * \see rta_fft_real_execute
+ * \see rta_fft_execute_batch
+ *
+ * @param output is the first output frame. It can be an array of
+ * rta_real_t or rta_complex_t, depending on 'fft_type'.
+ * @param o_frame_stride is the distance between the beginnings of two
+ * consecutive output frames, as a number of output values
+ * (rta_real_t or rta_complex_t).
+ * @param input is the first input frame. It can be an array of
+ * rta_real_t or rta_complex_t, depending on 'fft_type'.
+ * @param i_frame_stride is the distance between the beginnings of two
+ * consecutive input frames, as a number of input values
+ * (rta_real_t or rta_complex_t).
+ * @param input_size is used to perform zero padding of each frame.
+ * @param fft_setup is a pointer to a private structure, which may
+ * depend on the actual FFT implementation.
+ * @param nyquist is an array of 'frames' values at the Nyquist
+ * frequency (output for direct transforms, input for inverse ones),
+ * or NULL for the packed format.
+ * @param frames is the number of frames to transform
+ */
+void
+rta_fft_real_execute_batch(void * output, const unsigned int o_frame_stride,
+                           void * input, const unsigned int i_frame_stride,
+                           const unsigned int input_size,
+                           rta_fft_setup_t * fft_setup,
+                           rta_real_t * nyquist,
+                           const unsigned int frames);
+
 #ifdef __cplusplus
 }
 #endif
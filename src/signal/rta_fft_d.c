@@ -0,0 +1,57 @@
+/**
+ * @file   rta_fft_d.c
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_signal
+ *
+ * @brief  double precision Fast Fourier Transform
+ *
+ * Instance of rta_fft.c and rta_fftsimd.c for double values, whatever
+ * the configured rta_real_t, with the rta_fft_d_ prefix.
+ *
+ * \see rta_fft_typed.h
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rta.h" /* configuration, before the precision is overridden */
+
+#undef RTA_REAL_TYPE
+#define RTA_REAL_TYPE RTA_DOUBLE_TYPE
+#undef RTA_COMPLEX_TYPE
+#define RTA_COMPLEX_TYPE RTA_DOUBLE_TYPE
+#undef rta_real_t
+#define rta_real_t double
+
+#define RTA_FFT_NAME(name) rta_fft_d_ ## name
+#include "rta_fftintern.h" /* renamed symbols */
+
+#include "rta_fft.c"
+#include "rta_fftsimd.c"
@@ -0,0 +1,243 @@
+/**
+ * @file   rta_fft_typed.h
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_signal
+ *
+ * @brief  single and double precision Fast Fourier Transform
+ *
+ * The functions of rta_fft.h, for float values (rta_fft_f_ prefix)
+ * and for double values (rta_fft_d_ prefix), whatever the configured
+ * rta_real_t. Both can be used in the same program, for instance
+ * single precision for real-time processing and double precision for
+ * an offline analysis.
+ *
+ * Each function behaves as the one of rta_fft.h without the 'f_' or
+ * 'd_' infix, with float or double instead of rta_real_t. Setups and
+ * plans of a precision must be used with the functions of the same
+ * precision only. Each precision has its own vectorised kernels and
+ * its own plan cache.
+ *
+ * \see rta_fft.h
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _RTA_FFT_TYPED_H_
+#define _RTA_FFT_TYPED_H_ 1
+
+#include "rta_fft.h" /* transform types and kernels */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* setups and plans are private (depend on implementation) */
+typedef struct rta_fft_f_setup rta_fft_f_setup_t;
+typedef struct rta_fft_f_plan rta_fft_f_plan_t;
+typedef struct rta_fft_d_setup rta_fft_d_setup_t;
+typedef struct rta_fft_d_plan rta_fft_d_plan_t;
+
+/* complex values, with contiguous real and imaginary parts */
+#ifdef WIN32
+typedef struct floatcomplex_ rta_fft_f_complex_t;
+typedef struct complex_ rta_fft_d_complex_t;
+#else
+typedef float complex rta_fft_f_complex_t;
+typedef double complex rta_fft_d_complex_t;
+#endif
+
+/** @name Single precision, see rta_fft.h */
+/** @{ */
+
+int
+rta_fft_f_real_setup_new(rta_fft_f_setup_t ** fft_setup,
+                         rta_fft_t fft_type, float * scale,
+                         void * input, const unsigned int input_size,
+                         void * output, const unsigned int fft_size,
+                         float * nyquist);
+int
+rta_fft_f_real_setup_new_stride(
+  rta_fft_f_setup_t ** fft_setup,
+  rta_fft_t fft_type, float * scale,
+  void * input, const int i_stride, const unsigned int input_size,
+  void * output, const int o_stride, const unsigned int fft_size,
+  float * nyquist);
+int
+rta_fft_f_setup_new(rta_fft_f_setup_t ** fft_setup,
+                    rta_fft_t fft_type, float * scale,
+                    rta_fft_f_complex_t * input, const unsigned int input_size,
+                    rta_fft_f_complex_t * output, const unsigned int fft_size);
+int
+rta_fft_f_setup_new_stride(
+  rta_fft_f_setup_t ** fft_setup,
+  rta_fft_t fft_type, float * scale,
+  rta_fft_f_complex_t * input, const int i_stride,
+  const unsigned int input_size,
+  rta_fft_f_complex_t * output, const int o_stride,
+  const unsigned int fft_size);
+int
+rta_fft_f_plan_new(rta_fft_f_plan_t ** fft_plan,
+                   const rta_fft_t fft_type, const unsigned int fft_size);
+void
+rta_fft_f_plan_delete(rta_fft_f_plan_t * fft_plan);
+int
+rta_fft_f_plan_acquire(rta_fft_f_plan_t ** fft_plan,
+                       const rta_fft_t fft_type, const unsigned int fft_size);
+void
+rta_fft_f_plan_release(rta_fft_f_plan_t * fft_plan);
+int
+rta_fft_f_setup_new_with_plan(rta_fft_f_setup_t ** fft_setup,
+                              rta_fft_f_plan_t * fft_plan,
+                              const rta_fft_t fft_type, float * scale,
+                              void * input, const int i_stride,
+                              const unsigned int input_size,
+                              void * output, const int o_stride,
+                              float * nyquist);
+int
+rta_fft_f_setup_set_kernel(rta_fft_f_setup_t * fft_setup,
+                           const rta_fft_kernel_t kernel);
+int
+rta_fft_f_setup_set_threads(rta_fft_f_setup_t * fft_setup,
+                            const unsigned int threads);
+void
+rta_fft_f_setup_delete(rta_fft_f_setup_t * fft_setup);
+void
+rta_fft_f_execute(void * output, void * input, const unsigned int input_size,
+                  rta_fft_f_setup_t * fft_setup);
+void
+rta_fft_f_real_execute(void * output, void * input,
+                       const unsigned int input_size,
+                       rta_fft_f_setup_t * fft_setup,
+                       float * nyquist);
+void
+rta_fft_f_execute_batch(void * output, const unsigned int o_frame_stride,
+                        void * input, const unsigned int i_frame_stride,
+                        const unsigned int input_size,
+                        rta_fft_f_setup_t * fft_setup,
+                        const unsigned int frames);
+void
+rta_fft_f_real_execute_batch(void * output, const unsigned int o_frame_stride,
+                             void * input, const unsigned int i_frame_stride,
+                             const unsigned int input_size,
+                             rta_fft_f_setup_t * fft_setup,
+                             float * nyquist,
+                             const unsigned int frames);
+unsigned int
+rta_fft_f_size(const rta_fft_t fft_type, const unsigned int fft_size);
+
+/** @} */
+
+/** @name Double precision, see rta_fft.h */
+/** @{ */
+
+int
+rta_fft_d_real_setup_new(rta_fft_d_setup_t ** fft_setup,
+                         rta_fft_t fft_type, double * scale,
+                         void * input, const unsigned int input_size,
+                         void * output, const unsigned int fft_size,
+                         double * nyquist);
+int
+rta_fft_d_real_setup_new_stride(
+  rta_fft_d_setup_t ** fft_setup,
+  rta_fft_t fft_type, double * scale,
+  void * input, const int i_stride, const unsigned int input_size,
+  void * output, const int o_stride, const unsigned int fft_size,
+  double * nyquist);
+int
+rta_fft_d_setup_new(rta_fft_d_setup_t ** fft_setup,
+                    rta_fft_t fft_type, double * scale,
+                    rta_fft_d_complex_t * input, const unsigned int input_size,
+                    rta_fft_d_complex_t * output, const unsigned int fft_size);
+int
+rta_fft_d_setup_new_stride(
+  rta_fft_d_setup_t ** fft_setup,
+  rta_fft_t fft_type, double * scale,
+  rta_fft_d_complex_t * input, const int i_stride,
+  const unsigned int input_size,
+  rta_fft_d_complex_t * output, const int o_stride,
+  const unsigned int fft_size);
+int
+rta_fft_d_plan_new(rta_fft_d_plan_t ** fft_plan,
+                   const rta_fft_t fft_type, const unsigned int fft_size);
+void
+rta_fft_d_plan_delete(rta_fft_d_plan_t * fft_plan);
+int
+rta_fft_d_plan_acquire(rta_fft_d_plan_t ** fft_plan,
+                       const rta_fft_t fft_type, const unsigned int fft_size);
+void
+rta_fft_d_plan_release(rta_fft_d_plan_t * fft_plan);
+int
+rta_fft_d_setup_new_with_plan(rta_fft_d_setup_t ** fft_setup,
+                              rta_fft_d_plan_t * fft_plan,
+                              const rta_fft_t fft_type, double * scale,
+                              void * input, const int i_stride,
+                              const unsigned int input_size,
+                              void * output, const int o_stride,
+                              double * nyquist);
+int
+rta_fft_d_setup_set_kernel(rta_fft_d_setup_t * fft_setup,
+                           const rta_fft_kernel_t kernel);
+int
+rta_fft_d_setup_set_threads(rta_fft_d_setup_t * fft_setup,
+                            const unsigned int threads);
+void
+rta_fft_d_setup_delete(rta_fft_d_setup_t * fft_setup);
+void
+rta_fft_d_execute(void * output, void * input, const unsigned int input_size,
+                  rta_fft_d_setup_t * fft_setup);
+void
+rta_fft_d_real_execute(void * output, void * input,
+                       const unsigned int input_size,
+                       rta_fft_d_setup_t * fft_setup,
+                       double * nyquist);
+void
+rta_fft_d_execute_batch(void * output, const unsigned int o_frame_stride,
+                        void * input, const unsigned int i_frame_stride,
+                        const unsigned int input_size,
+                        rta_fft_d_setup_t * fft_setup,
+                        const unsigned int frames);
+void
+rta_fft_d_real_execute_batch(void * output, const unsigned int o_frame_stride,
+                             void * input, const unsigned int i_frame_stride,
+                             const unsigned int input_size,
+                             rta_fft_d_setup_t * fft_setup,
+                             double * nyquist,
+                             const unsigned int frames);
+unsigned int
+rta_fft_d_size(const rta_fft_t fft_type, const unsigned int fft_size);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTA_FFT_TYPED_H_ */
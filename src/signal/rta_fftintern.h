@@ -0,0 +1,165 @@
+/**
+ * @file   rta_fftintern.h
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_signal
+ *
+ * @brief  private declarations for the Fast Fourier Transform
+ *
+ * Vectorised (SIMD) FFT kernels, selected at run time by rta_fft.c.
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _RTA_FFTINTERN_H_
+#define _RTA_FFTINTERN_H_ 1
+
+#include "rta.h"
+
+/*
+ * The precision suffixed instances of the FFT (rta_fft_f.c and
+ * rta_fft_d.c) define RTA_FFT_NAME before including this file, to
+ * rename the public symbols of rta_fft.c and rta_fftsimd.c, as
+ * declared by rta_fft_typed.h.
+ */
+#ifdef RTA_FFT_NAME
+#define rta_fft_setup RTA_FFT_NAME(setup)
+#define rta_fft_setup_t RTA_FFT_NAME(setup_t)
+#define rta_fft_plan RTA_FFT_NAME(plan)
+#define rta_fft_plan_t RTA_FFT_NAME(plan_t)
+#define rta_fft_size RTA_FFT_NAME(size)
+#define rta_fft_real_setup_new RTA_FFT_NAME(real_setup_new)
+#define rta_fft_real_setup_new_stride RTA_FFT_NAME(real_setup_new_stride)
+#define rta_fft_setup_new RTA_FFT_NAME(setup_new)
+#define rta_fft_setup_new_stride RTA_FFT_NAME(setup_new_stride)
+#define rta_fft_plan_new RTA_FFT_NAME(plan_new)
+#define rta_fft_plan_delete RTA_FFT_NAME(plan_delete)
+#define rta_fft_plan_acquire RTA_FFT_NAME(plan_acquire)
+#define rta_fft_plan_release RTA_FFT_NAME(plan_release)
+#define rta_fft_setup_new_with_plan RTA_FFT_NAME(setup_new_with_plan)
+#define rta_fft_setup_set_kernel RTA_FFT_NAME(setup_set_kernel)
+#define rta_fft_setup_set_threads RTA_FFT_NAME(setup_set_threads)
+#define rta_fft_setup_delete RTA_FFT_NAME(setup_delete)
+#define rta_fft_execute RTA_FFT_NAME(execute)
+#define rta_fft_real_execute RTA_FFT_NAME(real_execute)
+#define rta_fft_execute_batch RTA_FFT_NAME(execute_batch)
+#define rta_fft_real_execute_batch RTA_FFT_NAME(real_execute_batch)
+#define rta_fft_simd_get RTA_FFT_NAME(simd_get)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * One radix-4 pass on bit reversed, interleaved complex data.
+ *
+ * \param buf is the interleaved real and imaginary values of 'size'
+ * complex points
+ * \param twiddles points to the coefficients of this pass: 'up'
+ * interleaved complex values for each of W, W^2 and W^3, with
+ * W = exp(j*2*PI*n/(4*up)), n = 0..up-1
+ * \param size is the number of complex points
+ * \param up is the half-size of the radix-2 butterflies merged in this
+ * pass (1, 4, 16... or 2, 8, 32...)
+ * \param direction is -1 for FFT and 1 for IFFT
+ */
+typedef void (*rta_fft_radix_4_pass_t)(rta_real_t * buf,
+                                       const rta_real_t * twiddles,
+                                       const unsigned int size,
+                                       const unsigned int up,
+                                       const rta_real_t direction);
+
+/**
+ * One radix-4 Stockham pass, from natural order 'x' to 'y', as
+ * mixed_radix_pass() in rta_fft.c.
+ *
+ * \param x is the interleaved real and imaginary input values
+ * \param y is the interleaved real and imaginary output values
+ * \param twiddles points to the coefficients of this pass: W, W^2 and
+ * W^3 interleaved for each of the n/4 values of W = exp(j*2*PI*i/n)
+ * \param n is the size of the current sub-transforms
+ * \param s is the number of sub-transforms, a multiple of the vector
+ * width
+ * \param direction is -1 for FFT and 1 for IFFT
+ */
+typedef void (*rta_fft_stockham_4_pass_t)(const rta_real_t * x,
+                                          rta_real_t * y,
+                                          const rta_real_t * twiddles,
+                                          const unsigned int n,
+                                          const unsigned int s,
+                                          const rta_real_t direction);
+
+/**
+ * Vectorised part of the real FFT shuffling routines, for the pairs of
+ * points (idx, size - idx), idx = 1..
+ *
+ * \param buf is the interleaved real and imaginary values of 'size'
+ * complex points
+ * \param coef_real is the cosine table of 2 * 'size' points
+ * \param coef_imag is the sine table of 2 * 'size' points
+ * \param size is the number of complex points
+ *
+ * \return the first index idx that was not processed. The remaining
+ * pairs, the first and the middle points are left to the scalar code.
+ */
+typedef unsigned int (*rta_fft_shuffle_t)(rta_real_t * buf,
+                                          const rta_real_t * coef_real,
+                                          const rta_real_t * coef_imag,
+                                          const unsigned int size);
+
+/** Set of vectorised kernels for an instruction set */
+typedef struct
+{
+  const char * name;  /**< instruction set */
+  unsigned int width; /**< complex values per vector */
+  rta_fft_radix_4_pass_t radix_4_pass; /**< for 'up' >= 'width' */
+  rta_fft_stockham_4_pass_t stockham_4_pass; /**< for 's' % 'width' == 0 */
+  rta_fft_shuffle_t shuffle_after_real_fft;
+  rta_fft_shuffle_t shuffle_before_real_inverse_fft;
+} rta_fft_simd_t;
+
+/**
+ * Select the vectorised kernels for the running processor.
+ *
+ * SSE2 and AVX2 (with FMA) are detected at run time on x86 with GCC
+ * compatible compilers, NEON is used when compiled for ARM with NEON
+ * support and single precision.
+ *
+ * \return the kernels of the best available instruction set, or NULL
+ * if none is supported (then use the scalar code)
+ */
+const rta_fft_simd_t * rta_fft_simd_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTA_FFTINTERN_H_ */
@@ -0,0 +1,894 @@
+/**
+ * @file   rta_fftsimd.c
+ * @date   Sun Oct 18 2026
+ *
+ * @brief  Vectorised Fast Fourier Transform kernels
+ *
+ * SSE2, AVX2 and NEON versions of the radix-4 passes and of the real
+ * FFT shuffling routines of rta_fft.c, working on interleaved complex
+ * data. They compute the same values as the scalar code, with the
+ * usual rounding differences (AVX2 uses fused multiply-add).
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rta_fftintern.h"
+
+#include <stddef.h> /* NULL */
+
+/* x86 kernels need the GCC (or clang) target attributes and CPU detection */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+  (RTA_REAL_TYPE == RTA_FLOAT_TYPE || RTA_REAL_TYPE == RTA_DOUBLE_TYPE)
+#define RTA_FFT_USE_X86 1
+#include <immintrin.h>
+#endif
+
+#if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && \
+  (RTA_REAL_TYPE == RTA_FLOAT_TYPE)
+#define RTA_FFT_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* ------- SSE2 and AVX2, single precision ------------------------------ */
+#if defined(RTA_FFT_USE_X86) && (RTA_REAL_TYPE == RTA_FLOAT_TYPE)
+
+/* a * (w_real + j * direction * w_imag), with sign = (-d, d, -d, d) */
+static inline __attribute__((target("sse2"), always_inline)) __m128
+complex_multiply_sse2(const __m128 a, const __m128 w, const __m128 sign)
+{
+  const __m128 w_real = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 0, 0));
+  const __m128 w_imag = _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 1, 1));
+  const __m128 a_swap = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+
+  return _mm_add_ps(_mm_mul_ps(a, w_real),
+                    _mm_mul_ps(_mm_mul_ps(a_swap, w_imag), sign));
+}
+
+static __attribute__((target("sse2"))) void
+radix_4_pass_sse2(rta_real_t * buf, const rta_real_t * twiddles,
+                  const unsigned int size, const unsigned int up,
+                  const rta_real_t direction)
+{
+  const __m128 sign = _mm_set_ps(direction, -direction, direction, -direction);
+  const unsigned int incr = 8 * up;
+  unsigned int m, j;
+
+  for(m=0; m<2*size; m+=incr)
+  {
+    rta_real_t * b0 = buf + m;
+    rta_real_t * b1 = b0 + 2 * up;
+    rta_real_t * b2 = b1 + 2 * up;
+    rta_real_t * b3 = b2 + 2 * up;
+
+    for(j=0; j<2*up; j+=4)
+    {
+      const __m128 w1 = _mm_loadu_ps(twiddles + j);
+      const __m128 w2 = _mm_loadu_ps(twiddles + 2 * up + j);
+      const __m128 w3 = _mm_loadu_ps(twiddles + 4 * up + j);
+
+      const __m128 a0 = _mm_loadu_ps(b0 + j);
+      const __m128 c1 = complex_multiply_sse2(_mm_loadu_ps(b1 + j), w2, sign);
+      const __m128 c2 = complex_multiply_sse2(_mm_loadu_ps(b2 + j), w1, sign);
+      const __m128 c3 = complex_multiply_sse2(_mm_loadu_ps(b3 + j), w3, sign);
+
+      const __m128 s0 = _mm_add_ps(a0, c1);
+      const __m128 d0 = _mm_sub_ps(a0, c1);
+      const __m128 s1 = _mm_add_ps(c2, c3);
+
+      /* direction * j * (c2 - c3) */
+      const __m128 c23 = _mm_sub_ps(c2, c3);
+      const __m128 d1 = _mm_mul_ps(
+        _mm_shuffle_ps(c23, c23, _MM_SHUFFLE(2, 3, 0, 1)), sign);
+
+      _mm_storeu_ps(b0 + j, _mm_add_ps(s0, s1));
+      _mm_storeu_ps(b1 + j, _mm_add_ps(d0, d1));
+      _mm_storeu_ps(b2 + j, _mm_sub_ps(s0, s1));
+      _mm_storeu_ps(b3 + j, _mm_sub_ps(d0, d1));
+    }
+  }
+  return;
+}
+
+/* swap the 2 complex values of a vector */
+#define reverse_complex_sse2(v) _mm_shuffle_ps((v), (v), _MM_SHUFFLE(1, 0, 3, 2))
+#define swap_real_imag_sse2(v)  _mm_shuffle_ps((v), (v), _MM_SHUFFLE(2, 3, 0, 1))
+
+static __attribute__((target("sse2"))) unsigned int
+shuffle_after_real_fft_sse2(rta_real_t * buf,
+                            const rta_real_t * coef_real,
+                            const rta_real_t * coef_imag,
+                            const unsigned int size)
+{
+  const __m128 half = _mm_set1_ps(0.5);
+  const __m128 conj = _mm_set_ps(-1., 1., -1., 1.);
+  unsigned int idx;
+
+  for(idx=1; idx+2<=size/2; idx+=2)
+  {
+    const unsigned int xdi = size - idx - 1; /* xdi and xdi + 1, reversed */
+    const __m128 c = _mm_loadu_ps(coef_real + idx);
+    const __m128 s = _mm_loadu_ps(coef_imag + idx);
+    const __m128 c_dup = _mm_unpacklo_ps(c, c);
+    const __m128 s_dup = _mm_unpacklo_ps(s, s);
+
+    const __m128 a = _mm_loadu_ps(buf + 2 * idx);
+    const __m128 b = reverse_complex_sse2(_mm_loadu_ps(buf + 2 * xdi));
+
+    const __m128 x1 = _mm_mul_ps(half, _mm_add_ps(a, _mm_mul_ps(b, conj)));
+    const __m128 x2 = _mm_mul_ps(half,
+                                 _mm_add_ps(swap_real_imag_sse2(b),
+                                            _mm_mul_ps(swap_real_imag_sse2(a),
+                                                       conj)));
+    /* x2 * exp(-j*PI*i/size) */
+    const __m128 x2Ej = _mm_add_ps(_mm_mul_ps(x2, c_dup),
+                                   _mm_mul_ps(_mm_mul_ps(swap_real_imag_sse2(x2),
+                                                         s_dup), conj));
+
+    _mm_storeu_ps(buf + 2 * idx, _mm_add_ps(x1, x2Ej));
+    _mm_storeu_ps(buf + 2 * xdi,
+                  reverse_complex_sse2(_mm_mul_ps(_mm_sub_ps(x1, x2Ej), conj)));
+  }
+  return idx;
+}
+
+static __attribute__((target("sse2"))) unsigned int
+shuffle_before_real_inverse_fft_sse2(rta_real_t * buf,
+                                     const rta_real_t * coef_real,
+                                     const rta_real_t * coef_imag,
+                                     const unsigned int size)
+{
+  const __m128 conj = _mm_set_ps(-1., 1., -1., 1.);
+  const __m128 j_sign = _mm_set_ps(1., -1., 1., -1.);
+  unsigned int idx;
+
+  for(idx=1; idx+2<=size/2; idx+=2)
+  {
+    const unsigned int xdi = size - idx - 1; /* xdi and xdi + 1, reversed */
+    const __m128 c = _mm_loadu_ps(coef_real + idx);
+    const __m128 s = _mm_loadu_ps(coef_imag + idx);
+    const __m128 c_dup = _mm_unpacklo_ps(c, c);
+    const __m128 s_dup = _mm_unpacklo_ps(s, s);
+
+    const __m128 a = _mm_loadu_ps(buf + 2 * idx);
+    const __m128 b_conj = _mm_mul_ps(
+      reverse_complex_sse2(_mm_loadu_ps(buf + 2 * xdi)), conj);
+
+    const __m128 x1 = _mm_add_ps(a, b_conj);
+    const __m128 x2Ej = _mm_sub_ps(a, b_conj);
+
+    /* x2Ej * exp(j*PI*i/size) */
+    const __m128 x2 = _mm_add_ps(_mm_mul_ps(x2Ej, c_dup),
+                                 _mm_mul_ps(_mm_mul_ps(swap_real_imag_sse2(x2Ej),
+                                                       s_dup), j_sign));
+    /* j * x2 */
+    const __m128 jx2 = _mm_mul_ps(swap_real_imag_sse2(x2), j_sign);
+
+    _mm_storeu_ps(buf + 2 * idx, _mm_add_ps(x1, jx2));
+    _mm_storeu_ps(buf + 2 * xdi,
+                  reverse_complex_sse2(_mm_mul_ps(_mm_sub_ps(x1, jx2), conj)));
+  }
+  return idx;
+}
+
+/* one complex value, in each half of a vector */
+#define load_complex_sse2(p) _mm_castpd_ps(_mm_load1_pd((const double *) (p)))
+
+static __attribute__((target("sse2"))) void
+stockham_4_pass_sse2(const rta_real_t * x, rta_real_t * y,
+                     const rta_real_t * twiddles,
+                     const unsigned int n, const unsigned int s,
+                     const rta_real_t direction)
+{
+  const __m128 sign = _mm_set_ps(direction, -direction, direction, -direction);
+  const unsigned int m = n / 4;
+  const unsigned int x_step = 2 * s * m;
+  unsigned int j, q;
+
+  for(j=0; j<m; j++)
+  {
+    /* same coefficients for the 's' sub-transforms */
+    const __m128 w1 = load_complex_sse2(twiddles + 6 * j);
+    const __m128 w2 = load_complex_sse2(twiddles + 6 * j + 2);
+    const __m128 w3 = load_complex_sse2(twiddles + 6 * j + 4);
+    const rta_real_t * a = x + 2 * s * j;
+    rta_real_t * b = y + 8 * s * j;
+
+    for(q=0; q<2*s; q+=4)
+    {
+      const __m128 a0 = _mm_loadu_ps(a + q);
+      const __m128 a1 = _mm_loadu_ps(a + x_step + q);
+      const __m128 a2 = _mm_loadu_ps(a + 2 * x_step + q);
+      const __m128 a3 = _mm_loadu_ps(a + 3 * x_step + q);
+
+      const __m128 s0 = _mm_add_ps(a0, a2);
+      const __m128 d0 = _mm_sub_ps(a0, a2);
+      const __m128 s1 = _mm_add_ps(a1, a3);
+      /* direction * j * (a1 - a3) */
+      const __m128 d1 =
+        _mm_mul_ps(swap_real_imag_sse2(_mm_sub_ps(a1, a3)), sign);
+
+      _mm_storeu_ps(b + q, _mm_add_ps(s0, s1));
+      _mm_storeu_ps(b + 2 * s + q,
+        complex_multiply_sse2(_mm_add_ps(d0, d1), w1, sign));
+      _mm_storeu_ps(b + 4 * s + q,
+        complex_multiply_sse2(_mm_sub_ps(s0, s1), w2, sign));
+      _mm_storeu_ps(b + 6 * s + q,
+        complex_multiply_sse2(_mm_sub_ps(d0, d1), w3, sign));
+    }
+  }
+  return;
+}
+
+/* a * (w_real + j * w_imag), with w_imag including the direction */
+static inline __attribute__((target("avx2,fma"), always_inline)) __m256
+complex_multiply_avx2(const __m256 a, const __m256 w, const __m256 direction)
+{
+  const __m256 w_real = _mm256_moveldup_ps(w);
+  const __m256 w_imag = _mm256_mul_ps(_mm256_movehdup_ps(w), direction);
+  const __m256 a_swap = _mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1));
+
+  return _mm256_fmaddsub_ps(a, w_real, _mm256_mul_ps(a_swap, w_imag));
+}
+
+static __attribute__((target("avx2,fma"))) void
+radix_4_pass_avx2(rta_real_t * buf, const rta_real_t * twiddles,
+                  const unsigned int size, const unsigned int up,
+                  const rta_real_t direction)
+{
+  const __m256 dir = _mm256_set1_ps(direction);
+  const __m256 sign = _mm256_set_ps(direction, -direction, direction, -direction,
+                                    direction, -direction, direction, -direction);
+  const unsigned int incr = 8 * up;
+  unsigned int m, j;
+
+  for(m=0; m<2*size; m+=incr)
+  {
+    rta_real_t * b0 = buf + m;
+    rta_real_t * b1 = b0 + 2 * up;
+    rta_real_t * b2 = b1 + 2 * up;
+    rta_real_t * b3 = b2 + 2 * up;
+
+    for(j=0; j<2*up; j+=8)
+    {
+      const __m256 w1 = _mm256_loadu_ps(twiddles + j);
+      const __m256 w2 = _mm256_loadu_ps(twiddles + 2 * up + j);
+      const __m256 w3 = _mm256_loadu_ps(twiddles + 4 * up + j);
+
+      const __m256 a0 = _mm256_loadu_ps(b0 + j);
+      const __m256 c1 = complex_multiply_avx2(_mm256_loadu_ps(b1 + j), w2, dir);
+      const __m256 c2 = complex_multiply_avx2(_mm256_loadu_ps(b2 + j), w1, dir);
+      const __m256 c3 = complex_multiply_avx2(_mm256_loadu_ps(b3 + j), w3, dir);
+
+      const __m256 s0 = _mm256_add_ps(a0, c1);
+      const __m256 d0 = _mm256_sub_ps(a0, c1);
+      const __m256 s1 = _mm256_add_ps(c2, c3);
+
+      /* direction * j * (c2 - c3) */
+      const __m256 d1 = _mm256_mul_ps(
+        _mm256_permute_ps(_mm256_sub_ps(c2, c3), _MM_SHUFFLE(2, 3, 0, 1)), sign);
+
+      _mm256_storeu_ps(b0 + j, _mm256_add_ps(s0, s1));
+      _mm256_storeu_ps(b1 + j, _mm256_add_ps(d0, d1));
+      _mm256_storeu_ps(b2 + j, _mm256_sub_ps(s0, s1));
+      _mm256_storeu_ps(b3 + j, _mm256_sub_ps(d0, d1));
+    }
+  }
+  return;
+}
+
+/* one complex value, in each quarter of a vector */
+#define load_complex_avx2(p) \
+  _mm256_castpd_ps(_mm256_broadcast_sd((const double *) (p)))
+#define swap_real_imag_avx2(v) _mm256_permute_ps((v), _MM_SHUFFLE(2, 3, 0, 1))
+
+static __attribute__((target("avx2,fma"))) void
+stockham_4_pass_avx2(const rta_real_t * x, rta_real_t * y,
+                     const rta_real_t * twiddles,
+                     const unsigned int n, const unsigned int s,
+                     const rta_real_t direction)
+{
+  const __m256 dir = _mm256_set1_ps(direction);
+  const __m256 sign = _mm256_set_ps(direction, -direction, direction, -direction,
+                                    direction, -direction, direction, -direction);
+  const unsigned int m = n / 4;
+  const unsigned int x_step = 2 * s * m;
+  unsigned int j, q;
+
+  for(j=0; j<m; j++)
+  {
+    /* same coefficients for the 's' sub-transforms */
+    const __m256 w1 = load_complex_avx2(twiddles + 6 * j);
+    const __m256 w2 = load_complex_avx2(twiddles + 6 * j + 2);
+    const __m256 w3 = load_complex_avx2(twiddles + 6 * j + 4);
+    const rta_real_t * a = x + 2 * s * j;
+    rta_real_t * b = y + 8 * s * j;
+
+    for(q=0; q<2*s; q+=8)
+    {
+      const __m256 a0 = _mm256_loadu_ps(a + q);
+      const __m256 a1 = _mm256_loadu_ps(a + x_step + q);
+      const __m256 a2 = _mm256_loadu_ps(a + 2 * x_step + q);
+      const __m256 a3 = _mm256_loadu_ps(a + 3 * x_step + q);
+
+      const __m256 s0 = _mm256_add_ps(a0, a2);
+      const __m256 d0 = _mm256_sub_ps(a0, a2);
+      const __m256 s1 = _mm256_add_ps(a1, a3);
+      /* direction * j * (a1 - a3) */
+      const __m256 d1 =
+        _mm256_mul_ps(swap_real_imag_avx2(_mm256_sub_ps(a1, a3)), sign);
+
+      _mm256_storeu_ps(b + q, _mm256_add_ps(s0, s1));
+      _mm256_storeu_ps(b + 2 * s + q,
+        complex_multiply_avx2(_mm256_add_ps(d0, d1), w1, dir));
+      _mm256_storeu_ps(b + 4 * s + q,
+        complex_multiply_avx2(_mm256_sub_ps(s0, s1), w2, dir));
+      _mm256_storeu_ps(b + 6 * s + q,
+        complex_multiply_avx2(_mm256_sub_ps(d0, d1), w3, dir));
+    }
+  }
+  return;
+}
+
+#endif /* single precision x86 */
+
+/* ------- SSE2 and AVX2, double precision ------------------------------ */
+#if defined(RTA_FFT_USE_X86) && (RTA_REAL_TYPE == RTA_DOUBLE_TYPE)
+
+#define swap_real_imag_sse2(v) _mm_shuffle_pd((v), (v), 1)
+
+/* a * (w_real + j * direction * w_imag), with sign = (-d, d) */
+static inline __attribute__((target("sse2"), always_inline)) __m128d
+complex_multiply_sse2(const __m128d a, const __m128d w, const __m128d sign)
+{
+  const __m128d w_real = _mm_unpacklo_pd(w, w);
+  const __m128d w_imag = _mm_unpackhi_pd(w, w);
+
+  return _mm_add_pd(_mm_mul_pd(a, w_real),
+                    _mm_mul_pd(_mm_mul_pd(swap_real_imag_sse2(a), w_imag), sign));
+}
+
+static __attribute__((target("sse2"))) void
+radix_4_pass_sse2(rta_real_t * buf, const rta_real_t * twiddles,
+                  const unsigned int size, const unsigned int up,
+                  const rta_real_t direction)
+{
+  const __m128d sign = _mm_set_pd(direction, -direction);
+  const unsigned int incr = 8 * up;
+  unsigned int m, j;
+
+  for(m=0; m<2*size; m+=incr)
+  {
+    rta_real_t * b0 = buf + m;
+    rta_real_t * b1 = b0 + 2 * up;
+    rta_real_t * b2 = b1 + 2 * up;
+    rta_real_t * b3 = b2 + 2 * up;
+
+    for(j=0; j<2*up; j+=2)
+    {
+      const __m128d w1 = _mm_loadu_pd(twiddles + j);
+      const __m128d w2 = _mm_loadu_pd(twiddles + 2 * up + j);
+      const __m128d w3 = _mm_loadu_pd(twiddles + 4 * up + j);
+
+      const __m128d a0 = _mm_loadu_pd(b0 + j);
+      const __m128d c1 = complex_multiply_sse2(_mm_loadu_pd(b1 + j), w2, sign);
+      const __m128d c2 = complex_multiply_sse2(_mm_loadu_pd(b2 + j), w1, sign);
+      const __m128d c3 = complex_multiply_sse2(_mm_loadu_pd(b3 + j), w3, sign);
+
+      const __m128d s0 = _mm_add_pd(a0, c1);
+      const __m128d d0 = _mm_sub_pd(a0, c1);
+      const __m128d s1 = _mm_add_pd(c2, c3);
+
+      /* direction * j * (c2 - c3) */
+      const __m128d d1 = _mm_mul_pd(
+        swap_real_imag_sse2(_mm_sub_pd(c2, c3)), sign);
+
+      _mm_storeu_pd(b0 + j, _mm_add_pd(s0, s1));
+      _mm_storeu_pd(b1 + j, _mm_add_pd(d0, d1));
+      _mm_storeu_pd(b2 + j, _mm_sub_pd(s0, s1));
+      _mm_storeu_pd(b3 + j, _mm_sub_pd(d0, d1));
+    }
+  }
+  return;
+}
+
+static __attribute__((target("sse2"))) unsigned int
+shuffle_after_real_fft_sse2(rta_real_t * buf,
+                            const rta_real_t * coef_real,
+                            const rta_real_t * coef_imag,
+                            const unsigned int size)
+{
+  const __m128d half = _mm_set1_pd(0.5);
+  const __m128d conj = _mm_set_pd(-1., 1.);
+  unsigned int idx;
+
+  for(idx=1; idx<size/2; idx++)
+  {
+    const unsigned int xdi = size - idx;
+    const __m128d c_dup = _mm_set1_pd(coef_real[idx]);
+    const __m128d s_dup = _mm_set1_pd(coef_imag[idx]);
+
+    const __m128d a = _mm_loadu_pd(buf + 2 * idx);
+    const __m128d b = _mm_loadu_pd(buf + 2 * xdi);
+
+    const __m128d x1 = _mm_mul_pd(half, _mm_add_pd(a, _mm_mul_pd(b, conj)));
+    const __m128d x2 = _mm_mul_pd(half,
+                                  _mm_add_pd(swap_real_imag_sse2(b),
+                                             _mm_mul_pd(swap_real_imag_sse2(a),
+                                                        conj)));
+    /* x2 * exp(-j*PI*i/size) */
+    const __m128d x2Ej = _mm_add_pd(_mm_mul_pd(x2, c_dup),
+                                    _mm_mul_pd(_mm_mul_pd(swap_real_imag_sse2(x2),
+                                                          s_dup), conj));
+
+    _mm_storeu_pd(buf + 2 * idx, _mm_add_pd(x1, x2Ej));
+    _mm_storeu_pd(buf + 2 * xdi, _mm_mul_pd(_mm_sub_pd(x1, x2Ej), conj));
+  }
+  return idx;
+}
+
+static __attribute__((target("sse2"))) unsigned int
+shuffle_before_real_inverse_fft_sse2(rta_real_t * buf,
+                                     const rta_real_t * coef_real,
+                                     const rta_real_t * coef_imag,
+                                     const unsigned int size)
+{
+  const __m128d conj = _mm_set_pd(-1., 1.);
+  const __m128d j_sign = _mm_set_pd(1., -1.);
+  unsigned int idx;
+
+  for(idx=1; idx<size/2; idx++)
+  {
+    const unsigned int xdi = size - idx;
+    const __m128d c_dup = _mm_set1_pd(coef_real[idx]);
+    const __m128d s_dup = _mm_set1_pd(coef_imag[idx]);
+
+    const __m128d a = _mm_loadu_pd(buf + 2 * idx);
+    const __m128d b_conj = _mm_mul_pd(_mm_loadu_pd(buf + 2 * xdi), conj);
+
+    const __m128d x1 = _mm_add_pd(a, b_conj);
+    const __m128d x2Ej = _mm_sub_pd(a, b_conj);
+
+    /* x2Ej * exp(j*PI*i/size) */
+    const __m128d x2 = _mm_add_pd(_mm_mul_pd(x2Ej, c_dup),
+                                  _mm_mul_pd(_mm_mul_pd(swap_real_imag_sse2(x2Ej),
+                                                        s_dup), j_sign));
+    /* j * x2 */
+    const __m128d jx2 = _mm_mul_pd(swap_real_imag_sse2(x2), j_sign);
+
+    _mm_storeu_pd(buf + 2 * idx, _mm_add_pd(x1, jx2));
+    _mm_storeu_pd(buf + 2 * xdi, _mm_mul_pd(_mm_sub_pd(x1, jx2), conj));
+  }
+  return idx;
+}
+
+static __attribute__((target("sse2"))) void
+stockham_4_pass_sse2(const rta_real_t * x, rta_real_t * y,
+                     const rta_real_t * twiddles,
+                     const unsigned int n, const unsigned int s,
+                     const rta_real_t direction)
+{
+  const __m128d sign = _mm_set_pd(direction, -direction);
+  const unsigned int m = n / 4;
+  const unsigned int x_step = 2 * s * m;
+  unsigned int j, q;
+
+  for(j=0; j<m; j++)
+  {
+    /* same coefficients for the 's' sub-transforms */
+    const __m128d w1 = _mm_loadu_pd(twiddles + 6 * j);
+    const __m128d w2 = _mm_loadu_pd(twiddles + 6 * j + 2);
+    const __m128d w3 = _mm_loadu_pd(twiddles + 6 * j + 4);
+    const rta_real_t * a = x + 2 * s * j;
+    rta_real_t * b = y + 8 * s * j;
+
+    for(q=0; q<2*s; q+=2)
+    {
+      const __m128d a0 = _mm_loadu_pd(a + q);
+      const __m128d a1 = _mm_loadu_pd(a + x_step + q);
+      const __m128d a2 = _mm_loadu_pd(a + 2 * x_step + q);
+      const __m128d a3 = _mm_loadu_pd(a + 3 * x_step + q);
+
+      const __m128d s0 = _mm_add_pd(a0, a2);
+      const __m128d d0 = _mm_sub_pd(a0, a2);
+      const __m128d s1 = _mm_add_pd(a1, a3);
+      /* direction * j * (a1 - a3) */
+      const __m128d d1 =
+        _mm_mul_pd(swap_real_imag_sse2(_mm_sub_pd(a1, a3)), sign);
+
+      _mm_storeu_pd(b + q, _mm_add_pd(s0, s1));
+      _mm_storeu_pd(b + 2 * s + q,
+        complex_multiply_sse2(_mm_add_pd(d0, d1), w1, sign));
+      _mm_storeu_pd(b + 4 * s + q,
+        complex_multiply_sse2(_mm_sub_pd(s0, s1), w2, sign));
+      _mm_storeu_pd(b + 6 * s + q,
+        complex_multiply_sse2(_mm_sub_pd(d0, d1), w3, sign));
+    }
+  }
+  return;
+}
+
+/* a * (w_real + j * w_imag), with w_imag including the direction */
+static inline __attribute__((target("avx2,fma"), always_inline)) __m256d
+complex_multiply_avx2(const __m256d a, const __m256d w, const __m256d direction)
+{
+  const __m256d w_real = _mm256_movedup_pd(w);
+  const __m256d w_imag = _mm256_mul_pd(_mm256_permute_pd(w, 0xf), direction);
+  const __m256d a_swap = _mm256_permute_pd(a, 0x5);
+
+  return _mm256_fmaddsub_pd(a, w_real, _mm256_mul_pd(a_swap, w_imag));
+}
+
+static __attribute__((target("avx2,fma"))) void
+radix_4_pass_avx2(rta_real_t * buf, const rta_real_t * twiddles,
+                  const unsigned int size, const unsigned int up,
+                  const rta_real_t direction)
+{
+  const __m256d dir = _mm256_set1_pd(direction);
+  const __m256d sign = _mm256_set_pd(direction, -direction, direction, -direction);
+  const unsigned int incr = 8 * up;
+  unsigned int m, j;
+
+  for(m=0; m<2*size; m+=incr)
+  {
+    rta_real_t * b0 = buf + m;
+    rta_real_t * b1 = b0 + 2 * up;
+    rta_real_t * b2 = b1 + 2 * up;
+    rta_real_t * b3 = b2 + 2 * up;
+
+    for(j=0; j<2*up; j+=4)
+    {
+      const __m256d w1 = _mm256_loadu_pd(twiddles + j);
+      const __m256d w2 = _mm256_loadu_pd(twiddles + 2 * up + j);
+      const __m256d w3 = _mm256_loadu_pd(twiddles + 4 * up + j);
+
+      const __m256d a0 = _mm256_loadu_pd(b0 + j);
+      const __m256d c1 = complex_multiply_avx2(_mm256_loadu_pd(b1 + j), w2, dir);
+      const __m256d c2 = complex_multiply_avx2(_mm256_loadu_pd(b2 + j), w1, dir);
+      const __m256d c3 = complex_multiply_avx2(_mm256_loadu_pd(b3 + j), w3, dir);
+
+      const __m256d s0 = _mm256_add_pd(a0, c1);
+      const __m256d d0 = _mm256_sub_pd(a0, c1);
+      const __m256d s1 = _mm256_add_pd(c2, c3);
+
+      /* direction * j * (c2 - c3) */
+      const __m256d d1 = _mm256_mul_pd(
+        _mm256_permute_pd(_mm256_sub_pd(c2, c3), 0x5), sign);
+
+      _mm256_storeu_pd(b0 + j, _mm256_add_pd(s0, s1));
+      _mm256_storeu_pd(b1 + j, _mm256_add_pd(d0, d1));
+      _mm256_storeu_pd(b2 + j, _mm256_sub_pd(s0, s1));
+      _mm256_storeu_pd(b3 + j, _mm256_sub_pd(d0, d1));
+    }
+  }
+  return;
+}
+
+/* one complex value, in each half of a vector */
+#define load_complex_avx2(p) _mm256_broadcast_pd((const __m128d *) (p))
+#define swap_real_imag_avx2(v) _mm256_permute_pd((v), 0x5)
+
+static __attribute__((target("avx2,fma"))) void
+stockham_4_pass_avx2(const rta_real_t * x, rta_real_t * y,
+                     const rta_real_t * twiddles,
+                     const unsigned int n, const unsigned int s,
+                     const rta_real_t direction)
+{
+  const __m256d dir = _mm256_set1_pd(direction);
+  const __m256d sign = _mm256_set_pd(direction, -direction, direction, -direction);
+  const unsigned int m = n / 4;
+  const unsigned int x_step = 2 * s * m;
+  unsigned int j, q;
+
+  for(j=0; j<m; j++)
+  {
+    /* same coefficients for the 's' sub-transforms */
+    const __m256d w1 = load_complex_avx2(twiddles + 6 * j);
+    const __m256d w2 = load_complex_avx2(twiddles + 6 * j + 2);
+    const __m256d w3 = load_complex_avx2(twiddles + 6 * j + 4);
+    const rta_real_t * a = x + 2 * s * j;
+    rta_real_t * b = y + 8 * s * j;
+
+    for(q=0; q<2*s; q+=4)
+    {
+      const __m256d a0 = _mm256_loadu_pd(a + q);
+      const __m256d a1 = _mm256_loadu_pd(a + x_step + q);
+      const __m256d a2 = _mm256_loadu_pd(a + 2 * x_step + q);
+      const __m256d a3 = _mm256_loadu_pd(a + 3 * x_step + q);
+
+      const __m256d s0 = _mm256_add_pd(a0, a2);
+      const __m256d d0 = _mm256_sub_pd(a0, a2);
+      const __m256d s1 = _mm256_add_pd(a1, a3);
+      /* direction * j * (a1 - a3) */
+      const __m256d d1 =
+        _mm256_mul_pd(swap_real_imag_avx2(_mm256_sub_pd(a1, a3)), sign);
+
+      _mm256_storeu_pd(b + q, _mm256_add_pd(s0, s1));
+      _mm256_storeu_pd(b + 2 * s + q,
+        complex_multiply_avx2(_mm256_add_pd(d0, d1), w1, dir));
+      _mm256_storeu_pd(b + 4 * s + q,
+        complex_multiply_avx2(_mm256_sub_pd(s0, s1), w2, dir));
+      _mm256_storeu_pd(b + 6 * s + q,
+        complex_multiply_avx2(_mm256_sub_pd(d0, d1), w3, dir));
+    }
+  }
+  return;
+}
+
+#endif /* double precision x86 */
+
+#if defined(RTA_FFT_USE_X86)
+static const rta_fft_simd_t fft_simd_sse2 =
+{
+  "SSE2",
+  16 / sizeof(rta_real_t) / 2,
+  radix_4_pass_sse2,
+  stockham_4_pass_sse2,
+  shuffle_after_real_fft_sse2,
+  shuffle_before_real_inverse_fft_sse2
+};
+
+/* the shuffling routines are memory bound: keep the SSE2 ones */
+static const rta_fft_simd_t fft_simd_avx2 =
+{
+  "AVX2",
+  32 / sizeof(rta_real_t) / 2,
+  radix_4_pass_avx2,
+  stockham_4_pass_avx2,
+  shuffle_after_real_fft_sse2,
+  shuffle_before_real_inverse_fft_sse2
+};
+#endif /* RTA_FFT_USE_X86 */
+
+/* ------- NEON, single precision --------------------------------------- */
+#if defined(RTA_FFT_USE_NEON)
+
+/* a * (w_real + j * direction * w_imag), with sign = (-d, d, -d, d) */
+static inline float32x4_t
+complex_multiply_neon(const float32x4_t a, const float32x4_t w,
+                      const float32x4_t sign)
+{
+  const float32x4x2_t w_dup = vtrnq_f32(w, w); /* real, imaginary */
+  const float32x4_t a_swap = vrev64q_f32(a);
+
+  return vmlaq_f32(vmulq_f32(a, w_dup.val[0]),
+                   vmulq_f32(a_swap, w_dup.val[1]), sign);
+}
+
+static void
+radix_4_pass_neon(rta_real_t * buf, const rta_real_t * twiddles,
+                  const unsigned int size, const unsigned int up,
+                  const rta_real_t direction)
+{
+  const float sign_values[4] = { -direction, direction, -direction, direction };
+  const float32x4_t sign = vld1q_f32(sign_values);
+  const unsigned int incr = 8 * up;
+  unsigned int m, j;
+
+  for(m=0; m<2*size; m+=incr)
+  {
+    rta_real_t * b0 = buf + m;
+    rta_real_t * b1 = b0 + 2 * up;
+    rta_real_t * b2 = b1 + 2 * up;
+    rta_real_t * b3 = b2 + 2 * up;
+
+    for(j=0; j<2*up; j+=4)
+    {
+      const float32x4_t w1 = vld1q_f32(twiddles + j);
+      const float32x4_t w2 = vld1q_f32(twiddles + 2 * up + j);
+      const float32x4_t w3 = vld1q_f32(twiddles + 4 * up + j);
+
+      const float32x4_t a0 = vld1q_f32(b0 + j);
+      const float32x4_t c1 = complex_multiply_neon(vld1q_f32(b1 + j), w2, sign);
+      const float32x4_t c2 = complex_multiply_neon(vld1q_f32(b2 + j), w1, sign);
+      const float32x4_t c3 = complex_multiply_neon(vld1q_f32(b3 + j), w3, sign);
+
+      const float32x4_t s0 = vaddq_f32(a0, c1);
+      const float32x4_t d0 = vsubq_f32(a0, c1);
+      const float32x4_t s1 = vaddq_f32(c2, c3);
+
+      /* direction * j * (c2 - c3) */
+      const float32x4_t d1 = vmulq_f32(vrev64q_f32(vsubq_f32(c2, c3)), sign);
+
+      vst1q_f32(b0 + j, vaddq_f32(s0, s1));
+      vst1q_f32(b1 + j, vaddq_f32(d0, d1));
+      vst1q_f32(b2 + j, vsubq_f32(s0, s1));
+      vst1q_f32(b3 + j, vsubq_f32(d0, d1));
+    }
+  }
+  return;
+}
+
+/* swap the 2 complex values of a vector */
+#define reverse_complex_neon(v) vcombine_f32(vget_high_f32(v), vget_low_f32(v))
+
+/* (c0, c0, c1, c1) from c0 and c1 at p */
+static inline float32x4_t
+load_duplicate_neon(const float * p)
+{
+  const float32x2_t c = vld1_f32(p);
+  return vcombine_f32(vdup_lane_f32(c, 0), vdup_lane_f32(c, 1));
+}
+
+static unsigned int
+shuffle_after_real_fft_neon(rta_real_t * buf,
+                            const rta_real_t * coef_real,
+                            const rta_real_t * coef_imag,
+                            const unsigned int size)
+{
+  const float conj_values[4] = { 1., -1., 1., -1. };
+  const float32x4_t conj = vld1q_f32(conj_values);
+  const float32x4_t half = vdupq_n_f32(0.5);
+  unsigned int idx;
+
+  for(idx=1; idx+2<=size/2; idx+=2)
+  {
+    const unsigned int xdi = size - idx - 1; /* xdi and xdi + 1, reversed */
+    const float32x4_t c_dup = load_duplicate_neon(coef_real + idx);
+    const float32x4_t s_dup = load_duplicate_neon(coef_imag + idx);
+
+    const float32x4_t a = vld1q_f32(buf + 2 * idx);
+    const float32x4_t b = reverse_complex_neon(vld1q_f32(buf + 2 * xdi));
+
+    const float32x4_t x1 = vmulq_f32(half, vmlaq_f32(a, b, conj));
+    const float32x4_t x2 = vmulq_f32(half, vmlaq_f32(vrev64q_f32(b),
+                                                     vrev64q_f32(a), conj));
+    /* x2 * exp(-j*PI*i/size) */
+    const float32x4_t x2Ej = vmlaq_f32(vmulq_f32(x2, c_dup),
+                                       vmulq_f32(vrev64q_f32(x2), s_dup), conj);
+
+    vst1q_f32(buf + 2 * idx, vaddq_f32(x1, x2Ej));
+    vst1q_f32(buf + 2 * xdi,
+              reverse_complex_neon(vmulq_f32(vsubq_f32(x1, x2Ej), conj)));
+  }
+  return idx;
+}
+
+static unsigned int
+shuffle_before_real_inverse_fft_neon(rta_real_t * buf,
+                                     const rta_real_t * coef_real,
+                                     const rta_real_t * coef_imag,
+                                     const unsigned int size)
+{
+  const float conj_values[4] = { 1., -1., 1., -1. };
+  const float32x4_t conj = vld1q_f32(conj_values);
+  const float32x4_t j_sign = vnegq_f32(conj);
+  unsigned int idx;
+
+  for(idx=1; idx+2<=size/2; idx+=2)
+  {
+    const unsigned int xdi = size - idx - 1; /* xdi and xdi + 1, reversed */
+    const float32x4_t c_dup = load_duplicate_neon(coef_real + idx);
+    const float32x4_t s_dup = load_duplicate_neon(coef_imag + idx);
+
+    const float32x4_t a = vld1q_f32(buf + 2 * idx);
+    const float32x4_t b_conj = vmulq_f32(
+      reverse_complex_neon(vld1q_f32(buf + 2 * xdi)), conj);
+
+    const float32x4_t x1 = vaddq_f32(a, b_conj);
+    const float32x4_t x2Ej = vsubq_f32(a, b_conj);
+
+    /* x2Ej * exp(j*PI*i/size) */
+    const float32x4_t x2 = vmlaq_f32(vmulq_f32(x2Ej, c_dup),
+                                     vmulq_f32(vrev64q_f32(x2Ej), s_dup), j_sign);
+    /* j * x2 */
+    const float32x4_t jx2 = vmulq_f32(vrev64q_f32(x2), j_sign);
+
+    vst1q_f32(buf + 2 * idx, vaddq_f32(x1, jx2));
+    vst1q_f32(buf + 2 * xdi,
+              reverse_complex_neon(vmulq_f32(vsubq_f32(x1, jx2), conj)));
+  }
+  return idx;
+}
+
+/* one complex value, in each half of a vector */
+#define load_complex_neon(p) vcombine_f32(vld1_f32(p), vld1_f32(p))
+
+static void
+stockham_4_pass_neon(const rta_real_t * x, rta_real_t * y,
+                     const rta_real_t * twiddles,
+                     const unsigned int n, const unsigned int s,
+                     const rta_real_t direction)
+{
+  const float sign_values[4] = { -direction, direction, -direction, direction };
+  const float32x4_t sign = vld1q_f32(sign_values);
+  const unsigned int m = n / 4;
+  const unsigned int x_step = 2 * s * m;
+  unsigned int j, q;
+
+  for(j=0; j<m; j++)
+  {
+    /* same coefficients for the 's' sub-transforms */
+    const float32x4_t w1 = load_complex_neon(twiddles + 6 * j);
+    const float32x4_t w2 = load_complex_neon(twiddles + 6 * j + 2);
+    const float32x4_t w3 = load_complex_neon(twiddles + 6 * j + 4);
+    const rta_real_t * a = x + 2 * s * j;
+    rta_real_t * b = y + 8 * s * j;
+
+    for(q=0; q<2*s; q+=4)
+    {
+      const float32x4_t a0 = vld1q_f32(a + q);
+      const float32x4_t a1 = vld1q_f32(a + x_step + q);
+      const float32x4_t a2 = vld1q_f32(a + 2 * x_step + q);
+      const float32x4_t a3 = vld1q_f32(a + 3 * x_step + q);
+
+      const float32x4_t s0 = vaddq_f32(a0, a2);
+      const float32x4_t d0 = vsubq_f32(a0, a2);
+      const float32x4_t s1 = vaddq_f32(a1, a3);
+      /* direction * j * (a1 - a3) */
+      const float32x4_t d1 = vmulq_f32(vrev64q_f32(vsubq_f32(a1, a3)), sign);
+
+      vst1q_f32(b + q, vaddq_f32(s0, s1));
+      vst1q_f32(b + 2 * s + q,
+        complex_multiply_neon(vaddq_f32(d0, d1), w1, sign));
+      vst1q_f32(b + 4 * s + q,
+        complex_multiply_neon(vsubq_f32(s0, s1), w2, sign));
+      vst1q_f32(b + 6 * s + q,
+        complex_multiply_neon(vsubq_f32(d0, d1), w3, sign));
+    }
+  }
+  return;
+}
+
+static const rta_fft_simd_t fft_simd_neon =
+{
+  "NEON",
+  2,
+  radix_4_pass_neon,
+  stockham_4_pass_neon,
+  shuffle_after_real_fft_neon,
+  shuffle_before_real_inverse_fft_neon
+};
+
+#endif /* RTA_FFT_USE_NEON */
+
+
+const rta_fft_simd_t *
+rta_fft_simd_get(void)
+{
+  const rta_fft_simd_t * ret = NULL;
+
+#if defined(RTA_FFT_USE_X86)
+  __builtin_cpu_init();
+
+  if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+  {
+    ret = &fft_simd_avx2;
+  }
+  else if(__builtin_cpu_supports("sse2"))
+  {
+    ret = &fft_simd_sse2;
+  }
+#elif defined(RTA_FFT_USE_NEON)
+  ret = &fft_simd_neon;
+#endif
+
+  return ret;
+}
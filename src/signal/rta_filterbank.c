@@ -0,0 +1,306 @@
+/**
+ * @file   rta_filterbank.c
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_signal
+ *
+ * @brief  Constant-Q bank of band-pass filters
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rta_filterbank.h"
+#include "rta_biquad.h"
+#include "rta_biquad_cascade.h"
+#include "rta_math.h"
+#include "rta_stdlib.h" /* memory management */
+
+/* frames filtered at once, through the buffer of all the bands */
+#define RTA_FILTERBANK_BLOCK 64
+
+struct rta_filterbank_setup
+{
+  unsigned int bands;
+  rta_real_t sample_rate;
+  rta_real_t * frequencies; /* centre, in Hz */
+
+  rta_biquad_cascade_setup_t * cascade; /* a channel per band */
+  rta_real_t * buffer; /* RTA_FILTERBANK_BLOCK frames of all the bands */
+
+  rta_real_t * energies; /* smoothed squares of the bands */
+  rta_real_t envelope_coef; /* of the one-pole smoothing */
+};
+
+int
+rta_filterbank_setup_new(rta_filterbank_setup_t ** filterbank_setup,
+                         const unsigned int bands_per_octave,
+                         const rta_real_t min_frequency,
+                         const rta_real_t max_frequency,
+                         const unsigned int sections,
+                         const rta_real_t sample_rate)
+{
+  int ret = 0;
+  rta_filterbank_setup_t * s;
+  int k_min = 0;
+  int k_max = -1;
+
+  if(bands_per_octave > 0 && sections > 0 && sample_rate > 0. &&
+     min_frequency > 0. && max_frequency >= min_frequency)
+  {
+    /* the upper edge of the last band is below nyquist */
+    const rta_real_t edge = rta_pow(2., 0.5 / bands_per_octave);
+    const rta_real_t max_centre = (max_frequency * edge < 0.5 * sample_rate) ?
+      max_frequency : 0.5 * sample_rate / edge;
+
+    k_min = (int) rta_ceil(bands_per_octave * rta_log2(min_frequency / 1000.));
+    k_max = (int) rta_floor(bands_per_octave * rta_log2(max_centre / 1000.));
+  }
+
+  if(k_max >= k_min)
+  {
+    *filterbank_setup = (rta_filterbank_setup_t *)
+      rta_malloc(sizeof(rta_filterbank_setup_t));
+  }
+  else
+  {
+    *filterbank_setup = NULL;
+  }
+
+  s = *filterbank_setup;
+  if(s != NULL)
+  {
+    const unsigned int bands = k_max - k_min + 1;
+    unsigned int band, n;
+
+    s->bands = bands;
+    s->sample_rate = sample_rate;
+    s->frequencies = (rta_real_t *) rta_malloc(sizeof(rta_real_t) * bands);
+    s->buffer = (rta_real_t *)
+      rta_malloc(sizeof(rta_real_t) * RTA_FILTERBANK_BLOCK * bands);
+    s->energies = (rta_real_t *) rta_malloc(sizeof(rta_real_t) * bands);
+
+    if(s->frequencies != NULL && s->buffer != NULL && s->energies != NULL &&
+       rta_biquad_cascade_setup_new(&s->cascade, sections, bands) != 0)
+    {
+      /* each section is at -3 / sections dB at the band edges, for */
+      /* -3 dB through the cascade */
+      const rta_real_t edge_gain = rta_sqrt(rta_pow(2., 1. / sections) - 1.);
+      const rta_real_t edge = rta_pow(2., 0.5 / bands_per_octave);
+      rta_real_t b[3];
+      rta_real_t a[2];
+
+      for(band = 0; band < bands; band++)
+      {
+        /* band edges prewarped for the bilinear transform: the analog */
+        /* band-pass centred on their geometric mean has its edges at */
+        /* the digital ones, even close to nyquist */
+        rta_real_t low, high, centre, q;
+
+        s->frequencies[band] = 1000. *
+          rta_pow(2., (rta_real_t) (k_min + (int) band) / bands_per_octave);
+
+        low = rta_tan(M_PI * s->frequencies[band] / (edge * sample_rate));
+        high = rta_tan(M_PI * s->frequencies[band] * edge / sample_rate);
+        centre = rta_sqrt(low * high);
+        q = edge_gain * centre / (high - low);
+
+        rta_biquad_bandpass_constant_peak_coefs(
+          b, a, 2. * rta_atan(centre) / M_PI, q);
+
+        for(n = 0; n < sections; n++)
+        {
+          rta_biquad_cascade_set_coefs(s->cascade, n, band, b, a);
+        }
+      }
+
+      rta_filterbank_setup_set_envelope_time(s, 0.125);
+      rta_filterbank_setup_clear(s);
+      ret = 1;
+    }
+    else
+    {
+      s->cascade = NULL;
+      rta_filterbank_setup_delete(s);
+      *filterbank_setup = NULL;
+    }
+  }
+
+  return ret;
+}
+
+void
+rta_filterbank_setup_clear(rta_filterbank_setup_t * filterbank_setup)
+{
+  unsigned int band;
+
+  rta_biquad_cascade_setup_clear(filterbank_setup->cascade);
+
+  for(band = 0; band < filterbank_setup->bands; band++)
+  {
+    filterbank_setup->energies[band] = 0.;
+  }
+  return;
+}
+
+void
+rta_filterbank_setup_delete(rta_filterbank_setup_t * filterbank_setup)
+{
+  if(filterbank_setup != NULL)
+  {
+    if(filterbank_setup->cascade != NULL)
+    {
+      rta_biquad_cascade_setup_delete(filterbank_setup->cascade);
+    }
+
+    if(filterbank_setup->frequencies != NULL)
+    {
+      rta_free(filterbank_setup->frequencies);
+    }
+
+    if(filterbank_setup->buffer != NULL)
+    {
+      rta_free(filterbank_setup->buffer);
+    }
+
+    if(filterbank_setup->energies != NULL)
+    {
+      rta_free(filterbank_setup->energies);
+    }
+
+    rta_free(filterbank_setup);
+  }
+  return;
+}
+
+void
+rta_filterbank_setup_set_envelope_time(
+  rta_filterbank_setup_t * filterbank_setup,
+  const rta_real_t envelope_time)
+{
+  filterbank_setup->envelope_coef =
+    1. - rta_exp(-1. / (envelope_time * filterbank_setup->sample_rate));
+  return;
+}
+
+unsigned int
+rta_filterbank_bands(const rta_filterbank_setup_t * filterbank_setup)
+{
+  return filterbank_setup->bands;
+}
+
+rta_real_t
+rta_filterbank_frequency(const rta_filterbank_setup_t * filterbank_setup,
+                         const unsigned int band)
+{
+  return filterbank_setup->frequencies[band];
+}
+
+void
+rta_filterbank_process(rta_real_t * output, rta_real_t * envelopes,
+                       const rta_real_t * input, const unsigned int frames,
+                       rta_filterbank_setup_t * filterbank_setup)
+{
+  rta_filterbank_process_stride(output, filterbank_setup->bands,
+                                envelopes, 1, input, 1, frames,
+                                filterbank_setup);
+  return;
+}
+
+void
+rta_filterbank_process_stride(
+  rta_real_t * output, const int o_stride,
+  rta_real_t * envelopes, const int e_stride,
+  const rta_real_t * input, const int i_stride,
+  const unsigned int frames,
+  rta_filterbank_setup_t * filterbank_setup)
+{
+  rta_filterbank_setup_t * s = filterbank_setup;
+  const unsigned int bands = s->bands;
+  const rta_real_t coef = s->envelope_coef;
+  rta_real_t * buffer = s->buffer;
+  rta_real_t * energies = s->energies;
+  unsigned int start, size, f, band;
+
+  for(start = 0; start < frames; start += size)
+  {
+    size = frames - start;
+    if(size > RTA_FILTERBANK_BLOCK)
+    {
+      size = RTA_FILTERBANK_BLOCK;
+    }
+
+    /* the same input for all the bands */
+    for(f = 0; f < size; f++)
+    {
+      const rta_real_t x = input[(start + f) * i_stride];
+
+      for(band = 0; band < bands; band++)
+      {
+        buffer[f * bands + band] = x;
+      }
+    }
+
+    rta_biquad_cascade_process(buffer, buffer, size, s->cascade);
+
+    if(output != NULL)
+    {
+      for(f = 0; f < size; f++)
+      {
+        rta_real_t * y = output + (start + f) * o_stride;
+
+        for(band = 0; band < bands; band++)
+        {
+          y[band] = buffer[f * bands + band];
+        }
+      }
+    }
+
+    /* even without envelopes, for the next ones */
+    for(f = 0; f < size; f++)
+    {
+      const rta_real_t * y = buffer + f * bands;
+
+      for(band = 0; band < bands; band++)
+      {
+        energies[band] += coef * (y[band] * y[band] - energies[band]);
+      }
+    }
+  }
+
+  if(envelopes != NULL)
+  {
+    for(band = 0; band < bands; band++)
+    {
+      envelopes[band * e_stride] = rta_sqrt(energies[band]);
+    }
+  }
+
+  return;
+}
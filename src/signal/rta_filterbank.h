@@ -0,0 +1,203 @@
+/**
+ * @file   rta_filterbank.h
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_signal
+ *
+ * @brief  Constant-Q bank of band-pass filters
+ *
+ * Fractional octave analysis (as third-octave bands): each band is a
+ * cascade of identical band-pass biquads (see
+ * rta_biquad_bandpass_constant_peak_coefs), all the bands filtering
+ * the same input. The bands are processed together, with vector
+ * instructions across bands (see rta_biquad_cascade.h), into the
+ * filtered signals and their RMS envelopes.
+ *
+ * The centre frequencies are 1000 Hz * 2^(k / bands_per_octave), for
+ * integer k, and the -3 dB bandwidth of each band is
+ * 1 / bands_per_octave octave: the bands are adjacent at -3 dB.
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _RTA_FILTERBANK_H_
+#define _RTA_FILTERBANK_H_ 1
+
+#include "rta.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* rta_filterbank_setup is private (depends on implementation) */
+typedef struct rta_filterbank_setup rta_filterbank_setup_t;
+
+/**
+ * Allocate and initialize a filter bank setup, with all the bands
+ * between 'min_frequency' and 'max_frequency'.
+ *
+ * The states and the envelopes are cleared, and the envelope time is
+ * 0.125 s (see rta_filterbank_setup_set_envelope_time). All the memory
+ * is allocated here.
+ *
+ * \see rta_filterbank_setup_delete
+ * \see rta_filterbank_process
+ *
+ * @param filterbank_setup is an address of a pointer to a private
+ * structure. This function allocates 'filterbank_setup' and fills it.
+ * @param bands_per_octave is the number of bands per octave, 3 for a
+ * third-octave bank. It must be > 0.
+ * @param min_frequency is the minimum centre frequency, in Hz
+ * @param max_frequency is the maximum centre frequency, in Hz. The
+ * bands whose upper edge is above the nyquist frequency are
+ * discarded.
+ * @param sections is the number of biquads of each band. The
+ * bandwidth at -3 dB stays the same, with steeper skirts for more
+ * sections: the band edges, a half band below and above the centre,
+ * are at -3 dB up to the nyquist frequency, as the filters are
+ * designed from the edges prewarped for the bilinear transform. It
+ * must be > 0.
+ * @param sample_rate is the sampling rate, in Hz
+ *
+ * @return 1 on success 0 on fail (no band between 'min_frequency' and
+ * 'max_frequency'). If it fails, nothing should be done with
+ * 'filterbank_setup' (even a delete).
+ */
+int
+rta_filterbank_setup_new(rta_filterbank_setup_t ** filterbank_setup,
+                         const unsigned int bands_per_octave,
+                         const rta_real_t min_frequency,
+                         const rta_real_t max_frequency,
+                         const unsigned int sections,
+                         const rta_real_t sample_rate);
+
+/**
+ * Clear the states of the filters and the envelopes of a filter bank
+ * setup, as after its allocation.
+ *
+ * @param filterbank_setup is a pointer to a private structure
+ */
+void
+rta_filterbank_setup_clear(rta_filterbank_setup_t * filterbank_setup);
+
+/**
+ * Deallocate any (successfully) allocated filter bank setup.
+ *
+ * @param filterbank_setup is a pointer to a private structure
+ */
+void
+rta_filterbank_setup_delete(rta_filterbank_setup_t * filterbank_setup);
+
+/**
+ * Set the time constant of the RMS envelopes: the square of each band
+ * is smoothed by a one-pole low-pass filter.
+ *
+ * @param filterbank_setup is a pointer to a private structure
+ * @param envelope_time is the time constant, in seconds. It must be
+ * > 0. (0.125 s is 'fast' and 1 s is 'slow' for sound level meters.)
+ */
+void
+rta_filterbank_setup_set_envelope_time(
+  rta_filterbank_setup_t * filterbank_setup,
+  const rta_real_t envelope_time);
+
+/**
+ * Get the number of bands of a filter bank.
+ *
+ * @param filterbank_setup is a pointer to a private structure
+ *
+ * @return the number of bands, > 0
+ */
+unsigned int
+rta_filterbank_bands(const rta_filterbank_setup_t * filterbank_setup);
+
+/**
+ * Get the centre frequency of a band of a filter bank.
+ *
+ * @param filterbank_setup is a pointer to a private structure
+ * @param band is the index of the band, < rta_filterbank_bands. The
+ * bands are sorted by increasing frequency.
+ *
+ * @return the centre frequency, in Hz
+ */
+rta_real_t
+rta_filterbank_frequency(const rta_filterbank_setup_t * filterbank_setup,
+                         const unsigned int band);
+
+/**
+ * Filter 'frames' samples of a signal by all the bands of a filter
+ * bank.
+ *
+ * It allocates no memory.
+ *
+ * @param output size is 'frames' * 'bands', the bands of a frame
+ * being contiguous. It may be NULL, to get the envelopes only.
+ * @param envelopes size is 'bands': the RMS envelopes at the end of
+ * 'input'. It may be NULL.
+ * @param input size is 'frames'
+ * @param frames is the number of samples to filter
+ * @param filterbank_setup is a pointer to a private structure
+ */
+void
+rta_filterbank_process(rta_real_t * output, rta_real_t * envelopes,
+                       const rta_real_t * input, const unsigned int frames,
+                       rta_filterbank_setup_t * filterbank_setup);
+
+/**
+ * Filter 'frames' samples of a signal by all the bands of a filter
+ * bank.
+ *
+ * It allocates no memory.
+ *
+ * @param output size is 'frames' * 'o_stride', the bands of a frame
+ * being contiguous. It may be NULL, to get the envelopes only.
+ * @param o_stride is the distance between the frames of 'output'. It
+ * must be >= 'bands'.
+ * @param envelopes size is 'bands': the RMS envelopes at the end of
+ * 'input'. It may be NULL.
+ * @param e_stride is 'envelopes' stride
+ * @param input size is 'frames'
+ * @param i_stride is 'input' stride
+ * @param frames is the number of samples to filter
+ * @param filterbank_setup is a pointer to a private structure
+ */
+void
+rta_filterbank_process_stride(
+  rta_real_t * output, const int o_stride,
+  rta_real_t * envelopes, const int e_stride,
+  const rta_real_t * input, const int i_stride,
+  const unsigned int frames,
+  rta_filterbank_setup_t * filterbank_setup);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTA_FILTERBANK_H_ */
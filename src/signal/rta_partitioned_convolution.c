@@ -0,0 +1,660 @@
+/**
+ * @file   rta_partitioned_convolution.c
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_signal
+ *
+ * @brief  Zero-latency convolution by long impulse responses
+ *
+ * Direct form head and overlap-save stages of growing partition
+ * sizes, whose processing is spread over several blocks.
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rta_partitioned_convolution.h"
+#include "rta_correlation.h"
+#include "rta_fft.h"
+#include "rta_int.h"
+#include "rta_stdlib.h" /* memory management */
+
+/*
+ * A stage of 'partitions' partitions of 'size' points convolves the
+ * impulse response from 'offset' on. Its frames of the last fft_size
+ * input points end every 'size' points, at time t, and give the output
+ * points from t - size + offset to t + offset (excluded). As offset >=
+ * 2 * size - 2 * block_size, these points are needed at the earliest
+ * size / block_size - 1 blocks after the end of the frame: the forward
+ * transform is done at the end of the frame, the spectral products are
+ * spread over the following blocks, and the inverse transform is done
+ * on the last one, adding the output to a ring buffer.
+ */
+typedef struct
+{
+  unsigned int size; /* of the partitions, block_size * period */
+  unsigned int fft_size; /* >= 2 * size */
+  unsigned int partitions;
+  unsigned int offset; /* in the impulse response */
+  unsigned int period; /* in blocks, between two frames */
+  unsigned int phase; /* first step, after a clear */
+  unsigned int step; /* in the period, 0 for the end of a frame */
+  unsigned int current; /* delay line index of the last input spectrum */
+  unsigned int frame_end; /* time of the last frame */
+
+  /* packed real spectra of fft_size values (see rta_fft_real_execute) */
+  rta_real_t * impulse_spectra; /* partitions, scaled by 1 / fft_size */
+  rta_real_t * input_spectra; /* delay line of partitions */
+  rta_real_t * input; /* last fft_size input points */
+  rta_real_t * accumulator; /* fft_size values */
+
+  rta_fft_plan_t * fft_plan;
+  rta_fft_setup_t * forward;
+  rta_fft_setup_t * inverse; /* in place */
+} rta_partitioned_convolution_stage_t;
+
+struct rta_partitioned_convolution_setup
+{
+  unsigned int block_size;
+  unsigned int head_size; /* direct form, <= block_size */
+  rta_real_t * head; /* reversed impulse response, head_size points */
+  rta_real_t * head_input; /* head_size - 1 + block_size points */
+
+  rta_partitioned_convolution_stage_t * stages;
+  unsigned int stages_size;
+
+  rta_real_t * ring; /* output of the stages, by time */
+  unsigned int ring_size; /* power of 2 */
+  unsigned int time; /* of the current block, modulo 2^32 */
+
+  rta_real_t worst_cost;
+  rta_real_t average_cost;
+  rta_real_t scale; /* 1, for the FFT setups */
+};
+
+/* estimated floating-point operations of a real FFT of 'fft_size' points */
+static rta_real_t
+fft_cost(const unsigned int fft_size)
+{
+  return 2.5 * fft_size * rta_ilog2(fft_size);
+}
+
+/* number of spectral products at 'step' (see stage_process) */
+static unsigned int
+stage_products(const rta_partitioned_convolution_stage_t * stage,
+               const unsigned int step)
+{
+  return (step + 1) * stage->partitions / stage->period -
+    step * stage->partitions / stage->period;
+}
+
+/* estimated floating-point operations of a stage at 'step' */
+static rta_real_t
+stage_cost(const rta_partitioned_convolution_stage_t * stage,
+           const unsigned int step)
+{
+  rta_real_t cost = 4. * stage->fft_size * stage_products(stage, step);
+
+  if(step == 0)
+  {
+    cost += fft_cost(stage->fft_size);
+  }
+
+  if(step == stage->period - 1)
+  {
+    cost += fft_cost(stage->fft_size) + stage->size;
+  }
+
+  return cost;
+}
+
+/* Start the stages at the steps that lower the most expensive block. */
+/* The largest stages are placed first, over the longest period. */
+static int
+schedule_stages(rta_partitioned_convolution_setup_t * s)
+{
+  int ret = 0;
+  const unsigned int period = (s->stages_size > 0) ?
+    s->stages[s->stages_size - 1].period : 1;
+  rta_real_t * costs = (rta_real_t *) rta_malloc(sizeof(rta_real_t) * period);
+  const rta_real_t block_cost = 2. * s->block_size * s->head_size +
+    s->block_size * (s->stages_size + 1);
+  unsigned int b, k, phase, best_phase;
+  rta_real_t sum;
+
+  if(costs != NULL)
+  {
+    for(b=0; b<period; b++)
+    {
+      costs[b] = block_cost;
+    }
+
+    for(k=s->stages_size; k>0; k--)
+    {
+      rta_partitioned_convolution_stage_t * stage = s->stages + k - 1;
+      rta_real_t best = -1.;
+
+      best_phase = 0;
+      for(phase=0; phase<stage->period; phase++)
+      {
+        rta_real_t worst = 0.;
+
+        for(b=0; b<period; b++)
+        {
+          const rta_real_t cost = costs[b] + stage_cost(
+            stage, (b + stage->period - phase) % stage->period);
+
+          if(cost > worst)
+          {
+            worst = cost;
+          }
+        }
+
+        if(best < 0. || worst < best)
+        {
+          best = worst;
+          best_phase = phase;
+        }
+      }
+
+      /* the first frame ends on block best_phase */
+      stage->phase = (stage->period - best_phase) % stage->period;
+      for(b=0; b<period; b++)
+      {
+        costs[b] += stage_cost(stage, (b + stage->phase) % stage->period);
+      }
+    }
+
+    s->worst_cost = 0.;
+    sum = 0.;
+    for(b=0; b<period; b++)
+    {
+      sum += costs[b];
+      if(costs[b] > s->worst_cost)
+      {
+        s->worst_cost = costs[b];
+      }
+    }
+    s->average_cost = sum / period;
+
+    rta_free(costs);
+    ret = 1;
+  }
+
+  return ret;
+}
+
+static int
+stage_new(rta_partitioned_convolution_stage_t * stage,
+          rta_real_t * scale,
+          const rta_real_t * impulse, const unsigned int impulse_size)
+{
+  int ret = 0;
+  const unsigned int fft_size = stage->fft_size;
+  const rta_real_t normalisation = 1. / (rta_real_t) fft_size;
+  unsigned int p, i, size;
+
+  stage->impulse_spectra = (rta_real_t *)
+    rta_malloc(sizeof(rta_real_t) * stage->partitions * fft_size);
+  stage->input_spectra = (rta_real_t *)
+    rta_malloc(sizeof(rta_real_t) * stage->partitions * fft_size);
+  stage->input = (rta_real_t *) rta_malloc(sizeof(rta_real_t) * fft_size);
+  stage->accumulator = (rta_real_t *)
+    rta_malloc(sizeof(rta_real_t) * fft_size);
+  stage->forward = NULL;
+  stage->inverse = NULL;
+
+  if(stage->impulse_spectra != NULL && stage->input_spectra != NULL &&
+     stage->input != NULL && stage->accumulator != NULL &&
+     rta_fft_plan_acquire(&stage->fft_plan, rta_fft_real_to_complex_1d,
+                          fft_size) != 0)
+  {
+    ret = rta_fft_setup_new_with_plan(
+      &stage->forward, stage->fft_plan, rta_fft_real_to_complex_1d, scale,
+      stage->input, 1, fft_size, stage->accumulator, 1, NULL);
+
+    if(ret != 0)
+    {
+      ret = rta_fft_setup_new_with_plan(
+        &stage->inverse, stage->fft_plan, rta_fft_complex_to_real_1d, scale,
+        stage->accumulator, 1, fft_size >> 1, stage->accumulator, 1, NULL);
+    }
+  }
+  else
+  {
+    stage->fft_plan = NULL;
+  }
+
+  if(ret != 0)
+  {
+    for(p=0; p<stage->partitions; p++)
+    {
+      const unsigned int start = stage->offset + p * stage->size;
+      rta_real_t * h = stage->impulse_spectra + p * fft_size;
+
+      /* partition of size points, zero-padded */
+      size = (impulse_size > start) ? impulse_size - start : 0;
+      if(size > stage->size)
+      {
+        size = stage->size;
+      }
+
+      for(i=0; i<size; i++)
+      {
+        h[i] = impulse[start + i] * normalisation;
+      }
+
+      rta_fft_real_execute(h, h, size, stage->forward, NULL);
+    }
+  }
+
+  return ret;
+}
+
+static void
+stage_delete(rta_partitioned_convolution_stage_t * stage)
+{
+  if(stage->fft_plan != NULL)
+  {
+    rta_fft_setup_delete(stage->forward);
+    rta_fft_setup_delete(stage->inverse);
+    rta_fft_plan_release(stage->fft_plan);
+  }
+
+  if(stage->impulse_spectra != NULL)
+  {
+    rta_free(stage->impulse_spectra);
+  }
+
+  if(stage->input_spectra != NULL)
+  {
+    rta_free(stage->input_spectra);
+  }
+
+  if(stage->input != NULL)
+  {
+    rta_free(stage->input);
+  }
+
+  if(stage->accumulator != NULL)
+  {
+    rta_free(stage->accumulator);
+  }
+  return;
+}
+
+/* accumulation of the products of packed spectra of 'size' values: */
+/* the first two values are the real DC and Nyquist values */
+static void
+spectrum_multiply_add(rta_real_t * accumulator,
+                      const rta_real_t * x, const rta_real_t * h,
+                      const unsigned int size)
+{
+  unsigned int i;
+
+  accumulator[0] += x[0] * h[0];
+  accumulator[1] += x[1] * h[1];
+
+  for(i=2; i<size; i+=2)
+  {
+    accumulator[i] += x[i] * h[i] - x[i+1] * h[i+1];
+    accumulator[i+1] += x[i] * h[i+1] + x[i+1] * h[i];
+  }
+  return;
+}
+
+/* the input block is already in stage->input */
+static void
+stage_process(rta_partitioned_convolution_stage_t * stage,
+              rta_real_t * ring, const unsigned int ring_mask,
+              const unsigned int time, const unsigned int block_size)
+{
+  const unsigned int n = stage->fft_size;
+  const unsigned int first = stage->step * stage->partitions / stage->period;
+  const unsigned int end =
+    (stage->step + 1) * stage->partitions / stage->period;
+  unsigned int i, p, d, t;
+
+  if(stage->step == 0)
+  {
+    stage->current = (stage->current + 1 < stage->partitions) ?
+      stage->current + 1 : 0;
+    stage->frame_end = time + block_size;
+
+    rta_fft_real_execute(stage->input_spectra + stage->current * n,
+                         stage->input, n, stage->forward, NULL);
+
+    /* slide the input by a frame */
+    for(i=0; i<n - stage->size; i++)
+    {
+      stage->input[i] = stage->input[i + stage->size];
+    }
+
+    for(i=0; i<n; i++)
+    {
+      stage->accumulator[i] = 0.;
+    }
+  }
+
+  /* partition p of the impulse by the input spectrum of p frames ago */
+  d = (stage->current + stage->partitions - first) % stage->partitions;
+  for(p=first; p<end; p++)
+  {
+    spectrum_multiply_add(stage->accumulator, stage->input_spectra + d * n,
+                          stage->impulse_spectra + p * n, n);
+    d = (d > 0) ? d - 1 : stage->partitions - 1;
+  }
+
+  if(stage->step == stage->period - 1)
+  {
+    rta_fft_real_execute(stage->accumulator, stage->accumulator, n >> 1,
+                         stage->inverse, NULL);
+
+    /* overlap-save: the last size points are free of circular aliasing */
+    t = stage->frame_end - stage->size + stage->offset;
+    for(i=n - stage->size; i<n; i++, t++)
+    {
+      ring[t & ring_mask] += stage->accumulator[i];
+    }
+  }
+
+  stage->step = (stage->step + 1 < stage->period) ? stage->step + 1 : 0;
+  return;
+}
+
+int
+rta_partitioned_convolution_setup_new(
+  rta_partitioned_convolution_setup_t ** convolution_setup,
+  const rta_real_t * impulse, const unsigned int impulse_size,
+  const unsigned int block_size, const unsigned int max_partition_size)
+{
+  int ret = 0;
+  rta_partitioned_convolution_setup_t * s;
+  unsigned int max_size, size, offset, partitions, k, i;
+
+  if(impulse_size > 0 && block_size > 0)
+  {
+    *convolution_setup = (rta_partitioned_convolution_setup_t *)
+      rta_malloc(sizeof(rta_partitioned_convolution_setup_t));
+  }
+  else
+  {
+    *convolution_setup = NULL;
+  }
+
+  s = *convolution_setup;
+  if(s != NULL)
+  {
+    s->block_size = block_size;
+    s->head_size = (impulse_size < block_size) ? impulse_size : block_size;
+    s->scale = 1.;
+    s->stages = NULL;
+    s->ring = NULL;
+
+    /* block_size * 2^k */
+    for(max_size=block_size;
+        max_size <= max_partition_size >> 1 && max_size <= 0x40000000;
+        max_size <<= 1)
+    {
+    }
+
+    /* 2 partitions per size, then the rest */
+    s->stages_size = 0;
+    for(size=block_size, offset=s->head_size; offset < impulse_size;
+        size <<= 1)
+    {
+      partitions = (impulse_size - offset + size - 1) / size;
+      if(size < max_size && partitions > 2)
+      {
+        partitions = 2;
+      }
+      offset += partitions * size;
+      s->stages_size++;
+    }
+
+    s->head = (rta_real_t *) rta_malloc(sizeof(rta_real_t) * s->head_size);
+    s->head_input = (rta_real_t *)
+      rta_malloc(sizeof(rta_real_t) * (s->head_size - 1 + block_size));
+    if(s->stages_size > 0)
+    {
+      s->stages = (rta_partitioned_convolution_stage_t *)
+        rta_malloc(sizeof(rta_partitioned_convolution_stage_t) *
+                   s->stages_size);
+    }
+
+    ret = s->head != NULL && s->head_input != NULL &&
+      (s->stages_size == 0 || s->stages != NULL);
+
+    for(i=0; i<s->head_size && ret != 0; i++)
+    {
+      s->head[i] = impulse[s->head_size - 1 - i];
+    }
+
+    for(k=0, size=block_size, offset=s->head_size;
+        k<s->stages_size && ret != 0; k++, size <<= 1)
+    {
+      rta_partitioned_convolution_stage_t * stage = s->stages + k;
+
+      partitions = (impulse_size - offset + size - 1) / size;
+      if(size < max_size && partitions > 2)
+      {
+        partitions = 2;
+      }
+
+      stage->size = size;
+      stage->fft_size = rta_fft_size(rta_fft_real_to_complex_1d, 2 * size);
+      stage->partitions = partitions;
+      stage->offset = offset;
+      stage->period = size / block_size;
+
+      ret = stage_new(stage, &s->scale, impulse, impulse_size);
+      if(ret == 0)
+      {
+        /* partly allocated */
+        s->stages_size = k + 1;
+      }
+
+      offset += partitions * size;
+    }
+
+    if(ret != 0)
+    {
+      /* latest output point: before offset + size of the last stage */
+      s->ring_size = rta_inextpow2(offset + 2 * block_size);
+      s->ring = (rta_real_t *) rta_malloc(sizeof(rta_real_t) * s->ring_size);
+      ret = s->ring != NULL && schedule_stages(s);
+    }
+
+    if(ret != 0)
+    {
+      rta_partitioned_convolution_setup_clear(s);
+    }
+    else
+    {
+      rta_partitioned_convolution_setup_delete(s);
+      *convolution_setup = NULL;
+    }
+  }
+
+  return ret;
+}
+
+void
+rta_partitioned_convolution_setup_clear(
+  rta_partitioned_convolution_setup_t * convolution_setup)
+{
+  rta_partitioned_convolution_setup_t * s = convolution_setup;
+  unsigned int i, k;
+
+  for(i=0; i<s->head_size - 1 + s->block_size; i++)
+  {
+    s->head_input[i] = 0.;
+  }
+
+  for(i=0; i<s->ring_size; i++)
+  {
+    s->ring[i] = 0.;
+  }
+
+  for(k=0; k<s->stages_size; k++)
+  {
+    rta_partitioned_convolution_stage_t * stage = s->stages + k;
+
+    for(i=0; i<stage->fft_size; i++)
+    {
+      stage->input[i] = 0.;
+      stage->accumulator[i] = 0.;
+    }
+
+    for(i=0; i<stage->partitions * stage->fft_size; i++)
+    {
+      stage->input_spectra[i] = 0.;
+    }
+
+    stage->step = stage->phase;
+    stage->current = 0;
+    stage->frame_end = 0;
+  }
+
+  s->time = 0;
+  return;
+}
+
+void
+rta_partitioned_convolution_setup_delete(
+  rta_partitioned_convolution_setup_t * convolution_setup)
+{
+  rta_partitioned_convolution_setup_t * s = convolution_setup;
+  unsigned int k;
+
+  if(s != NULL)
+  {
+    if(s->stages != NULL)
+    {
+      for(k=0; k<s->stages_size; k++)
+      {
+        stage_delete(s->stages + k);
+      }
+      rta_free(s->stages);
+    }
+
+    if(s->head != NULL)
+    {
+      rta_free(s->head);
+    }
+
+    if(s->head_input != NULL)
+    {
+      rta_free(s->head_input);
+    }
+
+    if(s->ring != NULL)
+    {
+      rta_free(s->ring);
+    }
+
+    rta_free(s);
+  }
+  return;
+}
+
+rta_real_t
+rta_partitioned_convolution_worst_cost(
+  const rta_partitioned_convolution_setup_t * convolution_setup,
+  rta_real_t * average_cost)
+{
+  if(average_cost != NULL)
+  {
+    *average_cost = convolution_setup->average_cost;
+  }
+  return convolution_setup->worst_cost;
+}
+
+void
+rta_partitioned_convolution_process(
+  rta_real_t * output, const rta_real_t * input,
+  rta_partitioned_convolution_setup_t * convolution_setup)
+{
+  rta_partitioned_convolution_process_stride(output, 1, input, 1,
+                                             convolution_setup);
+  return;
+}
+
+void
+rta_partitioned_convolution_process_stride(
+  rta_real_t * output, const int o_stride,
+  const rta_real_t * input, const int i_stride,
+  rta_partitioned_convolution_setup_t * convolution_setup)
+{
+  rta_partitioned_convolution_setup_t * s = convolution_setup;
+  const unsigned int block_size = s->block_size;
+  const unsigned int history = s->head_size - 1;
+  const unsigned int ring_mask = s->ring_size - 1;
+  unsigned int i, k, t;
+  int j;
+
+  /* all the input is read before any output */
+  for(i=0, j=0; i<block_size; i++, j+=i_stride)
+  {
+    s->head_input[history + i] = input[j];
+  }
+
+  for(k=0; k<s->stages_size; k++)
+  {
+    rta_partitioned_convolution_stage_t * stage = s->stages + k;
+    /* the block ending a frame is written last */
+    const unsigned int position = stage->fft_size - stage->size +
+      ((stage->step + stage->period - 1) % stage->period) * block_size;
+
+    for(i=0; i<block_size; i++)
+    {
+      stage->input[position + i] = s->head_input[history + i];
+    }
+
+    stage_process(stage, s->ring, ring_mask, s->time, block_size);
+  }
+
+  /* direct form head, then the output of the stages */
+  rta_correlation_fast_stride(output, o_stride, block_size,
+                              s->head_input, 1, s->head, 1, s->head_size);
+
+  for(i=0, j=0, t=s->time; i<block_size; i++, j+=o_stride, t++)
+  {
+    output[j] += s->ring[t & ring_mask];
+    s->ring[t & ring_mask] = 0.;
+  }
+
+  for(i=0; i<history; i++)
+  {
+    s->head_input[i] = s->head_input[i + block_size];
+  }
+
+  s->time += block_size;
+  return;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file   rta_partitioned_convolution.h
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_signal
+ *
+ * @brief  Zero-latency convolution by long impulse responses
+ *
+ * Non-uniformly partitioned convolution: the first points of the
+ * impulse response are convolved in the direct form, and the
+ * following ones by uniformly partitioned overlap-save stages (see
+ * rta_convolution.h) of growing partition sizes. The Fourier
+ * transforms and spectral products of each stage are spread over the
+ * blocks of its partition size, so that the cost of each block stays
+ * close to the average one.
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _RTA_PARTITIONED_CONVOLUTION_H_
+#define _RTA_PARTITIONED_CONVOLUTION_H_ 1
+
+#include "rta.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* rta_partitioned_convolution_setup is private (depends on implementation) */
+typedef struct rta_partitioned_convolution_setup
+rta_partitioned_convolution_setup_t;
+
+/**
+ * Allocate and initialize a partitioned convolution setup, for an
+ * impulse response processed by blocks of 'block_size' points.
+ *
+ * The first 'block_size' points of the impulse response are convolved
+ * in the direct form (see rta_correlation_fast). The following ones
+ * are cut in 2 partitions of 'block_size' points, then 2 of 2 *
+ * 'block_size' points, and so on, up to 'max_partition_size' points
+ * for the rest of the impulse response. All the memory is allocated
+ * here, and the state is cleared.
+ *
+ * There is no latency: as the direct form covers the first block of
+ * the impulse response, each output block depends on the input block
+ * of the same processing, and the partitions are scheduled to be
+ * ready when their output is due.
+ *
+ * \see rta_partitioned_convolution_setup_delete
+ * \see rta_partitioned_convolution_process
+ *
+ * @param convolution_setup is an address of a pointer to a private
+ * structure. This function allocates 'convolution_setup' and fills it.
+ * @param impulse is the impulse response, of size 'impulse_size'
+ * @param impulse_size must be > 0
+ * @param block_size is the number of points of each processing. It
+ * must be > 0.
+ * @param max_partition_size is the maximum size of the partitions. It
+ * is rounded down to 'block_size' times a power of 2. Larger
+ * partitions cost less on average, but more on the worst block (see
+ * rta_partitioned_convolution_worst_cost).
+ *
+ * @return 1 on success 0 on fail. If it fails, nothing should be done
+ * with 'convolution_setup' (even a delete).
+ */
+int
+rta_partitioned_convolution_setup_new(
+  rta_partitioned_convolution_setup_t ** convolution_setup,
+  const rta_real_t * impulse, const unsigned int impulse_size,
+  const unsigned int block_size, const unsigned int max_partition_size);
+
+/**
+ * Clear the input of a partitioned convolution setup, as after its
+ * allocation.
+ *
+ * @param convolution_setup is a pointer to a private structure
+ */
+void
+rta_partitioned_convolution_setup_clear(
+  rta_partitioned_convolution_setup_t * convolution_setup);
+
+/**
+ * Deallocate any (successfully) allocated partitioned convolution
+ * setup.
+ *
+ * @param convolution_setup is a pointer to a private structure
+ */
+void
+rta_partitioned_convolution_setup_delete(
+  rta_partitioned_convolution_setup_t * convolution_setup);
+
+/**
+ * Worst-case cost of the processing of a block, as estimated at the
+ * setup from the sizes of the transforms and of the direct form.
+ *
+ * @param convolution_setup is a pointer to a private structure
+ * @param average_cost is an address to store the average cost of a
+ * block. It may be NULL.
+ *
+ * @return the estimated number of floating-point operations of the
+ * most expensive block
+ */
+rta_real_t
+rta_partitioned_convolution_worst_cost(
+  const rta_partitioned_convolution_setup_t * convolution_setup,
+  rta_real_t * average_cost);
+
+/**
+ * Convolve the next block of 'block_size' points of a signal by the
+ * impulse response of 'convolution_setup'.
+ *
+ * \f$y(n) = \sum_{i=0}^{impulse\_size-1} h(i) \cdot x(n-i)\f$
+ *
+ * where x is the concatenation of all the input blocks since the
+ * setup (or since rta_partitioned_convolution_setup_clear). This
+ * function can run in place if 'output' == 'input'. It allocates no
+ * memory.
+ *
+ * @param output size is 'block_size'
+ * @param input size is 'block_size'
+ * @param convolution_setup is a pointer to a private structure
+ */
+void
+rta_partitioned_convolution_process(
+  rta_real_t * output, const rta_real_t * input,
+  rta_partitioned_convolution_setup_t * convolution_setup);
+
+/**
+ * Convolve the next block of 'block_size' points of a signal by the
+ * impulse response of 'convolution_setup'.
+ *
+ * \f$y(n) = \sum_{i=0}^{impulse\_size-1} h(i) \cdot x(n-i)\f$
+ *
+ * where x is the concatenation of all the input blocks since the
+ * setup (or since rta_partitioned_convolution_setup_clear). This
+ * function can run in place if 'output' == 'input' and 'o_stride' ==
+ * 'i_stride'. It allocates no memory.
+ *
+ * @param output size is 'block_size'
+ * @param o_stride is 'output' stride
+ * @param input size is 'block_size'
+ * @param i_stride is 'input' stride
+ * @param convolution_setup is a pointer to a private structure
+ */
+void
+rta_partitioned_convolution_process_stride(
+  rta_real_t * output, const int o_stride,
+  const rta_real_t * input, const int i_stride,
+  rta_partitioned_convolution_setup_t * convolution_setup);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTA_PARTITIONED_CONVOLUTION_H_ */
@@ -42,32 +42,24 @@
 
 #include "rta_psy.h"
 
-#if defined(__APPLE__) && defined(__MACH__) && \
-(RTA_REAL_TYPE == RTA_FLOAT_TYPE || RTA_REAL_TYPE == RTA_DOUBLE_TYPE)
-
-#include <Accelerate/Accelerate.h>
-#define yinAutocorr(i, c, n, m) vDSP_conv((i), 1, (i), 1, (c), 1, (n), (m));
-
-#else
-
+/* add (or subtract) the products of m points to running auto-correlation sums, */
+/* in double precision to avoid any drift */
 static void
-yinAutocorr(float *in, float *corr, int n, int m)
+yinAutocorrAccumulate(float *in, double *sums, int n, int m, double sign)
 {
   int i, j;
 
   for(i = 0; i < n; i++)
   {
-    float c = 0.0;
+    double c = 0.0;
 
     for(j = 0; j < m; j++)
-      c += in[j] * in[i + j];
+      c += (double)in[j] * in[i + j];
 
-    corr[i] = c;
+    sums[i] += sign * c;
   }
 }
 
-#endif
-
 #define REF_FREQ 440.0
 #define REF_PITCH 6900.0
 
@@ -77,6 +69,51 @@ yinAutocorr(float *in, float *corr, int n, int m)
 #define MIN_ANALYSIS_LAG 10
 #define MAX_LAG_HIGH 128
 
+/* remove the products of the first shift input samples, leaving the analysis window */
+static void
+removeAutocorr(rta_psy_ana_t *self, int shift)
+{
+  int nCorr = (int)ceil(self->maxPeriod);
+
+  /* from scratch when cheaper than the removal and the addition of the products */
+  if(self->corrShift >= 0 && 2 * (self->corrShift + shift) < nCorr)
+  {
+    yinAutocorrAccumulate(self->inputBuffer, self->corrSums, nCorr, shift, -1.0);
+    self->corrShift += shift;
+  }
+  else
+  {
+    self->corrShift = -1;
+  }
+}
+
+/* add the products of the input samples entering the analysis window, auto-correlation into corrBuffer */
+static void
+updateAutocorr(rta_psy_ana_t *self)
+{
+  float *input = self->inputBuffer;
+  int nCorr = (int)ceil(self->maxPeriod);
+  int shift = self->corrShift;
+  int i;
+
+  if(shift < 0)
+  {
+    for(i = 0; i < nCorr; i++)
+      self->corrSums[i] = 0.0;
+
+    yinAutocorrAccumulate(input, self->corrSums, nCorr, nCorr, 1.0);
+  }
+  else if(shift > 0)
+  {
+    yinAutocorrAccumulate(input + nCorr - shift, self->corrSums, nCorr, shift, 1.0);
+  }
+
+  for(i = 0; i < nCorr; i++)
+    self->corrBuffer[i] = self->corrSums[i];
+
+  self->corrShift = 0;
+}
+
 static int
 estimateCandidates(float *input, float *corrBuffer, double maxPeriod, double minPeriod, double noiseThreshold, rta_psy_candidate_t *candidates)
 {
@@ -91,8 +128,7 @@ estimateCandidates(float *input, float *corrBuffer, double maxPeriod, double min
   candidates[0].period = maxPeriod;
   candidates[0].normDiff = 1.0;
 
-  /* auto-correlation */
-  yinAutocorr(input, corrBuffer, nCorr, nCorr);
+  /* auto-correlation in corrBuffer (see updateAutocorr) */
 
   /* diff[0] */
   x = input[0];
@@ -254,6 +290,7 @@ estimateAndTraceCandidates(rta_psy_ana_t *self, rta_psy_tracking_state_t *tracki
   int i;
 
   /* calculate candidates (assigns period and normDiff) */
+  updateAutocorr(self);
   state->numCandidates = estimateCandidates(self->inputBuffer, self->corrBuffer, self->maxPeriod, self->minPeriod, self->noiseThreshold, state->candidates);
 
   state->time = time;
@@ -357,6 +394,8 @@ rta_psy_init(rta_psy_ana_t *self)
 
   /* autocorrelation buffer */
   self->corrBuffer = NULL;
+  self->corrSums = NULL;
+  self->corrShift = -1;
   self->maxCorrBufferSize = 0;
   self->corrBufferSize = 0;
 
@@ -392,6 +431,9 @@ rta_psy_deinit(rta_psy_ana_t *self)
 
   if(self->corrBuffer != NULL)
     rta_psy_free(self->corrBuffer);
+
+  if(self->corrSums != NULL)
+    rta_psy_free(self->corrSums);
 }
 
 void
@@ -430,6 +472,7 @@ rta_psy_reset(rta_psy_ana_t *self, double minFreq, double maxFreq, double sample
   if(self->corrBufferSize > self->maxCorrBufferSize)
   {
     self->corrBuffer = (float *)rta_psy_realloc(self->corrBuffer, sizeof(float) * self->corrBufferSize);
+    self->corrSums = (double *)rta_psy_realloc(self->corrSums, sizeof(double) * self->corrBufferSize);
     self->maxCorrBufferSize = self->corrBufferSize;
   }
 
@@ -454,6 +497,7 @@ rta_psy_reset(rta_psy_ana_t *self, double minFreq, double maxFreq, double sample
   self->inputTime = 0;
   self->inputFill = 0;
   self->outputTime = 0.0;
+  self->corrShift = -1;
 
   for(i = 0; i < RTA_PSY_NUM_TRACKING_STATES; i++)
   {
@@ -502,13 +546,57 @@ rta_psy_set_thresholds(rta_psy_ana_t *self, double yinThreshold, double noiseThr
   self->noiseThreshold = noiseThreshold * noiseThreshold;
 }
 
+/* analyse the downVectorSize samples appended to the input buffer, 0 if a callback stopped */
+static int
+analyseInput(rta_psy_ana_t *self, int downVectorSize)
+{
+  double outputTime = self->outputTime;
+  int maxTime;
+  int i;
+
+  self->inputFill += downVectorSize;
+  maxTime = self->inputTime + self->inputFill - 2 * (int)self->absMaxPeriod;
+
+  while(maxTime > (int)outputTime)
+  {
+    double period = estimateAndTraceCandidates(self, self->trackingStates, self->trackingIndex, outputTime);
+    int shift;
+
+    /* advance tracking index */
+    self->trackingIndex = (self->trackingIndex + 1) % RTA_PSY_NUM_TRACKING_STATES;
+
+    if(reportState(self, self->trackingStates, self->trackingIndex) == 0)
+      return 0;
+
+    /* advance time */
+    outputTime += period;
+
+    /* shift input buffers */
+    shift = ((int)(outputTime - self->inputTime) - 1); /* always keep one input sample */
+
+    if(shift > 0)
+    {
+      removeAutocorr(self, shift);
+
+      for(i = 0; i < self->inputFill; i++)
+        self->inputBuffer[i] = self->inputBuffer[i + shift];
+
+      self->inputFill -= shift;
+      self->inputTime += shift;
+      maxTime -= shift;
+    }
+  }
+
+  self->outputTime = outputTime;
+
+  return 1;
+}
+
 int
 rta_psy_calculate_input_vector(rta_psy_ana_t *self, float *in, int vectorSize, int vectorStride)
 {
   int downVectorSize = vectorSize >> self->downSamplingExp;
   float *inputBuffer = self->inputBuffer + self->inputFill;
-  double outputTime = self->outputTime;
-  int maxTime;
   int i, j;
 
   if(downVectorSize > 0)
@@ -529,7 +617,7 @@ rta_psy_calculate_input_vector(rta_psy_ana_t *self, float *in, int vectorSize, i
       {
         for(i = 0, j = 0; i < downVectorSize; i++, j += 4 * vectorStride)
           inputBuffer[i] = 0.25 * (in[j] + in[j + vectorStride] +
-                                   in[j + 2 * vectorStride] + in[j + 3] * vectorStride);
+                                   in[j + 2 * vectorStride] + in[j + 3 * vectorStride]);
 
         break;
       }
@@ -559,38 +647,205 @@ rta_psy_calculate_input_vector(rta_psy_ana_t *self, float *in, int vectorSize, i
     inputBuffer[0] = sum / (float)vectorSize;
   }
 
-  self->inputFill += downVectorSize;
-  maxTime = self->inputTime + self->inputFill - 2 * (int)self->absMaxPeriod;
+  if(analyseInput(self, downVectorSize) == 0)
+    return 0;
 
-  while(maxTime > (int)outputTime)
+  return vectorSize;
+}
+
+/* multichannel analysis */
+
+/* store a result of a channel in the outputs of the input vector */
+static int
+multiChannelCallback(void *receiver, double time, double freq, double energy, double ac1, double voiced)
+{
+  rta_psy_multi_channel_t *channel = (rta_psy_multi_channel_t *)receiver;
+  rta_psy_multi_ana_t *multi = channel->multi;
+  int n = multi->numOutputs[channel->index];
+  rta_psy_output_t *output;
+
+  /* keep the latest result if ever more than expected */
+  if(n < multi->maxOutputs)
+    multi->numOutputs[channel->index] = n + 1;
+  else
+    n = multi->maxOutputs - 1;
+
+  output = multi->outputs + channel->index * multi->maxOutputs + n;
+  output->time = time;
+  output->freq = freq;
+  output->energy = energy;
+  output->ac1 = ac1;
+  output->voiced = voiced;
+
+  return 1;
+}
+
+void
+rta_psy_multi_init(rta_psy_multi_ana_t *self)
+{
+  self->channels = NULL;
+  self->numChannels = 0;
+  self->maxChannels = 0;
+
+  self->downBuffer = NULL;
+  self->maxDownBufferSize = 0;
+
+  self->outputs = NULL;
+  self->numOutputs = NULL;
+  self->maxOutputs = 0;
+  self->maxOutputBufferSize = 0;
+
+  self->receiver = NULL;
+  self->callback = NULL;
+}
+
+void
+rta_psy_multi_deinit(rta_psy_multi_ana_t *self)
+{
+  int i;
+
+  for(i = 0; i < self->maxChannels; i++)
+    rta_psy_deinit(&self->channels[i].ana);
+
+  if(self->channels != NULL)
+    rta_psy_free(self->channels);
+
+  if(self->downBuffer != NULL)
+    rta_psy_free(self->downBuffer);
+
+  if(self->outputs != NULL)
+    rta_psy_free(self->outputs);
+
+  if(self->numOutputs != NULL)
+    rta_psy_free(self->numOutputs);
+}
+
+void
+rta_psy_multi_reset(rta_psy_multi_ana_t *self, int numChannels, double minFreq, double maxFreq, double sampleRate, int maxInputVectorSize, int downSamplingExp)
+{
+  int downBufferSize, outputBufferSize;
+  int i;
+
+  if(numChannels < 1)
+    numChannels = 1;
+
+  if(numChannels > self->maxChannels)
   {
-    double period = estimateAndTraceCandidates(self, self->trackingStates, self->trackingIndex, outputTime);
-    int shift;
+    self->channels = (rta_psy_multi_channel_t *)rta_psy_realloc(self->channels, sizeof(rta_psy_multi_channel_t) * numChannels);
+    self->numOutputs = (int *)rta_psy_realloc(self->numOutputs, sizeof(int) * numChannels);
 
-    /* advance tracking index */
-    self->trackingIndex = (self->trackingIndex + 1) % RTA_PSY_NUM_TRACKING_STATES;
+    for(i = self->maxChannels; i < numChannels; i++)
+      rta_psy_init(&self->channels[i].ana);
 
-    if(reportState(self, self->trackingStates, self->trackingIndex) == 0)
-      return 0;
+    self->maxChannels = numChannels;
+  }
 
-    /* advance time */
-    outputTime += period;
+  /* the channels are moved by the reallocation */
+  for(i = 0; i < numChannels; i++)
+  {
+    rta_psy_multi_channel_t *channel = self->channels + i;
 
-    /* shift input buffers */
-    shift = ((int)(outputTime - self->inputTime) - 1); /* always keep one input sample */
+    channel->multi = self;
+    channel->index = i;
+    rta_psy_reset(&channel->ana, minFreq, maxFreq, sampleRate, maxInputVectorSize, downSamplingExp);
+    rta_psy_set_callback(&channel->ana, channel, multiChannelCallback);
+  }
 
-    if(shift > 0)
+  self->numChannels = numChannels;
+
+  downBufferSize = ((maxInputVectorSize >> self->channels[0].ana.downSamplingExp) + 1) * numChannels;
+
+  if(downBufferSize > self->maxDownBufferSize)
+  {
+    self->downBuffer = (float *)rta_psy_realloc(self->downBuffer, sizeof(float) * downBufferSize);
+    self->maxDownBufferSize = downBufferSize;
+  }
+
+  /* the analysis frames are at least the minimum period apart */
+  self->maxOutputs = (int)((maxInputVectorSize >> self->channels[0].ana.downSamplingExp) / self->channels[0].ana.absMinPeriod) + 2;
+  outputBufferSize = self->maxOutputs * numChannels;
+
+  if(outputBufferSize > self->maxOutputBufferSize)
+  {
+    self->outputs = (rta_psy_output_t *)rta_psy_realloc(self->outputs, sizeof(rta_psy_output_t) * outputBufferSize);
+    self->maxOutputBufferSize = outputBufferSize;
+  }
+
+  for(i = 0; i < numChannels; i++)
+    self->numOutputs[i] = 0;
+}
+
+void
+rta_psy_multi_set_callback(rta_psy_multi_ana_t *self, void *receiver, int (*callback)(void *receiver, int numChannels, const int *numOutputs, const rta_psy_output_t *outputs, int maxOutputs))
+{
+  self->receiver = receiver;
+  self->callback = callback;
+}
+
+void
+rta_psy_multi_set_thresholds(rta_psy_multi_ana_t *self, double yinThreshold, double noiseThreshold)
+{
+  int i;
+
+  for(i = 0; i < self->numChannels; i++)
+    rta_psy_set_thresholds(&self->channels[i].ana, yinThreshold, noiseThreshold);
+}
+
+int
+rta_psy_multi_calculate_input_vector(rta_psy_multi_ana_t *self, float *in, int vectorSize)
+{
+  int numChannels = self->numChannels;
+  int downSampling = self->channels[0].ana.downSampling;
+  int downVectorSize = vectorSize >> self->channels[0].ana.downSamplingExp;
+  float scale = 1.0 / (float)downSampling;
+  float *down = self->downBuffer;
+  int results = 0;
+  int i, j, c;
+
+  /* downsampling by the mean of consecutive frames, all the channels of a frame together */
+  for(i = 0; i < downVectorSize; i++)
+  {
+    float *frame = in + i * downSampling * numChannels;
+    float *out = down + i * numChannels;
+
+    for(c = 0; c < numChannels; c++)
+      out[c] = frame[c];
+
+    for(j = 1; j < downSampling; j++)
     {
-      for(i = 0; i < self->inputFill; i++)
-        self->inputBuffer[i] = self->inputBuffer[i + shift];
+      frame += numChannels;
 
-      self->inputFill -= shift;
-      self->inputTime += shift;
-      maxTime -= shift;
+      for(c = 0; c < numChannels; c++)
+        out[c] += frame[c];
+    }
+
+    if(downSampling > 1)
+    {
+      for(c = 0; c < numChannels; c++)
+        out[c] *= scale;
     }
   }
 
-  self->outputTime = outputTime;
+  /* pitch-synchronous analysis of each channel, into the outputs */
+  for(c = 0; c < numChannels; c++)
+  {
+    rta_psy_ana_t *ana = &self->channels[c].ana;
+    float *inputBuffer = ana->inputBuffer + ana->inputFill;
+
+    for(i = 0, j = c; i < downVectorSize; i++, j += numChannels)
+      inputBuffer[i] = down[j];
+
+    self->numOutputs[c] = 0;
+    analyseInput(ana, downVectorSize);
+    results += self->numOutputs[c];
+  }
+
+  /* one callback for all the results of the input vector */
+  if(results > 0 && self->callback != NULL)
+  {
+    if((*self->callback)(self->receiver, numChannels, self->numOutputs, self->outputs, self->maxOutputs) == 0)
+      return 0;
+  }
 
   return vectorSize;
 }
@@ -91,6 +91,8 @@ typedef struct PsyAnaSt
   double maxPeriod; /* current maximum analysis period (last sure period * ambitus) */
 
   float *corrBuffer; /* temporary correlation coefficient buffer */
+  double *corrSums; /* running auto-correlation of the analysis window */
+  int corrShift; /* input shift since the last update of corrSums (-1 if invalid) */
   int corrBufferSize; /* current maximum correlation window size (>= max period) */
   int maxCorrBufferSize; /* maximum correlation buffer size */
 
@@ -124,4 +126,50 @@ void rta_psy_set_thresholds(rta_psy_ana_t *self, double yinThreshold, double noi
 int rta_psy_calculate_input_vector(rta_psy_ana_t *self, float *in, int vectorSize, int vectorStride);
 void rta_psy_finalize(rta_psy_ana_t *self);
 
+/* result of an analysis frame of a channel */
+typedef struct PsyOutputSt
+{
+  double time; /* in msec */
+  double freq;
+  double energy;
+  double ac1;
+  double voiced;
+} rta_psy_output_t;
+
+/* multichannel analyser of interleaved input, one rta_psy_ana_t per channel */
+typedef struct PsyMultiChannelSt
+{
+  rta_psy_ana_t ana;
+  struct PsyMultiAnaSt *multi;
+  int index; /* channel index */
+} rta_psy_multi_channel_t;
+
+typedef struct PsyMultiAnaSt
+{
+  rta_psy_multi_channel_t *channels;
+  int numChannels; /* current number of channels */
+  int maxChannels; /* number of allocated channels */
+
+  float *downBuffer; /* downsampled interleaved input vector */
+  int maxDownBufferSize;
+
+  /* results of the channels for the last input vector (pitch synchronous, so their number and times differ) */
+  rta_psy_output_t *outputs; /* maxOutputs results per channel, channel c from outputs + c * maxOutputs */
+  int *numOutputs; /* number of results of each channel */
+  int maxOutputs; /* maximum number of results of a channel per input vector */
+  int maxOutputBufferSize;
+
+  void *receiver;
+  int (*callback)(void *obj, int numChannels, const int *numOutputs, const rta_psy_output_t *outputs, int maxOutputs);
+} rta_psy_multi_ana_t;
+
+void rta_psy_multi_init(rta_psy_multi_ana_t *self);
+void rta_psy_multi_deinit(rta_psy_multi_ana_t *self);
+void rta_psy_multi_reset(rta_psy_multi_ana_t *self, int numChannels, double minFreq, double maxFreq, double sampleRate, int maxInputVectorSize, int downSamplingExp);
+
+/* callback after each input vector giving results, with the results of all channels (or read outputs and numOutputs) */
+void rta_psy_multi_set_callback(rta_psy_multi_ana_t *self, void *receiver, int (*callback)(void *receiver, int numChannels, const int *numOutputs, const rta_psy_output_t *outputs, int maxOutputs));
+void rta_psy_multi_set_thresholds(rta_psy_multi_ana_t *self, double yinThreshold, double noiseThreshold);
+int rta_psy_multi_calculate_input_vector(rta_psy_multi_ana_t *self, float *in, int vectorSize);
+
 #endif  /* _RTA_PSY_H_ */
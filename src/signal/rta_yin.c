@@ -44,7 +44,12 @@
 #include "rta_yin.h"
 
 #include "rta_stdlib.h" /* rta_malloc, rta_free */
-#include "rta_correlation.h" /* rta_correlation_fast */
+#include "rta_correlation.h" /* rta_correlation_fast(_double) */
+#include "rta_math.h" /* rta_sqrt */
+
+/* windows of input between two full calculations of the sliding */
+/* autocorrelation, to bound its rounding errors */
+#define RTA_YIN_SLIDING_REFRESH 64
 
 /* private structure for yin minima search */
 typedef struct rta_yin_mins rta_yin_mins_t;
@@ -59,6 +64,23 @@ struct rta_yin_setup
 {
   unsigned int max_mins;
   rta_yin_mins_t * mins;
+  /* for ac_size and window_size, or NULL for rta_correlation_fast */
+  rta_correlation_setup_t * correlation;
+  unsigned int ac_size;
+  unsigned int window_size;
+};
+
+/* public typedef, private structure */
+struct rta_yin_sliding_setup
+{
+  rta_yin_setup_t * yin_setup;
+  unsigned int ac_size;
+  unsigned int input_size;
+  rta_real_t * buffer; /* 2 * input_size points */
+  unsigned int start; /* of the frame in buffer */
+  unsigned int refresh; /* input points since the last full calculation */
+  double * sums; /* autocorrelation of the frame, ac_size values */
+  double * products; /* ac_size values */
 };
 
 int rta_yin_setup_new(rta_yin_setup_t ** yin_setup, unsigned int max_mins)
@@ -74,6 +96,7 @@ int rta_yin_setup_new(rta_yin_setup_t ** yin_setup, unsigned int max_mins)
     if((*yin_setup)->mins != NULL)
     {
       (*yin_setup)->max_mins = max_mins;
+      (*yin_setup)->correlation = NULL;
       ret = 1;
     }
     else
@@ -86,6 +109,40 @@ int rta_yin_setup_new(rta_yin_setup_t ** yin_setup, unsigned int max_mins)
   return ret;
 }
 
+int rta_yin_setup_new_with_method(rta_yin_setup_t ** yin_setup,
+                                  unsigned int max_mins,
+                                  const unsigned int ac_size,
+                                  const unsigned int input_size,
+                                  const rta_correlation_method_t method)
+{
+  int ret = 0;
+
+  if(ac_size < input_size && rta_yin_setup_new(yin_setup, max_mins) != 0)
+  {
+    (*yin_setup)->ac_size = ac_size;
+    (*yin_setup)->window_size = input_size - ac_size;
+
+    if(rta_correlation_setup_new(&(*yin_setup)->correlation, ac_size,
+                                 input_size - ac_size) != 0)
+    {
+      ret = rta_correlation_setup_set_method((*yin_setup)->correlation,
+                                             method);
+    }
+    else
+    {
+      (*yin_setup)->correlation = NULL;
+    }
+
+    if(ret == 0)
+    {
+      rta_yin_setup_delete(*yin_setup);
+      *yin_setup = NULL;
+    }
+  }
+
+  return ret;
+}
+
 void rta_yin_setup_delete(rta_yin_setup_t * yin_setup)
 {
   if(yin_setup != NULL)
@@ -94,6 +151,11 @@ void rta_yin_setup_delete(rta_yin_setup_t * yin_setup)
     {
       rta_free(yin_setup->mins);
     }
+
+    if(yin_setup->correlation != NULL)
+    {
+      rta_correlation_setup_delete(yin_setup->correlation);
+    }
     rta_free(yin_setup);
   }
   return;
@@ -130,7 +192,16 @@ rta_real_t rta_yin(
   *abs_min = 1.;
     
   /* auto-correlation */
-  rta_correlation_fast(autocorrelation, ac_size, input, input, window_size);
+  if(yin_setup->correlation != NULL &&
+     yin_setup->ac_size == ac_size && yin_setup->window_size == window_size)
+  {
+    rta_correlation_fast_execute(autocorrelation, input, input,
+                                 yin_setup->correlation);
+  }
+  else
+  {
+    rta_correlation_fast(autocorrelation, ac_size, input, input, window_size);
+  }
     
   /* diff[0] */
   x = input[0];
@@ -205,15 +276,39 @@ rta_real_t rta_yin(
   return abs_lag;
 }
 
-/* Contract: input_size > ac_size */
-/*           input_size / 2 >= ac_size for good results */
-/*           threshold in [0., 1.] == (1. - confidence)^2 */
-rta_real_t rta_yin_stride(
-  rta_real_t * abs_min,
+/* autocorrelation by the correlation setup of yin_setup, if any for */
+/* these sizes */
+static void yin_autocorrelation_stride(
   rta_real_t * autocorrelation, const int ac_stride,
+  const unsigned int ac_size,
+  const rta_real_t * input, const int i_stride,
+  const unsigned int window_size,
+  const rta_yin_setup_t * yin_setup)
+{
+  if(yin_setup->correlation != NULL &&
+     yin_setup->ac_size == ac_size && yin_setup->window_size == window_size)
+  {
+    rta_correlation_fast_execute_stride(autocorrelation, ac_stride,
+                                        input, i_stride, input, i_stride,
+                                        yin_setup->correlation);
+  }
+  else
+  {
+    rta_correlation_fast_stride(autocorrelation, ac_stride, ac_size, 
+                                input, i_stride, input, i_stride,
+                                window_size);
+  }
+  return;
+}
+
+/* minimum search on the difference function, from the autocorrelation */
+/* of a window of 'window_size' points of 'input' */
+static rta_real_t yin_search_stride(
+  rta_real_t * abs_min,
+  const rta_real_t * autocorrelation, const int ac_stride,
   const unsigned int ac_size, 
   const rta_real_t * input, const int i_stride,
-  const unsigned int input_size,
+  const unsigned int window_size,
   const rta_yin_setup_t * yin_setup,
   const rta_real_t threshold)
 {
@@ -235,16 +330,10 @@ rta_real_t rta_yin_stride(
   unsigned int i;          /* input sample index */
   int is;                  /* input sample index with stride */
   int ac;            /* autocorrelation index */
-  const unsigned int window_size = input_size - ac_size;
   const unsigned int window_size_stride = window_size * i_stride;
 
   *abs_min = 1.;
-    
-  /* auto-correlation */
-  rta_correlation_fast_stride(autocorrelation, ac_stride, ac_size, 
-                              input, i_stride, input, i_stride,
-                              window_size);
-    
+
   /* diff[0] */
   x = input[0];
   xm = input[window_size_stride];
@@ -319,3 +408,283 @@ rta_real_t rta_yin_stride(
 
   return abs_lag;
 }
+
+/* Contract: input_size > ac_size */
+/*           input_size / 2 >= ac_size for good results */
+/*           threshold in [0., 1.] == (1. - confidence)^2 */
+rta_real_t rta_yin_stride(
+  rta_real_t * abs_min,
+  rta_real_t * autocorrelation, const int ac_stride,
+  const unsigned int ac_size, 
+  const rta_real_t * input, const int i_stride,
+  const unsigned int input_size,
+  const rta_yin_setup_t * yin_setup,
+  const rta_real_t threshold)
+{
+  const unsigned int window_size = input_size - ac_size;
+
+  yin_autocorrelation_stride(autocorrelation, ac_stride, ac_size,
+                             input, i_stride, window_size, yin_setup);
+
+  return yin_search_stride(abs_min, autocorrelation, ac_stride, ac_size,
+                           input, i_stride, window_size,
+                           yin_setup, threshold);
+}
+
+/* Contract: input_size > ac_size */
+/*           input_size / 2 >= ac_size for good results */
+/*           threshold in [0., 1.] == (1. - confidence)^2 */
+void rta_yin_batch(
+  rta_real_t * lags, rta_real_t * abs_mins, rta_real_t * energies,
+  rta_real_t * autocorrelation, const unsigned int ac_size,
+  const rta_real_t * input, const int i_stride, const int frame_stride,
+  const unsigned int input_size, const unsigned int frames,
+  const rta_yin_setup_t * yin_setup,
+  const rta_real_t threshold)
+{
+  const unsigned int window_size = input_size - ac_size;
+  const int setup_sizes = yin_setup->correlation != NULL &&
+    yin_setup->ac_size == ac_size && yin_setup->window_size == window_size;
+  unsigned int f;
+
+  /* auto-correlations, lag by lag for all the frames */
+  if(frame_stride == 1 && i_stride >= (int) frames && setup_sizes == 0)
+  {
+    rta_correlation_fast_interleaved(autocorrelation, frames, ac_size,
+                                     input, input, i_stride, frames,
+                                     window_size);
+  }
+  else
+  {
+    for(f=0; f<frames; f++)
+    {
+      yin_autocorrelation_stride(autocorrelation + f, frames, ac_size,
+                                 input + f * frame_stride, i_stride,
+                                 window_size, yin_setup);
+    }
+  }
+
+  for(f=0; f<frames; f++)
+  {
+    lags[f] = yin_search_stride(abs_mins + f, autocorrelation + f, frames,
+                                ac_size, input + f * frame_stride, i_stride,
+                                window_size, yin_setup, threshold);
+
+    if(energies != NULL)
+    {
+      energies[f] = rta_sqrt(autocorrelation[f] / window_size);
+    }
+  }
+
+  return;
+}
+
+int rta_yin_sliding_setup_new(rta_yin_sliding_setup_t ** yin_setup,
+                              const unsigned int max_mins,
+                              const unsigned int ac_size,
+                              const unsigned int input_size)
+{
+  int ret = 0;
+  rta_yin_sliding_setup_t * s;
+
+  if(ac_size < input_size)
+  {
+    *yin_setup = (rta_yin_sliding_setup_t *)
+      rta_malloc(sizeof(rta_yin_sliding_setup_t));
+  }
+  else
+  {
+    *yin_setup = NULL;
+  }
+
+  s = *yin_setup;
+  if(s != NULL)
+  {
+    s->ac_size = ac_size;
+    s->input_size = input_size;
+    s->buffer = (rta_real_t *) rta_malloc(sizeof(rta_real_t) * 2 * input_size);
+    s->sums = (double *) rta_malloc(sizeof(double) * ac_size);
+    s->products = (double *) rta_malloc(sizeof(double) * ac_size);
+
+    if(rta_yin_setup_new(&s->yin_setup, max_mins) == 0)
+    {
+      s->yin_setup = NULL;
+    }
+
+    if(s->buffer != NULL && s->sums != NULL && s->products != NULL &&
+       s->yin_setup != NULL)
+    {
+      rta_yin_sliding_setup_clear(s);
+      ret = 1;
+    }
+    else
+    {
+      rta_yin_sliding_setup_delete(s);
+      *yin_setup = NULL;
+    }
+  }
+
+  return ret;
+}
+
+void rta_yin_sliding_setup_clear(rta_yin_sliding_setup_t * yin_setup)
+{
+  unsigned int i;
+
+  for(i=0; i<yin_setup->input_size; i++)
+  {
+    yin_setup->buffer[i] = 0.;
+  }
+
+  for(i=0; i<yin_setup->ac_size; i++)
+  {
+    yin_setup->sums[i] = 0.;
+  }
+
+  yin_setup->start = 0;
+  yin_setup->refresh = 0;
+  return;
+}
+
+void rta_yin_sliding_setup_delete(rta_yin_sliding_setup_t * yin_setup)
+{
+  if(yin_setup != NULL)
+  {
+    rta_yin_setup_delete(yin_setup->yin_setup);
+
+    if(yin_setup->buffer != NULL)
+    {
+      rta_free(yin_setup->buffer);
+    }
+
+    if(yin_setup->sums != NULL)
+    {
+      rta_free(yin_setup->sums);
+    }
+
+    if(yin_setup->products != NULL)
+    {
+      rta_free(yin_setup->products);
+    }
+    rta_free(yin_setup);
+  }
+  return;
+}
+
+rta_real_t rta_yin_sliding(rta_real_t * abs_min, rta_real_t * autocorrelation,
+                           const rta_real_t * input,
+                           const unsigned int hop_size,
+                           rta_yin_sliding_setup_t * yin_setup,
+                           const rta_real_t threshold)
+{
+  return rta_yin_sliding_stride(abs_min, autocorrelation, 1, input, 1,
+                                hop_size, yin_setup, threshold);
+}
+
+/* Contract: hop_size > 0 */
+/*           threshold in [0., 1.] == (1. - confidence)^2 */
+rta_real_t rta_yin_sliding_stride(
+  rta_real_t * abs_min,
+  rta_real_t * autocorrelation, const int ac_stride,
+  const rta_real_t * input, const int i_stride,
+  const unsigned int hop_size,
+  rta_yin_sliding_setup_t * yin_setup,
+  const rta_real_t threshold)
+{
+  rta_yin_sliding_setup_t * s = yin_setup;
+  const unsigned int ac_size = s->ac_size;
+  const unsigned int input_size = s->input_size;
+  const unsigned int window_size = input_size - ac_size;
+  /* update cost 2 * hop_size against window_size per lag, with double */
+  /* precision products costing about twice the single precision ones */
+  const int sliding = 4 * hop_size < window_size;
+  /* from scratch every RTA_YIN_SLIDING_REFRESH windows of input */
+  const int update = sliding &&
+    s->refresh + hop_size < RTA_YIN_SLIDING_REFRESH * window_size;
+  rta_real_t * frame;
+  unsigned int i, size;
+  int is, ac;
+
+  /* products leaving the window, in double precision as the sums */
+  if(update)
+  {
+    frame = s->buffer + s->start;
+    rta_correlation_fast_double(s->products, ac_size, frame, frame, hop_size);
+
+    for(i=0; i<ac_size; i++)
+    {
+      s->sums[i] -= s->products[i];
+    }
+  }
+
+  /* append the input, moving the frame when the buffer is full */
+  if(hop_size < input_size)
+  {
+    if(s->start + input_size + hop_size > 2 * input_size)
+    {
+      for(i=0; i<input_size; i++)
+      {
+        s->buffer[i] = s->buffer[s->start + i];
+      }
+      s->start = 0;
+    }
+
+    frame = s->buffer + s->start + input_size;
+    size = hop_size;
+    is = 0;
+    s->start += hop_size;
+  }
+  else
+  {
+    frame = s->buffer;
+    size = input_size;
+    is = (hop_size - input_size) * i_stride;
+    s->start = 0;
+  }
+
+  for(i=0; i<size; i++, is+=i_stride)
+  {
+    frame[i] = input[is];
+  }
+
+  frame = s->buffer + s->start;
+
+  if(sliding)
+  {
+    if(update)
+    {
+      /* products entering the window */
+      rta_correlation_fast_double(s->products, ac_size,
+                                  frame + window_size - hop_size,
+                                  frame + window_size - hop_size, hop_size);
+
+      for(i=0; i<ac_size; i++)
+      {
+        s->sums[i] += s->products[i];
+      }
+      s->refresh += hop_size;
+    }
+    else
+    {
+      /* from scratch, dropping the rounding errors of the updates */
+      rta_correlation_fast_double(s->sums, ac_size, frame, frame,
+                                  window_size);
+      s->refresh = 0;
+    }
+
+    for(i=0, ac=0; i<ac_size; i++, ac+=ac_stride)
+    {
+      autocorrelation[ac] = s->sums[i];
+    }
+  }
+  else
+  {
+    /* as rta_yin, the sums are computed again by the next update */
+    rta_correlation_fast_stride(autocorrelation, ac_stride, ac_size,
+                                frame, 1, frame, 1, window_size);
+    s->refresh = RTA_YIN_SLIDING_REFRESH * window_size;
+  }
+
+  return yin_search_stride(abs_min, autocorrelation, ac_stride, ac_size,
+                           frame, 1, window_size, s->yin_setup, threshold);
+}
@@ -46,6 +46,7 @@
 #define _RTA_YIN_H_ 1
 
 #include "rta.h"
+#include "rta_correlation.h" /* rta_correlation_method_t */
 
 #ifdef __cplusplus
 extern "C" {
@@ -70,6 +71,39 @@ typedef struct rta_yin_setup rta_yin_setup_t;
 int
 rta_yin_setup_new(rta_yin_setup_t ** yin_setup, unsigned int max_mins);
 
+/**
+ * Alocate a yin setup for further yin analysis of frames of
+ * 'input_size' points, with an autocorrelation of 'ac_size' points
+ * computed by 'method'.
+ *
+ * The autocorrelation is the bottleneck of yin for large 'ac_size'
+ * (low minimum frequencies): rta_correlation_fft computes it from the
+ * product of real FFTs, rta_correlation_auto selects the cheapest
+ * method for these sizes. rta_yin and rta_yin_stride fall back to
+ * rta_correlation_fast for other sizes.
+ *
+ * \see rta_correlation_setup_new
+ * \see rta_yin_setup_delete
+ *
+ * @param yin_setup is an address to a pointer to a private structure
+ * which may depend on actual yin implementation.
+ * @param max_mins is the maximum number of minima searched by the yin
+ * algorithm (see rta_yin_setup_new)
+ * @param ac_size is the 'ac_size' of rta_yin
+ * @param input_size is the 'input_size' of rta_yin. It must be >
+ * 'ac_size'.
+ * @param method is the autocorrelation method
+ *
+ * @return 1 on success 0 on fail. If it fails, nothing should be done
+ * with 'yin_setup' (even a delete).
+ */
+int
+rta_yin_setup_new_with_method(rta_yin_setup_t ** yin_setup,
+                              unsigned int max_mins,
+                              const unsigned int ac_size,
+                              const unsigned int input_size,
+                              const rta_correlation_method_t method);
+
 /**
  * Deallocate any (sucessfully) allocated yin setup.
  *
@@ -156,6 +190,157 @@ rta_yin_stride(rta_real_t * abs_min,
                const rta_yin_setup_t * yin_setup,
                const rta_real_t threshold);
 
+/**
+ * Yin algorithm for periodicity analysis of many frames, or channels,
+ * with the same sizes.
+ *
+ * The point i of the frame f is 'input'[i * 'i_stride' + f *
+ * 'frame_stride']: 'frame_stride' == 'input_size' and 'i_stride' == 1
+ * for a matrix of frames, 'frame_stride' == 1 and 'i_stride' ==
+ * 'frames' for interleaved channels. The auto-correlations of
+ * interleaved channels are vectorised across the channels (see
+ * rta_correlation_fast_interleaved), unless 'yin_setup' holds a
+ * correlation method for these sizes (see
+ * rta_yin_setup_new_with_method).
+ *
+ * @param lags size is 'frames'. The lag of each frame, as returned
+ * by rta_yin.
+ * @param abs_mins size is 'frames'. The absolute minimum of each
+ * frame, as 'abs_min' of rta_yin.
+ * @param energies size is 'frames'. The root mean square of the
+ * window of each frame. It may be NULL.
+ * @param autocorrelation must be allocated before calling this
+ * function. Its size is 'ac_size' * 'frames': the lag i of the frame
+ * f is 'autocorrelation'[i * 'frames' + f].
+ * @param ac_size is the autocorrelation size of each frame (see
+ * rta_yin)
+ * @param input is the frames
+ * @param i_stride is the distance between two points of a frame
+ * @param frame_stride is the distance between two frames
+ * @param input_size is the size of each frame. It must be > 'ac_size'
+ * and for good results it should be >= 2 * 'ac_size'
+ * @param frames is the number of frames
+ * @param yin_setup must be previously allocated. \see rta_yin_setup_new
+ * @param threshold under which to search the minima (see rta_yin)
+ */
+void
+rta_yin_batch(rta_real_t * lags, rta_real_t * abs_mins, rta_real_t * energies,
+              rta_real_t * autocorrelation, const unsigned int ac_size,
+              const rta_real_t * input, const int i_stride,
+              const int frame_stride,
+              const unsigned int input_size, const unsigned int frames,
+              const rta_yin_setup_t * yin_setup,
+              const rta_real_t threshold);
+
+/* rta_yin_sliding_setup is private */
+typedef struct rta_yin_sliding_setup rta_yin_sliding_setup_t;
+
+/**
+ * Allocate a sliding yin setup, for the analysis of successive
+ * overlapping frames of a signal.
+ *
+ * The setup keeps the last 'input_size' points of the signal and their
+ * autocorrelation, which is updated by the points leaving and entering
+ * the window at each hop: the cost of a hop is proportional to the hop
+ * size instead of the window size (see rta_yin_sliding). The signal
+ * is cleared (see rta_yin_sliding_setup_clear).
+ *
+ * \see rta_yin_sliding_setup_delete
+ *
+ * @param yin_setup is an address to a pointer to a private structure.
+ * This function allocates 'yin_setup' and fills it.
+ * @param max_mins is the maximum number of minima searched by the yin
+ * algorithm (see rta_yin_setup_new)
+ * @param ac_size is the autocorrelation size, as for rta_yin
+ * @param input_size is the frame size, as for rta_yin. It must be >
+ * 'ac_size'.
+ *
+ * @return 1 on success 0 on fail. If it fails, nothing should be done
+ * with 'yin_setup' (even a delete).
+ */
+int
+rta_yin_sliding_setup_new(rta_yin_sliding_setup_t ** yin_setup,
+                          const unsigned int max_mins,
+                          const unsigned int ac_size,
+                          const unsigned int input_size);
+
+/**
+ * Clear the signal of a sliding yin setup: the frame is then zeroes,
+ * as after its allocation.
+ *
+ * @param yin_setup is a pointer to a private structure
+ */
+void
+rta_yin_sliding_setup_clear(rta_yin_sliding_setup_t * yin_setup);
+
+/**
+ * Deallocate any (sucessfully) allocated sliding yin setup.
+ *
+ * \see rta_yin_sliding_setup_new
+ *
+ * @param yin_setup is a pointer to the memory wich will be released.
+ */
+void
+rta_yin_sliding_setup_delete(rta_yin_sliding_setup_t * yin_setup);
+
+/**
+ * Yin algorithm for periodicity analysis, on a frame sliding by
+ * 'hop_size' points.
+ *
+ * The last 'input_size' points of the signal are analysed as by
+ * rta_yin. The autocorrelation of the window is updated by the
+ * products of the 'hop_size' points leaving it and of the ones
+ * entering it, computed and accumulated in double precision. It is
+ * computed from scratch every 64 windows of input, so that the
+ * rounding errors of the updates stay bounded (as after a loud
+ * signal followed by a quiet one). If 'hop_size' >= ('input_size' -
+ * 'ac_size') / 4, it is computed from scratch on each call, in single
+ * precision as by rta_yin.
+ *
+ * @param abs_min is the absolute minimum found (see rta_yin)
+ * @param autocorrelation must be allocated before calling this
+ * function. 'autocorrelation' size is 'ac_size' of 'yin_setup'.
+ * @param input is the next 'hop_size' points of the signal
+ * @param hop_size must be > 0
+ * @param yin_setup must be previously allocated.
+ * \see rta_yin_sliding_setup_new
+ * @param threshold under which to search the minima (see rta_yin)
+ *
+ * @return the lag corresponding to 'abs_min' (see rta_yin)
+ */
+rta_real_t
+rta_yin_sliding(rta_real_t * abs_min, rta_real_t * autocorrelation,
+                const rta_real_t * input, const unsigned int hop_size,
+                rta_yin_sliding_setup_t * yin_setup,
+                const rta_real_t threshold);
+
+/**
+ * Yin algorithm for periodicity analysis, on a frame sliding by
+ * 'hop_size' points.
+ *
+ * \see rta_yin_sliding
+ *
+ * @param abs_min is the absolute minimum found (see rta_yin)
+ * @param autocorrelation must be allocated before calling this
+ * function. 'autocorrelation' size is 'ac_size' of 'yin_setup'.
+ * @param ac_stride is 'autocorrelation' stride
+ * @param input is the next 'hop_size' points of the signal
+ * @param i_stride is 'input' stride
+ * @param hop_size must be > 0
+ * @param yin_setup must be previously allocated.
+ * \see rta_yin_sliding_setup_new
+ * @param threshold under which to search the minima (see rta_yin)
+ *
+ * @return the lag corresponding to 'abs_min' (see rta_yin)
+ */
+rta_real_t
+rta_yin_sliding_stride(rta_real_t * abs_min,
+                       rta_real_t * autocorrelation, const int ac_stride,
+                       const rta_real_t * input, const int i_stride,
+                       const unsigned int hop_size,
+                       rta_yin_sliding_setup_t * yin_setup,
+                       const rta_real_t threshold);
+
 #ifdef __cplusplus
 }
 #endif
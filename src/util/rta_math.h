@@ -73,6 +73,8 @@
 
 #define rta_cos cos
 #define rta_sin sin
+#define rta_tan tan
+#define rta_atan atan
 
 #define rta_hypot hypot
 
@@ -104,6 +106,8 @@
 
 #define rta_cos cosf
 #define rta_sin sinf
+#define rta_tan tanf
+#define rta_atan atanf
 
 #define rta_hypot hypotf
 
@@ -135,6 +139,8 @@
 
 #define rta_cos cos
 #define rta_sin sin
+#define rta_tan tan
+#define rta_atan atan
 
 #define rta_hypot hypot
 
@@ -166,6 +172,8 @@
 
 #define rta_cos cosl
 #define rta_sin sinl
+#define rta_tan tanl
+#define rta_atan atanl
 
 #define rta_hypot hypotl
 
@@ -0,0 +1,360 @@
+/**
+ * @file   rta_thread.c
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_util
+ *
+ * @brief  pool of worker threads
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rta_thread.h"
+#include "rta_stdlib.h" /* memory management */
+
+#if defined(WIN32) || defined(_WIN32)
+
+#include <windows.h>
+
+typedef HANDLE rta_thread_t;
+typedef CRITICAL_SECTION rta_mutex_t;
+typedef CONDITION_VARIABLE rta_condition_t;
+
+#define rta_mutex_init(m) InitializeCriticalSection(m)
+#define rta_mutex_destroy(m) DeleteCriticalSection(m)
+#define rta_mutex_lock(m) EnterCriticalSection(m)
+#define rta_mutex_unlock(m) LeaveCriticalSection(m)
+#define rta_condition_init(c) InitializeConditionVariable(c)
+#define rta_condition_destroy(c)
+#define rta_condition_wait(c, m) SleepConditionVariableCS((c), (m), INFINITE)
+#define rta_condition_broadcast(c) WakeAllConditionVariable(c)
+#define rta_condition_signal(c) WakeConditionVariable(c)
+
+#else
+
+#include <pthread.h>
+
+typedef pthread_t rta_thread_t;
+typedef pthread_mutex_t rta_mutex_t;
+typedef pthread_cond_t rta_condition_t;
+
+#define rta_mutex_init(m) pthread_mutex_init((m), NULL)
+#define rta_mutex_destroy(m) pthread_mutex_destroy(m)
+#define rta_mutex_lock(m) pthread_mutex_lock(m)
+#define rta_mutex_unlock(m) pthread_mutex_unlock(m)
+#define rta_condition_init(c) pthread_cond_init((c), NULL)
+#define rta_condition_destroy(c) pthread_cond_destroy(c)
+#define rta_condition_wait(c, m) pthread_cond_wait((c), (m))
+#define rta_condition_broadcast(c) pthread_cond_broadcast(c)
+#define rta_condition_signal(c) pthread_cond_signal(c)
+
+#endif
+
+typedef struct
+{
+  rta_thread_pool_t * thread_pool;
+  unsigned int index; /**< 1..threads-1, 0 is the caller of run */
+} rta_thread_worker_t;
+
+struct rta_thread_pool
+{
+  unsigned int threads;
+  rta_thread_t * handles;        /**< 'threads' - 1 started threads */
+  rta_thread_worker_t * workers;
+  rta_mutex_t mutex;
+  rta_condition_t start;         /**< new set of tasks, or quit */
+  rta_condition_t done;          /**< all the workers are idle */
+  unsigned int generation;       /**< incremented for each set of tasks */
+  unsigned int busy;             /**< workers running the current set */
+  int quit;
+
+  /* current set of tasks */
+  rta_thread_task_t task;
+  void * data;
+  unsigned int tasks;
+  unsigned int next;             /**< next task to run */
+};
+
+/* run the tasks of the current set until none is left */
+static void
+run_tasks(rta_thread_pool_t * thread_pool, const unsigned int thread)
+{
+  unsigned int t;
+
+  for(;;)
+  {
+    rta_mutex_lock(&thread_pool->mutex);
+    t = thread_pool->next;
+    if(t < thread_pool->tasks)
+    {
+      thread_pool->next++;
+    }
+    rta_mutex_unlock(&thread_pool->mutex);
+
+    if(t >= thread_pool->tasks)
+    {
+      break;
+    }
+
+    thread_pool->task(thread_pool->data, t, thread);
+  }
+  return;
+}
+
+static void
+worker_loop(rta_thread_worker_t * worker)
+{
+  rta_thread_pool_t * thread_pool = worker->thread_pool;
+  unsigned int generation = 0;
+
+  rta_mutex_lock(&thread_pool->mutex);
+  for(;;)
+  {
+    while(thread_pool->quit == 0 && thread_pool->generation == generation)
+    {
+      rta_condition_wait(&thread_pool->start, &thread_pool->mutex);
+    }
+
+    if(thread_pool->quit != 0)
+    {
+      break;
+    }
+
+    generation = thread_pool->generation;
+    rta_mutex_unlock(&thread_pool->mutex);
+
+    run_tasks(thread_pool, worker->index);
+
+    rta_mutex_lock(&thread_pool->mutex);
+    thread_pool->busy--;
+    if(thread_pool->busy == 0)
+    {
+      rta_condition_signal(&thread_pool->done);
+    }
+  }
+  rta_mutex_unlock(&thread_pool->mutex);
+
+  return;
+}
+
+#if defined(WIN32) || defined(_WIN32)
+static DWORD WINAPI
+worker_main(LPVOID worker)
+{
+  worker_loop((rta_thread_worker_t *) worker);
+  return 0;
+}
+#else
+static void *
+worker_main(void * worker)
+{
+  worker_loop((rta_thread_worker_t *) worker);
+  return NULL;
+}
+#endif
+
+/* return 1 on success, 0 on fail */
+static int
+thread_start(rta_thread_t * handle, rta_thread_worker_t * worker)
+{
+#if defined(WIN32) || defined(_WIN32)
+  *handle = CreateThread(NULL, 0, worker_main, worker, 0, NULL);
+  return (*handle != NULL);
+#else
+  return (pthread_create(handle, NULL, worker_main, worker) == 0);
+#endif
+}
+
+static void
+thread_join(rta_thread_t handle)
+{
+#if defined(WIN32) || defined(_WIN32)
+  WaitForSingleObject(handle, INFINITE);
+  CloseHandle(handle);
+#else
+  pthread_join(handle, NULL);
+#endif
+  return;
+}
+
+/* stop and join the 'started' first threads */
+static void
+threads_stop(rta_thread_pool_t * thread_pool, const unsigned int started)
+{
+  unsigned int i;
+
+  rta_mutex_lock(&thread_pool->mutex);
+  thread_pool->quit = 1;
+  rta_condition_broadcast(&thread_pool->start);
+  rta_mutex_unlock(&thread_pool->mutex);
+
+  for(i=0; i<started; i++)
+  {
+    thread_join(thread_pool->handles[i]);
+  }
+  return;
+}
+
+int
+rta_thread_pool_new(rta_thread_pool_t ** thread_pool,
+                    const unsigned int threads)
+{
+  int ret = 0;
+
+  *thread_pool = (rta_thread_pool_t *) rta_malloc(sizeof(rta_thread_pool_t));
+
+  if(*thread_pool != NULL)
+  {
+    const unsigned int workers = (threads > 0) ? threads - 1 : 0;
+
+    (*thread_pool)->threads = workers + 1;
+    (*thread_pool)->generation = 0;
+    (*thread_pool)->busy = 0;
+    (*thread_pool)->quit = 0;
+    (*thread_pool)->task = NULL;
+    (*thread_pool)->data = NULL;
+    (*thread_pool)->tasks = 0;
+    (*thread_pool)->next = 0;
+
+    /* at least one element for rta_malloc */
+    (*thread_pool)->handles = (rta_thread_t *) rta_malloc(
+      sizeof(rta_thread_t) * (workers + 1));
+    (*thread_pool)->workers = (rta_thread_worker_t *) rta_malloc(
+      sizeof(rta_thread_worker_t) * (workers + 1));
+
+    if((*thread_pool)->handles != NULL && (*thread_pool)->workers != NULL)
+    {
+      unsigned int i;
+
+      rta_mutex_init(&(*thread_pool)->mutex);
+      rta_condition_init(&(*thread_pool)->start);
+      rta_condition_init(&(*thread_pool)->done);
+
+      ret = 1;
+      for(i=0; i<workers && ret != 0; i++)
+      {
+        (*thread_pool)->workers[i].thread_pool = *thread_pool;
+        (*thread_pool)->workers[i].index = i + 1;
+        ret = thread_start(&(*thread_pool)->handles[i],
+                           &(*thread_pool)->workers[i]);
+      }
+
+      if(ret == 0) /* thread i-1 failed */
+      {
+        threads_stop(*thread_pool, i - 1);
+        rta_condition_destroy(&(*thread_pool)->done);
+        rta_condition_destroy(&(*thread_pool)->start);
+        rta_mutex_destroy(&(*thread_pool)->mutex);
+      }
+    }
+
+    if(ret == 0)
+    {
+      if((*thread_pool)->handles != NULL)
+      {
+        rta_free((*thread_pool)->handles);
+      }
+
+      if((*thread_pool)->workers != NULL)
+      {
+        rta_free((*thread_pool)->workers);
+      }
+
+      rta_free(*thread_pool);
+      *thread_pool = NULL;
+    }
+  }
+
+  return ret;
+}
+
+void
+rta_thread_pool_delete(rta_thread_pool_t * thread_pool)
+{
+  if(thread_pool != NULL)
+  {
+    threads_stop(thread_pool, thread_pool->threads - 1);
+
+    rta_condition_destroy(&thread_pool->done);
+    rta_condition_destroy(&thread_pool->start);
+    rta_mutex_destroy(&thread_pool->mutex);
+
+    rta_free(thread_pool->handles);
+    rta_free(thread_pool->workers);
+    rta_free(thread_pool);
+  }
+
+  return;
+}
+
+unsigned int
+rta_thread_pool_threads(const rta_thread_pool_t * thread_pool)
+{
+  return (thread_pool != NULL) ? thread_pool->threads : 1;
+}
+
+void
+rta_thread_pool_run(rta_thread_pool_t * thread_pool,
+                    rta_thread_task_t task, void * data,
+                    const unsigned int tasks)
+{
+  unsigned int t;
+
+  if(thread_pool == NULL || thread_pool->threads == 1 || tasks < 2)
+  {
+    for(t=0; t<tasks; t++)
+    {
+      task(data, t, 0);
+    }
+  }
+  else
+  {
+    rta_mutex_lock(&thread_pool->mutex);
+    thread_pool->task = task;
+    thread_pool->data = data;
+    thread_pool->tasks = tasks;
+    thread_pool->next = 0;
+    thread_pool->busy = thread_pool->threads - 1;
+    thread_pool->generation++;
+    rta_condition_broadcast(&thread_pool->start);
+    rta_mutex_unlock(&thread_pool->mutex);
+
+    run_tasks(thread_pool, 0);
+
+    rta_mutex_lock(&thread_pool->mutex);
+    while(thread_pool->busy > 0)
+    {
+      rta_condition_wait(&thread_pool->done, &thread_pool->mutex);
+    }
+    rta_mutex_unlock(&thread_pool->mutex);
+  }
+
+  return;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file   rta_thread.h
+ * @date   Sun Oct 18 2026
+ * @ingroup rta_util
+ *
+ * @brief  pool of worker threads
+ *
+ * A pool runs a set of independent tasks on its threads, for the
+ * computations that can be split (like the blocks of a large FFT). It
+ * uses POSIX threads, or Windows threads.
+ *
+ * @copyright
+ * Copyright (C) 2007 by IRCAM-Centre Georges Pompidou, Paris, France.
+ * All rights reserved.
+ *
+ * License (BSD 3-clause)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _RTA_THREAD_H_
+#define _RTA_THREAD_H_ 1
+
+#include "rta.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* rta_thread_pool is private (depends on implementation) */
+typedef struct rta_thread_pool rta_thread_pool_t;
+
+/**
+ * Task run by a pool.
+ *
+ * \param data is the argument given to rta_thread_pool_run
+ * \param task is the index of the task, 0..tasks-1
+ * \param thread is the index of the running thread, 0..threads-1, to
+ * select a work buffer: a thread runs one task at a time.
+ */
+typedef void (*rta_thread_task_t)(void * data, const unsigned int task,
+                                  const unsigned int thread);
+
+/**
+ * Allocate a pool and start its threads, which wait for tasks.
+ *
+ * \see rta_thread_pool_delete
+ *
+ * @param thread_pool is an address of a pointer to a private
+ * structure. This function allocates 'thread_pool' and fills it.
+ * @param threads is the number of threads running the tasks,
+ * including the caller of rta_thread_pool_run (then 'threads' - 1
+ * threads are started). It must be > 0.
+ *
+ * @return 1 on success 0 on fail. If it fails, nothing should be done
+ * with 'thread_pool' (even a delete).
+ */
+int
+rta_thread_pool_new(rta_thread_pool_t ** thread_pool,
+                    const unsigned int threads);
+
+/**
+ * Stop the threads and deallocate a pool created by
+ * rta_thread_pool_new.
+ *
+ * @param thread_pool is a pointer to the memory wich will be released.
+ */
+void
+rta_thread_pool_delete(rta_thread_pool_t * thread_pool);
+
+/**
+ * Number of threads of a pool.
+ *
+ * @param thread_pool is a pointer to a pool, or NULL
+ *
+ * @return the number of threads, including the caller of
+ * rta_thread_pool_run (1 if 'thread_pool' is NULL)
+ */
+unsigned int
+rta_thread_pool_threads(const rta_thread_pool_t * thread_pool);
+
+/**
+ * Run 'tasks' tasks on the threads of a pool, and the calling thread,
+ * in any order. Return when all of them are done.
+ *
+ * A pool runs one set of tasks at a time: it must not be used
+ * concurrently by different threads.
+ *
+ * @param thread_pool is a pointer to a pool, or NULL to run the tasks
+ * in the calling thread only
+ * @param task is the function called for each task
+ * @param data is the argument passed to 'task'
+ * @param tasks is the number of tasks
+ */
+void
+rta_thread_pool_run(rta_thread_pool_t * thread_pool,
+                    rta_thread_task_t task, void * data,
+                    const unsigned int tasks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTA_THREAD_H_ */
@@ -0,0 +1,322 @@
+/*
+
+- compile
+
+cc -g ../src/signal/rta_biquad.c ../src/signal/rta_biquadsimd.c rta_biquad-test.c -I ../bindings/console/ -I ../src -I ../src/util/ -I ../src/signal/ -lm -o rta_biquad-test
+
+- run
+
+./rta_biquad-test
+
+- check
+
+valgrind --error-limit=no ./rta_biquad-test
+
+*/
+
+
+#undef NDEBUG /* the checks are the test */
+#include <assert.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "rta_configuration.h"
+#include "rta_biquad.h"
+#include "rta_filter.h"
+
+/* error of a coefficient, relative to the larger of 1 and its value */
+static double
+coef_error (rta_real_t value, rta_real_t reference)
+{
+    double scale = fabs(reference) > 1 ? fabs(reference) : 1;
+
+    return fabs(value - reference) / scale;
+}
+
+/* fast and batch coefficients against the exact ones, for every type
+   across 0 <= f0 <= 1 */
+static double
+fast_coefs (void)
+{
+    const int steps = 2000;
+    const rta_real_t qs[] = { 0.5, 0.707, 8 };
+    const rta_real_t gains[] = { 0.25, 1, 3 };
+    rta_filter_t *types  = malloc((steps + 1) * sizeof(rta_filter_t));
+    rta_real_t *f0s      = malloc((steps + 1) * sizeof(rta_real_t));
+    rta_real_t *q        = malloc((steps + 1) * sizeof(rta_real_t));
+    rta_real_t *gain     = malloc((steps + 1) * sizeof(rta_real_t));
+    rta_real_t *b_batch  = malloc(3 * (steps + 1) * sizeof(rta_real_t));
+    rta_real_t *a_batch  = malloc(2 * (steps + 1) * sizeof(rta_real_t));
+    double error = 0;
+    int type, p, k, j;
+
+    for (type = rta_lowpass; type <= rta_highshelf; type++)
+    for (p = 0; p < 3; p++)
+    {
+	double type_error = 0;
+
+	for (k = 0; k <= steps; k++)
+	{
+	    types[k] = type;
+	    f0s[k] = k / (rta_real_t) steps;
+	    q[k] = qs[p];
+	    gain[k] = gains[p];
+	}
+
+	rta_biquad_coefs_batch(b_batch, a_batch, types, f0s, q, gain, steps + 1);
+
+	for (k = 0; k <= steps; k++)
+	{
+	    rta_real_t b[3], a[2], b_fast[3], a_fast[2], b_stride[6], a_stride[6];
+
+	    rta_biquad_coefs(b, a, type, f0s[k], q[k], gain[k]);
+	    rta_biquad_coefs_fast(b_fast, a_fast, type, f0s[k], q[k], gain[k]);
+	    rta_biquad_coefs_fast_stride(b_stride, 2, a_stride, 3,
+					 type, f0s[k], q[k], gain[k]);
+
+	    for (j = 0; j < 3; j++)
+	    {
+		type_error = fmax(type_error, coef_error(b_fast[j], b[j]));
+		type_error = fmax(type_error, coef_error(b_batch[3 * k + j], b[j]));
+		assert(b_stride[2 * j] == b_fast[j]);
+	    }
+	    for (j = 0; j < 2; j++)
+	    {
+		type_error = fmax(type_error, coef_error(a_fast[j], a[j]));
+		type_error = fmax(type_error, coef_error(a_batch[2 * k + j], a[j]));
+		assert(a_stride[3 * j] == a_fast[j]);
+	    }
+	}
+
+	printf("--- fast coefs type %d  q %g  gain %g: error %g\n",
+	       type, qs[p], gains[p], type_error);
+	error = fmax(error, type_error);
+    }
+
+    free(types);
+    free(f0s);
+    free(q);
+    free(gain);
+    free(b_batch);
+    free(a_batch);
+
+    return error;
+}
+
+/* block biquad, contiguous and strided in place by chunks, against
+   the same filter in extended precision, within the errors documented
+   for rta_biquad_df2t_vector_block */
+static void
+block (void)
+{
+    const int size = 100003;
+    const int single = sizeof(rta_real_t) == sizeof(float);
+    /* maximum errors relative to the output, in single and double
+       precision */
+    const struct {
+	rta_filter_t type; rta_real_t f0, q, gain; double single, twice;
+    } filters[] = {
+	{ rta_lowpass, 0.3, 0.7, 1, 1e-5, 1e-13 },
+	{ rta_lowpass, 0.001, 5, 1, 3e-3, 4e-11 }, /* poles close to 1 */
+	{ rta_highpass, 0.01, 0.7, 1, 1e-5, 1e-13 },
+	{ rta_peaking, 0.05, 4, 4, 1e-5, 1e-13 },
+	{ rta_bandpass_constant_peak, 0.2, 20, 1, 1e-5, 1e-13 },
+	{ rta_notch, 0.5, 1, 1, 1e-5, 1e-13 } };
+    rta_real_t *x = malloc(size * sizeof(rta_real_t));
+    rta_real_t *y = malloc(3 * size * sizeof(rta_real_t));
+    rta_real_t *y_vector = malloc(size * sizeof(rta_real_t));
+    double *ref = malloc(size * sizeof(double));
+    int f, i, n;
+
+    for (i = 0; i < size; i++)
+	x[i] = random() / (double) RAND_MAX - 0.5;
+
+    for (f = 0; f < 6; f++)
+    {
+	rta_real_t b[3], a[2];
+	rta_real_t states[2] = { 0, 0 }, states_vector[2] = { 0, 0 };
+	rta_real_t states_stride[6] = { 0, 0, 0, 0, 0, 0 };
+	long double d0 = 0, d1 = 0;
+	double y_max = 0;
+	double error = 0, error_vector = 0, error_stride = 0, max_error;
+
+	rta_biquad_coefs(b, a, filters[f].type, filters[f].f0, filters[f].q,
+			 filters[f].gain);
+
+	for (i = 0; i < size; i++)
+	{
+	    long double y0 = b[0] * (long double) x[i] + d0;
+
+	    d0 = b[1] * (long double) x[i] - a[0] * y0 + d1;
+	    d1 = b[2] * (long double) x[i] - a[1] * y0;
+	    ref[i] = y0;
+	    y_max = fmax(y_max, fabs(ref[i]));
+	}
+
+	rta_biquad_df2t_vector(y_vector, x, size, b, a, states_vector);
+	rta_biquad_df2t_vector_block(y, x, size, b, a, states);
+	for (i = 0; i < size; i++)
+	{
+	    error = fmax(error, fabs(y[i] - ref[i]));
+	    error_vector = fmax(error_vector, fabs(y_vector[i] - ref[i]));
+	}
+
+	/* the states are carried from a chunk to the next */
+	for (i = 0; i < size; i++)
+	    y[3 * i] = x[i];
+	for (i = 0; i < size; i += n)
+	{
+	    n = 1 + random() % 100;
+	    if (i + n > size)
+		n = size - i;
+
+	    rta_biquad_df2t_vector_block_stride(y + 3 * i, 3, y + 3 * i, 3, n,
+						b, 1, a, 1, states_stride, 3);
+	}
+	for (i = 0; i < size; i++)
+	    error_stride = fmax(error_stride, fabs(y[3 * i] - ref[i]));
+
+	printf("--- block filter %d: error %g  stride error %g  vector error %g (max %g)\n",
+	       f, error / y_max, error_stride / y_max, error_vector / y_max,
+	       y_max);
+	max_error = single ? filters[f].single : filters[f].twice;
+	assert(error <= max_error * y_max && error_stride <= max_error * y_max);
+	assert(fabs(states[0] - states_vector[0]) <= max_error * y_max);
+	assert(fabs(states_stride[0] - states[0]) <= max_error * y_max);
+	if (single)
+	    assert(error <= 2 * error_vector && error_stride <= 2 * error_vector);
+    }
+
+    free(x);
+    free(y);
+    free(y_vector);
+    free(ref);
+}
+
+/* ramped coefficients: constant ramps as the vector functions, and a
+   sweep of a resonant low-pass filter against a filter in double
+   precision with the coefficients interpolated sample by sample */
+static void
+ramp (void)
+{
+    const int size = 48000, vector = 64;
+    rta_real_t *x = malloc(size * sizeof(rta_real_t));
+    rta_real_t *y = malloc(2 * size * sizeof(rta_real_t));
+    rta_real_t *y_vector = malloc(size * sizeof(rta_real_t));
+    rta_real_t b[3], a[2];
+    int form, i, k, j;
+
+    for (i = 0; i < size; i++)
+	x[i] = random() / (double) RAND_MAX - 0.5;
+
+    /* constant */
+    rta_biquad_coefs(b, a, rta_peaking, 0.1, 2, 3);
+    for (form = 0; form < 2; form++)
+    {
+	rta_real_t states[4] = { 0, 0, 0, 0 }, states_vector[4] = { 0, 0, 0, 0 };
+	rta_real_t states_stride[4] = { 0, 0, 0, 0 };
+
+	if (form == 0)
+	{
+	    rta_biquad_df2t_vector(y_vector, x, size, b, a, states_vector);
+	    rta_biquad_df2t_vector_ramp(y, x, size, b, b, a, a, states);
+	    rta_biquad_df2t_vector_ramp_stride(y + size, 1, x, 1, size,
+					       b, b, 1, a, a, 1, states_stride, 2);
+	}
+	else
+	{
+	    rta_biquad_df1_vector(y_vector, x, size, b, a, states_vector);
+	    rta_biquad_df1_vector_ramp(y, x, size, b, b, a, a, states);
+	    rta_biquad_df1_vector_ramp_stride(y + size, 1, x, 1, size,
+					      b, b, 1, a, a, 1, states_stride, 1);
+	}
+
+	for (i = 0; i < size; i++)
+	    assert(y[i] == y_vector[i] && y[size + i] == y_vector[i]);
+	assert(states[0] == states_vector[0] && states[1] == states_vector[1]);
+    }
+
+    /* sweep from 0.005 to 0.9 and back, 3 times */
+    for (form = 0; form < 2; form++)
+    {
+	rta_real_t states[4] = { 0, 0, 0, 0 };
+	rta_real_t b_start[3], a_start[2], b_end[3], a_end[2];
+	double ref_states[4] = { 0, 0, 0, 0 };
+	double y_max = 0, error = 0;
+
+	rta_biquad_coefs(b_start, a_start, rta_lowpass, 0.005, 4, 1);
+
+	for (k = 0; k < size / vector; k++)
+	{
+	    double f0 = 0.005 + 0.895 * (0.5 - 0.5 * cos(6 * M_PI * k * vector / size));
+
+	    rta_biquad_coefs(b_end, a_end, rta_lowpass, f0, 4, 1);
+	    if (form == 0)
+		rta_biquad_df2t_vector_ramp(y + k * vector, x + k * vector, vector,
+					    b_start, b_end, a_start, a_end,
+					    states);
+	    else
+		rta_biquad_df1_vector_ramp(y + k * vector, x + k * vector, vector,
+					   b_start, b_end, a_start, a_end,
+					   states);
+
+	    for (i = 0; i < vector; i++)
+	    {
+		const double t = (i + 1) / (double) vector;
+		const double in = x[k * vector + i];
+		double bi[3], ai[2], out;
+
+		for (j = 0; j < 3; j++)
+		    bi[j] = b_start[j] + (b_end[j] - b_start[j]) * t;
+		for (j = 0; j < 2; j++)
+		    ai[j] = a_start[j] + (a_end[j] - a_start[j]) * t;
+
+		if (form == 0)
+		{
+		    out = bi[0] * in + ref_states[0];
+		    ref_states[0] = bi[1] * in - ai[0] * out + ref_states[1];
+		    ref_states[1] = bi[2] * in - ai[1] * out;
+		}
+		else
+		{
+		    out = bi[0] * in + bi[1] * ref_states[0] + bi[2] * ref_states[1]
+			- ai[0] * ref_states[2] - ai[1] * ref_states[3];
+		    ref_states[1] = ref_states[0];
+		    ref_states[0] = in;
+		    ref_states[3] = ref_states[2];
+		    ref_states[2] = out;
+		}
+
+		y_max = fmax(y_max, fabs(out));
+		error = fmax(error, fabs(y[k * vector + i] - out));
+	    }
+
+	    for (j = 0; j < 3; j++)
+		b_start[j] = b_end[j];
+	    for (j = 0; j < 2; j++)
+		a_start[j] = a_end[j];
+	}
+
+	printf("--- ramp form %s: sweep error %g (max %g)\n",
+	       form == 0 ? "df2t" : "df1", error / y_max, y_max);
+	assert(error < (sizeof(rta_real_t) == sizeof(float) ? 1e-4 : 1e-12) * y_max);
+    }
+
+    free(x);
+    free(y);
+    free(y_vector);
+}
+
+int main (int argc, char *argv[])
+{
+    /* up to the rounding in single precision, about 1e-10 in double */
+    double error = fast_coefs();
+
+    assert(error < (sizeof(rta_real_t) == sizeof(float) ? 16 * FLT_EPSILON : 1e-10));
+
+    block();
+    ramp();
+
+    return 0;
+}
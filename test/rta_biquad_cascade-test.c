@@ -0,0 +1,134 @@
+/*
+
+- compile
+
+cc -g ../src/signal/rta_biquad_cascade.c ../src/signal/rta_biquad.c ../src/signal/rta_biquadsimd.c rta_biquad_cascade-test.c -I ../bindings/console/ -I ../src -I ../src/util/ -I ../src/signal/ -lm -o rta_biquad_cascade-test
+
+- run
+
+./rta_biquad_cascade-test
+
+- check
+
+valgrind --error-limit=no ./rta_biquad_cascade-test
+
+*/
+
+
+#undef NDEBUG /* the checks are the test */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "rta_configuration.h"
+#include "rta_biquad.h"
+#include "rta_biquad_cascade.h"
+
+#define SECTIONS 4
+#define FRAMES 1000
+#define MAX_CHANNELS 64
+
+/* rounding errors of the different operation orders */
+#define TOLERANCE (sizeof(rta_real_t) == sizeof(float) ? 1e-4 : 1e-10)
+
+/* the cascade of interleaved channels, strided, in place and by blocks
+   of random sizes, against each channel filtered by rta_biquad_df2t
+   through each section */
+static double
+cascade (unsigned int channels)
+{
+    const int stride = channels + 3;
+    static rta_real_t b[MAX_CHANNELS][SECTIONS][3];
+    static rta_real_t a[MAX_CHANNELS][SECTIONS][2];
+    rta_real_t *x = malloc(FRAMES * stride * sizeof(rta_real_t));
+    rta_real_t *y = malloc(FRAMES * stride * sizeof(rta_real_t));
+    rta_biquad_cascade_setup_t *setup;
+    double e = 0;
+    int ok, pass, s, f, i;
+    unsigned int c;
+
+    ok = rta_biquad_cascade_setup_new(&setup, SECTIONS, channels);
+    assert(ok);
+
+    for (c = 0; c < channels; c++)
+    for (s = 0; s < SECTIONS; s++)
+    {
+	rta_biquad_coefs(b[c][s], a[c][s], s % 2 ? rta_peaking : rta_lowpass,
+			 0.05 + 0.2 * ((c * 7 + s) % 5) / 5., 0.7 + s * 0.3, 1.5);
+	ok = rta_biquad_cascade_set_coefs(setup, s, c, b[c][s], a[c][s]);
+	assert(ok);
+    }
+
+    for (i = 0; i < FRAMES * stride; i++)
+	x[i] = random() / (double) RAND_MAX - 0.5;
+
+    /* the second pass after a clear gives the same output */
+    for (pass = 0; pass < 2; pass++)
+    {
+	if (pass > 0)
+	    rta_biquad_cascade_setup_clear(setup);
+
+	for (i = 0; i < FRAMES * stride; i++)
+	    y[i] = x[i];
+
+	for (f = 0; f < FRAMES;)
+	{
+	    int n = 1 + random() % 150;
+
+	    if (f + n > FRAMES)
+		n = FRAMES - f;
+
+	    rta_biquad_cascade_process_stride(y + f * stride, stride,
+					      y + f * stride, stride, n, setup);
+	    f += n;
+	}
+
+	for (c = 0; c < channels; c++)
+	{
+	    rta_real_t state[SECTIONS][2] = { { 0 } };
+
+	    for (i = 0; i < FRAMES; i++)
+	    {
+		rta_real_t sample = x[i * stride + c];
+
+		for (s = 0; s < SECTIONS; s++)
+		    sample = rta_biquad_df2t(sample, b[c][s], a[c][s], state[s]);
+
+		e = fmax(e, fabs(y[i * stride + c] - sample));
+	    }
+	}
+
+	/* the points between the frames are untouched */
+	for (f = 0; f < FRAMES; f++)
+	for (i = channels; i < stride; i++)
+	    assert(y[f * stride + i] == x[f * stride + i]);
+    }
+
+    /* out of the cascade */
+    ok = rta_biquad_cascade_set_coefs(setup, SECTIONS, 0, b[0][0], a[0][0]);
+    assert(!ok);
+    ok = rta_biquad_cascade_set_coefs(setup, 0, channels, b[0][0], a[0][0]);
+    assert(!ok);
+
+    rta_biquad_cascade_setup_delete(setup);
+    free(x);
+    free(y);
+
+    return e;
+}
+
+int main (int argc, char *argv[])
+{
+    const unsigned int channels[] = { 1, 5, 8, 13, 64 };
+    int i;
+
+    for (i = 0; i < 5; i++)
+    {
+	double e = cascade(channels[i]);
+
+	printf("--- cascade %2u channels: error %g\n", channels[i], e);
+	assert(e < TOLERANCE);
+    }
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+/*
+
+- compile
+
+cc -g ../src/signal/rta_convolution.c ../src/signal/rta_fft.c ../src/signal/rta_fftsimd.c ../src/util/rta_int.c ../src/util/rta_thread.c rta_convolution-test.c -I ../bindings/console/ -I ../src -I ../src/util/ -I ../src/signal/ -lm -lpthread -o rta_convolution-test
+
+- run
+
+./rta_convolution-test
+
+- check
+
+valgrind --error-limit=no ./rta_convolution-test
+
+*/
+
+
+#undef NDEBUG /* the checks are the test */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "rta_configuration.h"
+#include "rta_convolution.h"
+
+/* rounding errors, relative to the size of the impulse response */
+#define TOLERANCE (sizeof(rta_real_t) == sizeof(float) ? 1e-5 : 1e-12)
+
+#define BLOCKS 13
+
+static void
+random_vector (rta_real_t *vector, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+	vector[i] = random() / (double) RAND_MAX - 0.5;
+}
+
+/* output n of the convolution of x by h, by a direct sum in double
+   precision */
+static double
+reference (const rta_real_t *h, int impulse_size, const rta_real_t *x, int n)
+{
+    double y = 0;
+    int i;
+
+    for (i = 0; i < impulse_size && i <= n; i++)
+	y += (double) h[i] * x[n - i];
+
+    return y;
+}
+
+/* block processing against the direct sums, with the impulse response
+   changed in the middle of the signal */
+static double
+blocks (int impulse_size, int block_size, int stride, int in_place)
+{
+    const int size = BLOCKS * block_size;
+    const int change = BLOCKS / 2;
+    rta_real_t *h = malloc(impulse_size * sizeof(rta_real_t));
+    rta_real_t *h2 = malloc(impulse_size * sizeof(rta_real_t));
+    rta_real_t *x = malloc(size * sizeof(rta_real_t));
+    rta_real_t *input = malloc(block_size * stride * sizeof(rta_real_t));
+    rta_real_t *output = malloc(block_size * stride * sizeof(rta_real_t));
+    rta_real_t *y = in_place ? input : output;
+    rta_convolution_setup_t *setup;
+    double e = 0;
+    int ok, b, i;
+
+    random_vector(h, impulse_size);
+    random_vector(h2, impulse_size);
+    random_vector(x, size);
+
+    ok = rta_convolution_setup_new(&setup, h, impulse_size, block_size);
+    assert(ok);
+
+    for (b = 0; b < BLOCKS; b++)
+    {
+	/* the new response applies to the whole past input */
+	if (b == change)
+	{
+	    ok = rta_convolution_setup_set_impulse(setup, h2, impulse_size);
+	    assert(ok);
+	}
+
+	for (i = 0; i < block_size; i++)
+	    input[i * stride] = x[b * block_size + i];
+
+	rta_convolution_process_stride(y, stride, input, stride, setup);
+
+	for (i = 0; i < block_size; i++)
+	{
+	    double ref = reference(b < change ? h : h2, impulse_size, x,
+				   b * block_size + i);
+
+	    e = fmax(e, fabs(y[i * stride] - ref));
+	}
+    }
+
+    /* too long */
+    ok = rta_convolution_setup_set_impulse(setup, h, impulse_size + 1);
+    assert(!ok);
+
+    rta_convolution_setup_delete(setup);
+    free(h);
+    free(h2);
+    free(x);
+    free(input);
+    free(output);
+
+    return e / sqrt(impulse_size);
+}
+
+int main (int argc, char *argv[])
+{
+    const int impulse_sizes[] = { 1, 7, 64, 100, 1000, 4097 };
+    const int block_sizes[] = { 1, 3, 16, 64, 100, 256 };
+    double max_error = 0;
+    int h, b, stride, in_place;
+
+    for (h = 0; h < 6; h++)
+    for (b = 0; b < 6; b++)
+    for (stride = 1; stride <= 2; stride++)
+    for (in_place = 0; in_place <= 1; in_place++)
+    {
+	double e = blocks(impulse_sizes[h], block_sizes[b], stride, in_place);
+
+	if (e >= TOLERANCE)
+	    printf("--- impulse %d  block %d  stride %d  in place %d: error %g\n",
+		   impulse_sizes[h], block_sizes[b], stride, in_place, e);
+	max_error = fmax(max_error, e);
+    }
+
+    printf("--- convolution: error %g\n", max_error);
+    assert(max_error < TOLERANCE);
+
+    return 0;
+}
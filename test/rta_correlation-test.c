@@ -0,0 +1,211 @@
+/*
+
+- compile
+
+cc -g ../src/signal/rta_correlation.c ../src/signal/rta_correlationsimd.c ../src/signal/rta_fft.c ../src/signal/rta_fftsimd.c ../src/util/rta_int.c ../src/util/rta_thread.c rta_correlation-test.c -I ../bindings/console/ -I ../src -I ../src/util/ -I ../src/signal/ -lm -lpthread -o rta_correlation-test
+
+- run
+
+./rta_correlation-test
+
+- check
+
+valgrind --error-limit=no ./rta_correlation-test
+
+*/
+
+
+#undef NDEBUG /* the checks are the test */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "rta_configuration.h"
+#include "rta_correlation.h"
+
+/* rounding errors, relative to the energy of the inputs */
+#define TOLERANCE (sizeof(rta_real_t) == sizeof(float) ? 1e-5 : 1e-12)
+
+static void
+random_vector (rta_real_t *vector, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+	vector[i] = random() / (double) RAND_MAX - 0.5;
+}
+
+/* correlation by direct sums in double precision */
+static void
+reference (double *correlation, int c_size,
+	   const rta_real_t *a, int a_stride,
+	   const rta_real_t *b, int b_stride, int filter_size)
+{
+    int i, f;
+
+    for (i = 0; i < c_size; i++)
+    {
+	correlation[i] = 0;
+	for (f = 0; f < filter_size; f++)
+	    correlation[i] += (double) a[(i + f) * a_stride] * b[f * b_stride];
+    }
+}
+
+/* maximum error of a strided correlation against the reference */
+static double
+error (const rta_real_t *correlation, int c_stride, const double *ref,
+       int c_size, const rta_real_t *a, int a_stride,
+       const rta_real_t *b, int b_stride, int filter_size)
+{
+    double energy_a = 0, energy_b = 0, e = 0;
+    int i;
+
+    for (i = 0; i < c_size + filter_size; i++)
+	energy_a += (double) a[i * a_stride] * a[i * a_stride];
+    for (i = 0; i < filter_size; i++)
+	energy_b += (double) b[i * b_stride] * b[i * b_stride];
+
+    for (i = 0; i < c_size; i++)
+	e = fmax(e, fabs(correlation[i * c_stride] - ref[i]));
+
+    return e / sqrt(energy_a * energy_b);
+}
+
+/* the vectorised direct kernels against the direct sums, for the
+   sizes around the vector blocks of lags */
+static void
+direct_kernels (void)
+{
+    const int channels = 3;
+    double max_error = 0, max_error_double = 0;
+    int c_size, filter_size, stride, k, i;
+
+    for (c_size = 1; c_size < 100; c_size += (c_size < 40 ? 1 : 7))
+    for (filter_size = 1; filter_size < 200; filter_size += 13)
+    {
+	const int a_size = c_size + filter_size;
+	rta_real_t *a = malloc(a_size * channels * sizeof(rta_real_t));
+	rta_real_t *b = malloc(filter_size * channels * sizeof(rta_real_t));
+	rta_real_t *c = malloc(c_size * channels * sizeof(rta_real_t));
+	double *c_double = malloc(c_size * sizeof(double));
+	double *ref = malloc(c_size * sizeof(double));
+
+	random_vector(a, a_size * channels);
+	random_vector(b, filter_size * channels);
+
+	reference(ref, c_size, a, 1, b, 1, filter_size);
+	rta_correlation_fast(c, c_size, a, b, filter_size);
+	max_error = fmax(max_error, error(c, 1, ref, c_size, a, 1, b, 1,
+					  filter_size));
+
+	rta_correlation_fast_double(c_double, c_size, a, b, filter_size);
+	for (i = 0; i < c_size; i++)
+	    max_error_double = fmax(max_error_double,
+				    fabs(c_double[i] - ref[i]) / filter_size);
+
+	/* with a correlation stride different from the input one */
+	for (stride = 2; stride <= channels; stride++)
+	{
+	    reference(ref, c_size, a, stride, b, stride, filter_size);
+	    rta_correlation_fast_stride(c, stride - 1, c_size, a, stride,
+					b, stride, filter_size);
+	    max_error = fmax(max_error, error(c, stride - 1, ref, c_size,
+					      a, stride, b, stride,
+					      filter_size));
+	}
+
+	/* the channel k of interleaved inputs is at offset k with the
+	   stride of the channels */
+	rta_correlation_fast_interleaved(c, channels, c_size, a, b, channels,
+					 channels, filter_size);
+	for (k = 0; k < channels; k++)
+	{
+	    reference(ref, c_size, a + k, channels, b + k, channels,
+		      filter_size);
+	    max_error = fmax(max_error, error(c + k, channels, ref, c_size,
+					      a + k, channels, b + k, channels,
+					      filter_size));
+	}
+
+	free(a);
+	free(b);
+	free(c);
+	free(c_double);
+	free(ref);
+    }
+
+    printf("--- direct kernels: error %g  double error %g\n",
+	   max_error, max_error_double);
+    assert(max_error < TOLERANCE);
+    /* products of single precision values are exact in double */
+    assert(max_error_double < 1e-14);
+}
+
+/* every method of the correlation setups against the direct sums */
+static void
+setup_methods (void)
+{
+    const int sizes[] = { 1, 3, 16, 100, 512, 2048 };
+    const int n = sizeof(sizes) / sizeof(sizes[0]);
+    const rta_correlation_method_t methods[] =
+	{ rta_correlation_auto, rta_correlation_direct, rta_correlation_fft };
+    double max_error = 0;
+    int ci, fi, m;
+
+    for (ci = 0; ci < n; ci++)
+    for (fi = 0; fi < n; fi++)
+    {
+	const int c_size = sizes[ci];
+	const int filter_size = sizes[fi];
+	const int stride = 1 + (ci + fi) % 3;
+	rta_real_t *a = malloc((c_size + filter_size) * stride * sizeof(rta_real_t));
+	rta_real_t *b = malloc(filter_size * stride * sizeof(rta_real_t));
+	rta_real_t *c = malloc(c_size * stride * sizeof(rta_real_t));
+	double *ref = malloc(c_size * sizeof(double));
+	double *ref_stride = malloc(c_size * sizeof(double));
+	rta_correlation_setup_t *setup;
+	int ok;
+
+	random_vector(a, (c_size + filter_size) * stride);
+	random_vector(b, filter_size * stride);
+	reference(ref, c_size, a, 1, b, 1, filter_size);
+	reference(ref_stride, c_size, a, stride, b, stride, filter_size);
+
+	ok = rta_correlation_setup_new(&setup, c_size, filter_size);
+	assert(ok);
+
+	for (m = 0; m < 3; m++)
+	{
+	    ok = rta_correlation_setup_set_method(setup, methods[m]);
+	    assert(ok);
+
+	    rta_correlation_fast_execute(c, a, b, setup);
+	    max_error = fmax(max_error, error(c, 1, ref, c_size, a, 1, b, 1,
+					      filter_size));
+	    assert(max_error < TOLERANCE);
+
+	    rta_correlation_fast_execute_stride(c, stride, a, stride, b, stride,
+						setup);
+	    max_error = fmax(max_error, error(c, stride, ref_stride, c_size,
+					      a, stride, b, stride, filter_size));
+	    assert(max_error < TOLERANCE);
+	}
+
+	rta_correlation_setup_delete(setup);
+	free(a);
+	free(b);
+	free(c);
+	free(ref);
+	free(ref_stride);
+    }
+
+    printf("--- setup methods: error %g\n", max_error);
+}
+
+int main (int argc, char *argv[])
+{
+    direct_kernels();
+    setup_methods();
+
+    return 0;
+}
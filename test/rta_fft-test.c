@@ -0,0 +1,305 @@
+/*
+
+- compile
+
+cc -g ../src/signal/rta_fft.c ../src/signal/rta_fftsimd.c ../src/util/rta_int.c ../src/util/rta_thread.c rta_fft-test.c -I ../bindings/console/ -I ../src -I ../src/util/ -I ../src/signal/ -lm -lpthread -o rta_fft-test
+
+- run
+
+./rta_fft-test
+
+- check
+
+valgrind --error-limit=no ./rta_fft-test
+
+*/
+
+
+#undef NDEBUG /* the checks are the test */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "rta_configuration.h"
+#include "rta_fft.h"
+
+/* real transform and back, with the nyquist value apart or packed */
+static double
+round_trip (int fft_size, int stride, int packed, int in_place)
+{
+    rta_fft_setup_t *forward, *inverse;
+    rta_real_t scale = 1, iscale = 1. / fft_size;
+    rta_real_t nyquist = 0;
+    rta_real_t *nyq = packed ? NULL : &nyquist;
+    rta_real_t *signal   = malloc(fft_size * stride * sizeof(rta_real_t));
+    rta_real_t *buffer   = malloc(fft_size * stride * sizeof(rta_real_t));
+    rta_real_t *spectrum = malloc(fft_size * stride * sizeof(rta_real_t));
+    rta_real_t *output   = in_place ? spectrum : buffer;
+    double error = 0;
+    int ok;
+    int i;
+
+    for (i = 0; i < fft_size; i++)
+	signal[i * stride] = spectrum[i * stride] = random() / (double) RAND_MAX - 0.5;
+
+    ok = rta_fft_real_setup_new_stride(&forward, rta_fft_real_to_complex_1d, &scale,
+				       in_place ? spectrum : signal, stride, fft_size,
+				       spectrum, stride, fft_size, nyq);
+    assert(ok);
+    ok = rta_fft_real_setup_new_stride(&inverse, rta_fft_complex_to_real_1d, &iscale,
+				       spectrum, stride, fft_size / 2,
+				       output, stride, fft_size, nyq);
+    assert(ok);
+
+    rta_fft_real_execute(spectrum, in_place ? spectrum : signal, fft_size, forward, nyq);
+
+    /* DC is real, nyquist value apart or in its imaginary part */
+    if (!packed)
+	assert(spectrum[1] == 0);
+
+    rta_fft_real_execute(output, spectrum, fft_size / 2, inverse, nyq);
+
+    for (i = 0; i < fft_size; i++)
+	if (fabs(output[i * stride] - signal[i * stride]) > error)
+	    error = fabs(output[i * stride] - signal[i * stride]);
+
+    rta_fft_setup_delete(forward);
+    rta_fft_setup_delete(inverse);
+    free(signal);
+    free(buffer);
+    free(spectrum);
+
+    return error;
+}
+
+/* complex transform of a kernel against a direct DFT of some bins
+   (every bin up to 1024 points), with 'threads' for the four-step */
+static double
+direct_dft (int fft_size, int stride, rta_fft_kernel_t kernel, int threads)
+{
+    rta_fft_setup_t *setup;
+    rta_real_t scale = 1;
+    rta_real_t *signal   = malloc(2 * fft_size * stride * sizeof(rta_real_t));
+    rta_real_t *spectrum = malloc(2 * fft_size * stride * sizeof(rta_real_t));
+    int bin_step = fft_size <= 1024 ? 1 : fft_size / 61;
+    double error = 0, max = 0;
+    int ok;
+    int i, k;
+
+    for (i = 0; i < fft_size; i++)
+    {
+	signal[2 * i * stride]     = random() / (double) RAND_MAX - 0.5;
+	signal[2 * i * stride + 1] = random() / (double) RAND_MAX - 0.5;
+    }
+
+    ok = rta_fft_setup_new_stride(&setup, rta_fft_complex_1d, &scale,
+				  (rta_complex_t *) signal, stride, fft_size,
+				  (rta_complex_t *) spectrum, stride, fft_size);
+    assert(ok);
+    ok = rta_fft_setup_set_kernel(setup, kernel);
+    assert(ok);
+    ok = rta_fft_setup_set_threads(setup, threads);
+    assert(ok);
+
+    rta_fft_execute(spectrum, signal, fft_size, setup);
+
+    for (k = 0; k < fft_size; k += bin_step)
+    {
+	double re = 0, im = 0;
+
+	for (i = 0; i < fft_size; i++)
+	{
+	    /* exact phase index, to stay accurate for large sizes */
+	    double w = -2 * M_PI * (((long long) i * k) % fft_size) / fft_size;
+	    double x = signal[2 * i * stride], y = signal[2 * i * stride + 1];
+
+	    re += x * cos(w) - y * sin(w);
+	    im += x * sin(w) + y * cos(w);
+	}
+
+	if (fabs(spectrum[2 * k * stride] - re) > error)
+	    error = fabs(spectrum[2 * k * stride] - re);
+	if (fabs(spectrum[2 * k * stride + 1] - im) > error)
+	    error = fabs(spectrum[2 * k * stride + 1] - im);
+	if (fabs(re) + fabs(im) > max)
+	    max = fabs(re) + fabs(im);
+    }
+
+    rta_fft_setup_delete(setup);
+    free(signal);
+    free(spectrum);
+
+    /* relative to the largest bin */
+    return error / max;
+}
+
+/* batch of frames, with gaps between them and zero padding, against
+   each frame transformed alone */
+static double
+batch (rta_fft_t fft_type, int fft_size, int packed, int frames)
+{
+    const int real_type = fft_type == rta_fft_real_to_complex_1d
+	|| fft_type == rta_fft_complex_to_real_1d;
+    /* sizes of the frames, as numbers of real values */
+    const int in_size = fft_type == rta_fft_complex_to_real_1d ? fft_size
+	: (real_type ? fft_size : 2 * fft_size);
+    const int out_size = fft_type == rta_fft_real_to_complex_1d ? fft_size
+	: (real_type ? fft_size : 2 * fft_size);
+    const int in_complex = fft_type != rta_fft_real_to_complex_1d;
+    const int out_complex = fft_type != rta_fft_complex_to_real_1d;
+    /* strides and input size as numbers of input or output values */
+    const int i_frame_stride = (in_size >> in_complex) + 3;
+    const int o_frame_stride = (out_size >> out_complex) + 1;
+    const int input_size = (in_size >> in_complex) - 1;
+    const int i_frame_size = i_frame_stride << in_complex;
+    const int o_frame_size = o_frame_stride << out_complex;
+    rta_real_t scale = 0.5;
+    rta_real_t *input = malloc(frames * i_frame_size * sizeof(rta_real_t));
+    rta_real_t *output = malloc(frames * o_frame_size * sizeof(rta_real_t));
+    rta_real_t *frame_input = malloc(in_size * sizeof(rta_real_t));
+    rta_real_t *ref = malloc(out_size * sizeof(rta_real_t));
+    rta_real_t *nyquist = malloc(frames * sizeof(rta_real_t));
+    rta_real_t ref_nyquist;
+    rta_fft_setup_t *setup, *frame_setup;
+    double error = 0, max = 0;
+    int ok;
+    int f, i;
+
+    for (i = 0; i < frames * i_frame_size; i++)
+	input[i] = random() / (double) RAND_MAX - 0.5;
+    for (i = 0; i < frames * o_frame_size; i++)
+	output[i] = 1234;
+    for (f = 0; f < frames; f++)
+	nyquist[f] = random() / (double) RAND_MAX - 0.5;
+
+    if (real_type)
+    {
+	ok = rta_fft_real_setup_new(&setup, fft_type, &scale, input, input_size,
+				    output, fft_size, NULL);
+	assert(ok);
+	ok = rta_fft_real_setup_new(&frame_setup, fft_type, &scale,
+				    frame_input, input_size, ref, fft_size,
+				    NULL);
+	assert(ok);
+    }
+    else
+    {
+	ok = rta_fft_setup_new(&setup, fft_type, &scale,
+			       (rta_complex_t *) input, input_size,
+			       (rta_complex_t *) output, fft_size);
+	assert(ok);
+	ok = rta_fft_setup_new(&frame_setup, fft_type, &scale,
+			       (rta_complex_t *) frame_input, input_size,
+			       (rta_complex_t *) ref, fft_size);
+	assert(ok);
+    }
+
+    if (real_type)
+	rta_fft_real_execute_batch(output, o_frame_stride, input, i_frame_stride,
+				   input_size, setup, packed ? NULL : nyquist,
+				   frames);
+    else
+	rta_fft_execute_batch(output, o_frame_stride, input, i_frame_stride,
+			      input_size, setup, frames);
+
+    for (f = 0; f < frames; f++)
+    {
+	/* the frame alone, from the same input */
+	for (i = 0; i < in_size; i++)
+	    frame_input[i] = input[f * i_frame_size + i];
+	ref_nyquist = nyquist[f];
+	if (real_type)
+	    rta_fft_real_execute(ref, frame_input, input_size, frame_setup,
+				 packed ? NULL : &ref_nyquist);
+	else
+	    rta_fft_execute(ref, frame_input, input_size, frame_setup);
+
+	for (i = 0; i < out_size; i++)
+	{
+	    error = fmax(error, fabs(output[f * o_frame_size + i] - ref[i]));
+	    max = fmax(max, fabs(ref[i]));
+	}
+	if (fft_type == rta_fft_real_to_complex_1d && !packed)
+	    error = fmax(error, fabs(nyquist[f] - ref_nyquist));
+
+	/* the gaps are untouched */
+	for (i = out_size; i < o_frame_size; i++)
+	    assert(output[f * o_frame_size + i] == 1234);
+    }
+
+    rta_fft_setup_delete(setup);
+    rta_fft_setup_delete(frame_setup);
+    free(input);
+    free(output);
+    free(frame_input);
+    free(ref);
+    free(nyquist);
+
+    /* relative to the largest value */
+    return error / max;
+}
+
+int main (int argc, char *argv[])
+{
+    /* powers of 2 and mixed radix sizes */
+    int sizes[] = { 4, 8, 16, 64, 256, 1024, 4096, 6, 12, 30, 96, 210, 960, 1500 };
+    unsigned int s;
+
+    for (s = 0; s < sizeof(sizes) / sizeof(int); s++)
+    for (int stride = 1; stride <= 3; stride++)
+    for (int packed = 0; packed < 2; packed++)
+    for (int in_place = 0; in_place < 2; in_place++)
+    {
+	double error = round_trip(sizes[s], stride, packed, in_place);
+
+	printf("--- size %4d  stride %d  packed %d  in place %d: error %g\n",
+	       sizes[s], stride, packed, in_place, error);
+	assert(error < 1e-4);
+    }
+
+    /* every kernel against a direct DFT, with mixed radix sizes (which
+       do not depend on the kernel) and four-step sizes */
+    {
+	int dft_sizes[] = { 2, 4, 8, 32, 128, 512, 2048, 12, 60, 105, 1500,
+			    1 << 17, 1 << 18 };
+	rta_fft_kernel_t kernels[] = { rta_fft_radix_2, rta_fft_radix_4,
+				       rta_fft_stockham, rta_fft_four_step };
+	const char *names[] = { "radix-2", "radix-4", "stockham", "four-step" };
+	int k;
+
+	for (s = 0; s < sizeof(dft_sizes) / sizeof(int); s++)
+	for (k = 0; k < 4; k++)
+	for (int stride = 1; stride <= 2; stride++)
+	for (int threads = 1; threads <= (k == 3 ? 3 : 1); threads += 2)
+	{
+	    double error = direct_dft(dft_sizes[s], stride, kernels[k], threads);
+
+	    printf("--- dft size %6d  %-9s  stride %d  threads %d: error %g\n",
+		   dft_sizes[s], names[k], stride, threads, error);
+	    assert(error < (sizeof(rta_real_t) == sizeof(float) ? 1e-5 : 1e-12));
+	}
+    }
+
+    /* batches by tiles of frames or frame by frame (larger sizes),
+       with remaining frames */
+    {
+	int batch_sizes[] = { 4, 8, 16, 256, 2048, 4096, 12, 60, 100, 960 };
+	rta_fft_t types[] = { rta_fft_complex_1d, rta_fft_complex_inverse_1d,
+			      rta_fft_real_to_complex_1d,
+			      rta_fft_complex_to_real_1d };
+	int t, packed;
+
+	for (s = 0; s < sizeof(batch_sizes) / sizeof(int); s++)
+	for (t = 0; t < 4; t++)
+	for (packed = 0; packed < (t < 2 ? 1 : 2); packed++)
+	{
+	    double error = batch(types[t], batch_sizes[s], packed, 21);
+
+	    printf("--- batch size %4d  type %d  packed %d: error %g\n",
+		   batch_sizes[s], types[t], packed, error);
+	    assert(error < (sizeof(rta_real_t) == sizeof(float) ? 1e-6 : 1e-14));
+	}
+    }
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*
+
+- compile
+
+cc -g ../src/signal/rta_fft_f.c ../src/signal/rta_fft_d.c ../src/util/rta_int.c ../src/util/rta_thread.c rta_fft_typed-test.c -I ../bindings/console/ -I ../src -I ../src/util/ -I ../src/signal/ -lm -lpthread -o rta_fft_typed-test
+
+- run
+
+./rta_fft_typed-test
+
+- check
+
+valgrind --error-limit=no ./rta_fft_typed-test
+
+*/
+
+
+#undef NDEBUG /* the checks are the test */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "rta_fft_typed.h"
+
+/* both precisions in the same executable: the same tests are defined
+   for each prefix of the typed functions ('f' or 'd') */
+#define TYPED_TESTS(p, real)						\
+									\
+/* real transform and back, with the nyquist value apart */		\
+static double								\
+round_trip_##p (int fft_size)						\
+{									\
+    rta_fft_##p##_setup_t *forward, *inverse;				\
+    real scale = 1, iscale = 1. / fft_size;				\
+    real nyquist = 0;							\
+    real *signal   = malloc(fft_size * sizeof(real));			\
+    real *spectrum = malloc(fft_size * sizeof(real));			\
+    real *output   = malloc(fft_size * sizeof(real));			\
+    double error = 0;							\
+    int ok;								\
+    int i;								\
+									\
+    for (i = 0; i < fft_size; i++)					\
+	signal[i] = random() / (double) RAND_MAX - 0.5;			\
+									\
+    ok = rta_fft_##p##_real_setup_new(&forward, rta_fft_real_to_complex_1d, \
+				      &scale, signal, fft_size,		\
+				      spectrum, fft_size, &nyquist);	\
+    assert(ok);								\
+    ok = rta_fft_##p##_real_setup_new(&inverse, rta_fft_complex_to_real_1d, \
+				      &iscale, spectrum, fft_size / 2,	\
+				      output, fft_size, &nyquist);	\
+    assert(ok);								\
+									\
+    rta_fft_##p##_real_execute(spectrum, signal, fft_size, forward, &nyquist); \
+    rta_fft_##p##_real_execute(output, spectrum, fft_size / 2, inverse, \
+			       &nyquist);				\
+									\
+    for (i = 0; i < fft_size; i++)					\
+	error = fmax(error, fabs(output[i] - signal[i]));		\
+									\
+    rta_fft_##p##_setup_delete(forward);					\
+    rta_fft_##p##_setup_delete(inverse);					\
+    free(signal);							\
+    free(spectrum);							\
+    free(output);							\
+									\
+    return error;							\
+}									\
+									\
+/* complex transform of a kernel against a direct DFT in double	\
+   precision, relative to the largest bin */				\
+static double								\
+direct_dft_##p (int fft_size, rta_fft_kernel_t kernel)			\
+{									\
+    rta_fft_##p##_setup_t *setup;					\
+    real scale = 1;							\
+    real *signal   = malloc(2 * fft_size * sizeof(real));		\
+    real *spectrum = malloc(2 * fft_size * sizeof(real));		\
+    double error = 0, max = 0;						\
+    int ok;								\
+    int i, k;								\
+									\
+    for (i = 0; i < 2 * fft_size; i++)					\
+	signal[i] = random() / (double) RAND_MAX - 0.5;			\
+									\
+    ok = rta_fft_##p##_setup_new(&setup, rta_fft_complex_1d, &scale,	\
+				 (rta_fft_##p##_complex_t *) signal, fft_size, \
+				 (rta_fft_##p##_complex_t *) spectrum, fft_size); \
+    assert(ok);								\
+    ok = rta_fft_##p##_setup_set_kernel(setup, kernel);			\
+    assert(ok);								\
+									\
+    rta_fft_##p##_execute(spectrum, signal, fft_size, setup);		\
+									\
+    for (k = 0; k < fft_size; k++)					\
+    {									\
+	double re = 0, im = 0;						\
+									\
+	for (i = 0; i < fft_size; i++)					\
+	{								\
+	    double w = -2 * M_PI * ((i * k) % fft_size) / fft_size;	\
+									\
+	    re += signal[2 * i] * cos(w) - signal[2 * i + 1] * sin(w);	\
+	    im += signal[2 * i] * sin(w) + signal[2 * i + 1] * cos(w);	\
+	}								\
+									\
+	error = fmax(error, fabs(spectrum[2 * k] - re));		\
+	error = fmax(error, fabs(spectrum[2 * k + 1] - im));		\
+	max = fmax(max, fabs(re) + fabs(im));				\
+    }									\
+									\
+    rta_fft_##p##_setup_delete(setup);					\
+    free(signal);							\
+    free(spectrum);							\
+									\
+    return error / max;							\
+}
+
+TYPED_TESTS(f, float)
+TYPED_TESTS(d, double)
+
+int main (int argc, char *argv[])
+{
+    /* powers of 2 and mixed radix sizes */
+    const int sizes[] = { 4, 16, 256, 2048, 12, 60, 960 };
+    const int n = sizeof(sizes) / sizeof(sizes[0]);
+    rta_fft_kernel_t kernels[] = { rta_fft_radix_4, rta_fft_stockham };
+    const char *names[] = { "radix-4", "stockham" };
+    int s, k;
+
+    for (s = 0; s < n; s++)
+    {
+	double error_f = round_trip_f(sizes[s]);
+	double error_d = round_trip_d(sizes[s]);
+
+	printf("--- round trip size %4d: float error %g  double error %g\n",
+	       sizes[s], error_f, error_d);
+	assert(error_f < 1e-6);
+	assert(error_d < 1e-13);
+    }
+
+    for (s = 0; s < n; s++)
+    for (k = 0; k < 2; k++)
+    {
+	double error_f = direct_dft_f(sizes[s], kernels[k]);
+	double error_d = direct_dft_d(sizes[s], kernels[k]);
+
+	printf("--- dft size %4d  %-8s: float error %g  double error %g\n",
+	       sizes[s], names[k], error_f, error_d);
+	assert(error_f < 1e-6);
+	assert(error_d < 1e-12);
+    }
+
+    return 0;
+}
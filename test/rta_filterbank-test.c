@@ -0,0 +1,111 @@
+/*
+
+- compile
+
+cc -g ../src/signal/rta_filterbank.c ../src/signal/rta_biquad_cascade.c ../src/signal/rta_biquad.c ../src/signal/rta_biquadsimd.c rta_filterbank-test.c -I ../bindings/console/ -I ../src -I ../src/util/ -I ../src/signal/ -lm -o rta_filterbank-test
+
+- run
+
+./rta_filterbank-test
+
+- check
+
+valgrind --error-limit=no ./rta_filterbank-test
+
+*/
+
+
+#undef NDEBUG /* the checks are the test */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "rta_configuration.h"
+#include "rta_filterbank.h"
+
+/* gain in dB of a band for a sine, from the RMS of the output and of
+   the envelope, after the transient */
+static double
+band_gain (rta_filterbank_setup_t *fb, int band, double frequency,
+	   double sample_rate, double *envelope_gain)
+{
+    const int frames = (int) sample_rate;
+    const int bands = rta_filterbank_bands(fb);
+    const int block = 100;
+    rta_real_t *input  = malloc(frames * sizeof(rta_real_t));
+    rta_real_t *output = malloc(frames * bands * sizeof(rta_real_t));
+    rta_real_t *envelopes = malloc(bands * sizeof(rta_real_t));
+    double energy = 0;
+    int i;
+
+    for (i = 0; i < frames; i++)
+	input[i] = sin(2 * M_PI * frequency * i / sample_rate);
+
+    rta_filterbank_setup_clear(fb);
+    rta_filterbank_setup_set_envelope_time(fb, 0.05);
+    for (i = 0; i < frames; i += block)
+	rta_filterbank_process(output + i * bands, envelopes, input + i,
+			       frames - i < block ? frames - i : block, fb);
+
+    for (i = frames / 2; i < frames; i++)
+	energy += output[i * bands + band] * output[i * bands + band];
+
+    /* the RMS of the sine is sqrt(0.5) */
+    *envelope_gain = 20 * log10(envelopes[band] / sqrt(0.5));
+    energy = 20 * log10(sqrt(energy / (frames - frames / 2)) / sqrt(0.5));
+
+    free(input);
+    free(output);
+    free(envelopes);
+
+    return energy;
+}
+
+int main (int argc, char *argv[])
+{
+    const double sample_rate = 48000;
+    int bands_per_octave, sections;
+    rta_filterbank_setup_t *fb;
+    int ok;
+
+    for (bands_per_octave = 1; bands_per_octave <= 3; bands_per_octave += 2)
+    for (sections = 1; sections <= 3; sections++)
+    {
+	const double edge = pow(2, 0.5 / bands_per_octave);
+	int bands, b;
+
+	ok = rta_filterbank_setup_new(&fb, bands_per_octave, 20, 20000,
+				      sections, sample_rate);
+	assert(ok);
+	bands = rta_filterbank_bands(fb);
+
+	/* the band of 1 kHz and the last one, close to nyquist */
+	for (b = 0; b < bands; b++)
+	{
+	    double centre = rta_filterbank_frequency(fb, b);
+	    double low, high, envelope_low, envelope_high;
+
+	    if (fabs(centre - 1000) > 1 && b != bands - 1)
+		continue;
+
+	    /* -3 dB at the band edges */
+	    low  = band_gain(fb, b, centre / edge, sample_rate, &envelope_low);
+	    high = band_gain(fb, b, centre * edge, sample_rate, &envelope_high);
+
+	    printf("--- %d bands per octave  %d sections  band %7.1f Hz: edges %.3f %.3f dB  envelopes %.3f %.3f dB\n",
+		   bands_per_octave, sections, centre, low, high,
+		   envelope_low, envelope_high);
+	    assert(fabs(low + 3.01) < 0.05 && fabs(high + 3.01) < 0.05);
+	    assert(fabs(envelope_low - low) < 0.5 &&
+		   fabs(envelope_high - high) < 0.5);
+	}
+
+	rta_filterbank_setup_delete(fb);
+    }
+
+    /* no band in the range */
+    ok = rta_filterbank_setup_new(&fb, 3, 30000, 40000, 1, sample_rate);
+    assert(!ok);
+
+    return 0;
+}
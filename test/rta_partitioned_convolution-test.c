@@ -0,0 +1,140 @@
+/*
+
+- compile
+
+cc -g ../src/signal/rta_partitioned_convolution.c ../src/signal/rta_correlation.c ../src/signal/rta_correlationsimd.c ../src/signal/rta_fft.c ../src/signal/rta_fftsimd.c ../src/util/rta_int.c ../src/util/rta_thread.c rta_partitioned_convolution-test.c -I ../bindings/console/ -I ../src -I ../src/util/ -I ../src/signal/ -lm -lpthread -o rta_partitioned_convolution-test
+
+- run
+
+./rta_partitioned_convolution-test
+
+- check
+
+valgrind --error-limit=no ./rta_partitioned_convolution-test
+
+*/
+
+
+#undef NDEBUG /* the checks are the test */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "rta_configuration.h"
+#include "rta_partitioned_convolution.h"
+
+/* rounding errors, relative to the size of the impulse response */
+#define TOLERANCE (sizeof(rta_real_t) == sizeof(float) ? 1e-5 : 1e-12)
+
+static void
+random_vector (rta_real_t *vector, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+	vector[i] = random() / (double) RAND_MAX - 0.5;
+}
+
+/* output n of the convolution of x by h, by a direct sum in double
+   precision */
+static double
+reference (const rta_real_t *h, int impulse_size, const rta_real_t *x, int n)
+{
+    double y = 0;
+    int i;
+
+    for (i = 0; i < impulse_size && i <= n; i++)
+	y += (double) h[i] * x[n - i];
+
+    return y;
+}
+
+/* block processing against the direct sums, without latency, over the
+   whole impulse response and after a clear */
+static double
+blocks (int impulse_size, int block_size, int max_partition_size,
+	int stride, int in_place)
+{
+    const int size = (impulse_size + 40 * block_size)
+	/ block_size * block_size;
+    rta_real_t *h = malloc(impulse_size * sizeof(rta_real_t));
+    rta_real_t *x = malloc(size * sizeof(rta_real_t));
+    rta_real_t *input = malloc(block_size * stride * sizeof(rta_real_t));
+    rta_real_t *output = malloc(block_size * stride * sizeof(rta_real_t));
+    rta_real_t *y = in_place ? input : output;
+    rta_partitioned_convolution_setup_t *setup;
+    rta_real_t worst, average;
+    double e = 0;
+    int ok, pass, b, i;
+
+    /* decaying, as a room response */
+    random_vector(h, impulse_size);
+    for (i = 0; i < impulse_size; i++)
+	h[i] *= exp(-3. * i / impulse_size);
+    random_vector(x, size);
+
+    ok = rta_partitioned_convolution_setup_new(&setup, h, impulse_size,
+					       block_size, max_partition_size);
+    assert(ok);
+
+    worst = rta_partitioned_convolution_worst_cost(setup, &average);
+    assert(worst > 0 && average > 0 && average <= worst);
+
+    for (pass = 0; pass < 2; pass++)
+    {
+	if (pass > 0)
+	    rta_partitioned_convolution_setup_clear(setup);
+
+	for (b = 0; b < size / block_size; b++)
+	{
+	    for (i = 0; i < block_size; i++)
+		input[i * stride] = x[b * block_size + i];
+
+	    rta_partitioned_convolution_process_stride(y, stride, input, stride,
+						       setup);
+
+	    for (i = 0; i < block_size; i++)
+		e = fmax(e, fabs(y[i * stride]
+				 - reference(h, impulse_size, x,
+					     b * block_size + i)));
+	}
+    }
+
+    rta_partitioned_convolution_setup_delete(setup);
+    free(h);
+    free(x);
+    free(input);
+    free(output);
+
+    return e / sqrt(impulse_size);
+}
+
+int main (int argc, char *argv[])
+{
+    const int impulse_sizes[] = { 1, 7, 64, 100, 1000, 5000 };
+    const int block_sizes[] = { 1, 3, 16, 64, 100 };
+    const int max_partition_sizes[] = { 0, 64, 256, 4096 };
+    double max_error = 0;
+    int h, b, m, stride, in_place;
+
+    for (h = 0; h < 6; h++)
+    for (b = 0; b < 5; b++)
+    for (m = 0; m < 4; m++)
+    for (stride = 1; stride <= 2; stride++)
+    for (in_place = 0; in_place <= 1; in_place++)
+    {
+	double e = blocks(impulse_sizes[h], block_sizes[b],
+			  max_partition_sizes[m], stride, in_place);
+
+	if (e >= TOLERANCE)
+	    printf("--- impulse %d  block %d  partition %d  stride %d  in place %d: error %g\n",
+		   impulse_sizes[h], block_sizes[b], max_partition_sizes[m],
+		   stride, in_place, e);
+	max_error = fmax(max_error, e);
+    }
+
+    printf("--- partitioned convolution: error %g\n", max_error);
+    assert(max_error < TOLERANCE);
+
+    return 0;
+}
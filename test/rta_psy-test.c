@@ -0,0 +1,248 @@
+/*
+
+- compile
+
+cc -g ../src/signal/rta_psy.c rta_psy-test.c -I ../bindings/console/ -I ../src -I ../src/util/ -I ../src/signal/ -lm -o rta_psy-test
+
+- run
+
+./rta_psy-test
+
+- check
+
+valgrind --error-limit=no ./rta_psy-test
+
+*/
+
+
+#undef NDEBUG /* the checks are the test */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "rta_psy.h"
+
+#define SAMPLE_RATE 44100
+#define CHANNELS 5
+#define VECTOR_SIZE 256
+#define MAX_RESULTS 4000
+
+/* results of the mono analysers, one per channel */
+static rta_psy_output_t mono_results[CHANNELS][MAX_RESULTS];
+static int mono_count[CHANNELS];
+
+/* results of the multichannel analyser, appended per input vector */
+static rta_psy_output_t multi_results[CHANNELS][MAX_RESULTS];
+static int multi_count[CHANNELS];
+static int multi_callbacks;
+
+static int
+mono_callback (void *receiver, double time, double freq, double energy,
+	       double ac1, double voiced)
+{
+    int c = *(int *) receiver;
+    rta_psy_output_t *result = &mono_results[c][mono_count[c]++];
+
+    assert(mono_count[c] <= MAX_RESULTS);
+    result->time = time;
+    result->freq = freq;
+    result->energy = energy;
+    result->ac1 = ac1;
+    result->voiced = voiced;
+
+    return 1;
+}
+
+static int
+multi_callback (void *receiver, int num_channels, const int *num_outputs,
+		const rta_psy_output_t *outputs, int max_outputs)
+{
+    int c, i;
+
+    assert(num_channels == CHANNELS);
+    for (c = 0; c < num_channels; c++)
+    {
+	assert(num_outputs[c] <= max_outputs);
+	for (i = 0; i < num_outputs[c]; i++)
+	{
+	    assert(multi_count[c] < MAX_RESULTS);
+	    multi_results[c][multi_count[c]++] = outputs[c * max_outputs + i];
+	}
+    }
+    multi_callbacks++;
+
+    return 1;
+}
+
+/* maximum error of the incremental autocorrelation of the last
+   analysis frame, relative to its energy, checked at every frame from
+   quiet_time (in msec) and at every 16 frames before */
+static double autocorrelation_error;
+static double quiet_time;
+static int autocorrelation_frames;
+
+static int
+autocorrelation_callback (void *receiver, double time, double freq,
+			  double energy, double ac1, double voiced)
+{
+    rta_psy_ana_t *ana = (rta_psy_ana_t *) receiver;
+    int n = (int) ceil(ana->maxPeriod);
+    double energy0 = 0;
+    int i, j;
+
+    if (time < quiet_time && autocorrelation_frames++ % 16 != 0)
+	return 1;
+
+    /* the frame of the last estimation is still in the input buffer */
+    for (i = 0; i < n; i++)
+    {
+	double c = 0;
+
+	for (j = 0; j < n; j++)
+	    c += (double) ana->inputBuffer[j] * ana->inputBuffer[i + j];
+
+	if (i == 0)
+	    energy0 = c;
+
+	autocorrelation_error = fmax(autocorrelation_error,
+				     fabs(ana->corrBuffer[i] - c) / energy0);
+    }
+
+    return 1;
+}
+
+/* the autocorrelation kept incrementally between the analysis frames
+   against the autocorrelation of each frame, on a quiet tone after a
+   long loud noise, where the errors of the updates would accumulate */
+static void
+incremental_autocorrelation (double min_freq, int down_sampling_exp)
+{
+    const int loud = 3 * SAMPLE_RATE;
+    const int frames = loud + SAMPLE_RATE;
+    float *input = malloc(frames * sizeof(float));
+    rta_psy_ana_t ana;
+    int i;
+
+    for (i = 0; i < loud; i++)
+	input[i] = 2. * random() / RAND_MAX - 1.;
+    for (; i < frames; i++)
+	input[i] = 1e-3 * sin(2 * M_PI * 220. * i / SAMPLE_RATE);
+
+    rta_psy_init(&ana);
+    rta_psy_reset(&ana, min_freq, 2000, SAMPLE_RATE, VECTOR_SIZE,
+		  down_sampling_exp);
+    rta_psy_set_callback(&ana, &ana, autocorrelation_callback);
+    autocorrelation_error = 0;
+    autocorrelation_frames = 0;
+    quiet_time = 1000. * loud / SAMPLE_RATE;
+
+    for (i = 0; i + VECTOR_SIZE <= frames; i += VECTOR_SIZE)
+	rta_psy_calculate_input_vector(&ana, input + i, VECTOR_SIZE, 1);
+
+    printf("--- min freq %g  down sampling %d: autocorrelation error %g\n",
+	   min_freq, down_sampling_exp, autocorrelation_error);
+    assert(autocorrelation_error < 1e-5);
+
+    rta_psy_deinit(&ana);
+    free(input);
+}
+
+/* the multichannel analyser gives the same results as a mono analyser
+   per channel */
+static void
+multi_vs_mono (const float *input, int frames, int down_sampling_exp)
+{
+    float *channel = malloc(frames * sizeof(float));
+    rta_psy_multi_ana_t multi;
+    int c, i;
+
+    for (c = 0; c < CHANNELS; c++)
+    {
+	rta_psy_ana_t mono;
+
+	rta_psy_init(&mono);
+	rta_psy_reset(&mono, 50, 2000, SAMPLE_RATE, VECTOR_SIZE,
+		      down_sampling_exp);
+	rta_psy_set_callback(&mono, &c, mono_callback);
+	mono_count[c] = 0;
+
+	for (i = 0; i < frames; i++)
+	    channel[i] = input[i * CHANNELS + c];
+	for (i = 0; i + VECTOR_SIZE <= frames; i += VECTOR_SIZE)
+	    rta_psy_calculate_input_vector(&mono, channel + i, VECTOR_SIZE, 1);
+
+	rta_psy_deinit(&mono);
+    }
+
+    /* grow from fewer channels to check the reallocation */
+    rta_psy_multi_init(&multi);
+    rta_psy_multi_reset(&multi, 2, 50, 2000, SAMPLE_RATE, VECTOR_SIZE,
+			down_sampling_exp);
+    rta_psy_multi_reset(&multi, CHANNELS, 50, 2000, SAMPLE_RATE, VECTOR_SIZE,
+			down_sampling_exp);
+    rta_psy_multi_set_callback(&multi, NULL, multi_callback);
+    multi_callbacks = 0;
+    for (c = 0; c < CHANNELS; c++)
+	multi_count[c] = 0;
+
+    for (i = 0; i + VECTOR_SIZE <= frames; i += VECTOR_SIZE)
+	rta_psy_multi_calculate_input_vector(&multi, (float *) input + i * CHANNELS,
+					     VECTOR_SIZE);
+
+    printf("--- down sampling %d: %d callbacks for", down_sampling_exp,
+	   multi_callbacks);
+    for (c = 0; c < CHANNELS; c++)
+    {
+	printf(" %d", multi_count[c]);
+	assert(multi_count[c] > 0 && multi_count[c] == mono_count[c]);
+
+	for (i = 0; i < mono_count[c]; i++)
+	{
+	    assert(multi_results[c][i].time == mono_results[c][i].time);
+	    assert(multi_results[c][i].freq == mono_results[c][i].freq);
+	    assert(multi_results[c][i].energy == mono_results[c][i].energy);
+	    assert(multi_results[c][i].ac1 == mono_results[c][i].ac1);
+	    assert(multi_results[c][i].voiced == mono_results[c][i].voiced);
+	}
+    }
+    printf(" results\n");
+
+    /* at most one callback per input vector */
+    assert(multi_callbacks > 0 && multi_callbacks <= frames / VECTOR_SIZE);
+
+    rta_psy_multi_deinit(&multi);
+    free(channel);
+}
+
+int main (int argc, char *argv[])
+{
+    const int frames = 2 * SAMPLE_RATE;
+    float *input = malloc(frames * CHANNELS * sizeof(float));
+    int c, i;
+
+    /* a gliding harmonic tone per channel, with a little noise */
+    for (c = 0; c < CHANNELS; c++)
+    {
+	double phase = 0;
+
+	for (i = 0; i < frames; i++)
+	{
+	    double freq = 100 + 70 * c + 30 * sin(i * 2e-5 * (c + 1));
+
+	    phase += 2 * M_PI * freq / SAMPLE_RATE;
+	    input[i * CHANNELS + c] = 0.5 * sin(phase) + 0.2 * sin(2 * phase)
+		+ 0.01 * (random() / (double) RAND_MAX - 0.5);
+	}
+    }
+
+    for (i = 0; i <= 3; i++)
+	multi_vs_mono(input, frames, i);
+
+    incremental_autocorrelation(50, 0);
+    incremental_autocorrelation(30, 0);
+    incremental_autocorrelation(30, 2);
+
+    free(input);
+
+    return 0;
+}
@@ -0,0 +1,270 @@
+/*
+
+- compile
+
+cc -g ../src/signal/rta_yin.c ../src/signal/rta_correlation.c ../src/signal/rta_correlationsimd.c ../src/signal/rta_fft.c ../src/signal/rta_fftsimd.c ../src/util/rta_int.c ../src/util/rta_thread.c rta_yin-test.c -I ../bindings/console/ -I ../src -I ../src/util/ -I ../src/signal/ -lm -lpthread -o rta_yin-test
+
+- run
+
+./rta_yin-test
+
+- check
+
+valgrind --error-limit=no ./rta_yin-test
+
+*/
+
+
+#undef NDEBUG /* the checks are the test */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "rta_configuration.h"
+#include "rta_yin.h"
+
+#define SAMPLE_RATE 44100
+#define AC_SIZE 512
+#define INPUT_SIZE 1536 /* window of 1024 points */
+#define THRESHOLD 0.1
+
+/* sliding yin against rta_yin on a quiet sine after a long loud noise,
+   where the errors of the updates would accumulate */
+static void
+sliding_long_run (int hop_size, double loud_seconds)
+{
+    const int loud = (int) (loud_seconds * SAMPLE_RATE) / hop_size * hop_size;
+    const int size = loud + SAMPLE_RATE;
+    rta_real_t *signal = malloc(size * sizeof(rta_real_t));
+    rta_real_t ac_sliding[AC_SIZE], ac_frame[AC_SIZE];
+    rta_yin_sliding_setup_t *sliding;
+    rta_yin_setup_t *yin;
+    double ac_error = 0, lag_error = 0;
+    int ok;
+    int pos, i;
+
+    for (i = 0; i < loud; i++)
+	signal[i] = 2. * random() / RAND_MAX - 1.;
+    for (; i < size; i++)
+	signal[i] = 1e-3 * sin(2 * M_PI * 220. * i / SAMPLE_RATE);
+
+    ok = rta_yin_sliding_setup_new(&sliding, 128, AC_SIZE, INPUT_SIZE);
+    assert(ok);
+    ok = rta_yin_setup_new(&yin, 128);
+    assert(ok);
+
+    for (pos = 0; pos + hop_size <= size; pos += hop_size)
+    {
+	rta_real_t min_sliding, min_frame, lag_sliding, lag_frame;
+
+	lag_sliding = rta_yin_sliding(&min_sliding, ac_sliding, signal + pos,
+				      hop_size, sliding, THRESHOLD);
+
+	/* after the transition, the window is on the sine only */
+	if (pos + hop_size < loud + INPUT_SIZE)
+	    continue;
+
+	lag_frame = rta_yin(&min_frame, ac_frame, AC_SIZE,
+			    signal + pos + hop_size - INPUT_SIZE, INPUT_SIZE,
+			    yin, THRESHOLD);
+
+	for (i = 0; i < AC_SIZE; i++)
+	    ac_error = fmax(ac_error, fabs(ac_sliding[i] - ac_frame[i]) / ac_frame[0]);
+	lag_error = fmax(lag_error, fabs(lag_sliding - lag_frame));
+    }
+
+    printf("--- sliding hop %4d  after %g s of noise: autocorrelation error %g  lag error %g (lag %g)\n",
+	   hop_size, loud_seconds, ac_error, lag_error,
+	   (double) SAMPLE_RATE / 220.);
+    assert(ac_error < 1e-4);
+    assert(lag_error < 1e-2);
+
+    rta_yin_sliding_setup_delete(sliding);
+    rta_yin_setup_delete(yin);
+    free(signal);
+}
+
+/* a harmonic tone with a little noise */
+static void
+tone (rta_real_t *signal, int stride, int size, double frequency,
+      double sample_rate)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+	signal[i * stride] = sin(2 * M_PI * frequency * i / sample_rate)
+	    + 0.3 * sin(2 * M_PI * frequency * 2.01 * i / sample_rate)
+	    + 0.01 * (random() / (double) RAND_MAX - 0.5);
+}
+
+/* yin with the FFT and automatic autocorrelation methods against the
+   direct one */
+static void
+fft_method (unsigned int ac_size, unsigned int input_size)
+{
+    const rta_correlation_method_t methods[] =
+	{ rta_correlation_fft, rta_correlation_auto };
+    rta_real_t *signal = malloc(2 * input_size * sizeof(rta_real_t));
+    rta_real_t *ac_direct = malloc(ac_size * sizeof(rta_real_t));
+    rta_real_t *ac = malloc(2 * ac_size * sizeof(rta_real_t));
+    rta_yin_setup_t *direct, *yin;
+    double ac_error = 0, lag_error = 0, min_error = 0;
+    int ok;
+    int m, f;
+    unsigned int i;
+
+    ok = rta_yin_setup_new(&direct, 128);
+    assert(ok);
+
+    for (m = 0; m < 2; m++)
+    {
+	ok = rta_yin_setup_new_with_method(&yin, 128, ac_size, input_size,
+					   methods[m]);
+	assert(ok);
+
+	for (f = 0; f < 50; f++)
+	{
+	    rta_real_t min_direct, min, min_stride, lag_direct, lag, lag_stride;
+
+	    tone(signal, 2, input_size, 60 + 10 * f, 48000);
+	    lag_direct = rta_yin_stride(&min_direct, ac_direct, 1, ac_size,
+					signal, 2, input_size, direct, THRESHOLD);
+	    lag_stride = rta_yin_stride(&min_stride, ac, 2, ac_size,
+					signal, 2, input_size, yin, THRESHOLD);
+	    for (i = 0; i < ac_size; i++)
+		ac_error = fmax(ac_error, fabs(ac[2 * i] - ac_direct[i])
+				/ ac_direct[0]);
+
+	    /* contiguous */
+	    for (i = 0; i < input_size; i++)
+		signal[i] = signal[2 * i];
+	    lag = rta_yin(&min, ac, ac_size, signal, input_size, yin,
+			  THRESHOLD);
+	    for (i = 0; i < ac_size; i++)
+		ac_error = fmax(ac_error, fabs(ac[i] - ac_direct[i])
+				/ ac_direct[0]);
+
+	    lag_error = fmax(lag_error, fabs(lag - lag_direct) / lag_direct);
+	    lag_error = fmax(lag_error, fabs(lag_stride - lag_direct)
+			     / lag_direct);
+	    min_error = fmax(min_error, fabs(min - min_direct));
+	    min_error = fmax(min_error, fabs(min_stride - min_direct));
+	}
+
+	rta_yin_setup_delete(yin);
+    }
+
+    printf("--- fft method ac %4u  input %4u: autocorrelation error %g  lag error %g  minimum error %g\n",
+	   ac_size, input_size, ac_error, lag_error, min_error);
+    assert(ac_error < (sizeof(rta_real_t) == sizeof(float) ? 1e-5 : 1e-12));
+    assert(lag_error < 1e-3);
+    assert(min_error < 1e-3);
+
+    rta_yin_setup_delete(direct);
+    free(signal);
+    free(ac_direct);
+    free(ac);
+}
+
+/* batch yin of interleaved channels and of a matrix of frames against
+   rta_yin per channel */
+static void
+batch (unsigned int channels)
+{
+    const unsigned int input_size = 1024, ac_size = 400;
+    rta_real_t *interleaved = malloc(input_size * channels * sizeof(rta_real_t));
+    rta_real_t *matrix = malloc(input_size * channels * sizeof(rta_real_t));
+    rta_real_t *ac_batch = malloc(ac_size * channels * sizeof(rta_real_t));
+    rta_real_t *ac = malloc(ac_size * sizeof(rta_real_t));
+    rta_real_t *lags = malloc(channels * sizeof(rta_real_t));
+    rta_real_t *mins = malloc(channels * sizeof(rta_real_t));
+    rta_real_t *energies = malloc(channels * sizeof(rta_real_t));
+    rta_yin_setup_t *direct, *fft, *yin;
+    double ac_error = 0, lag_error = 0, min_error = 0, energy_error = 0;
+    int ok;
+    int s;
+    unsigned int c, i;
+
+    for (c = 0; c < channels; c++)
+    {
+	tone(matrix + c * input_size, 1, input_size, 80 + c * 37, 16000);
+	for (i = 0; i < input_size; i++)
+	    interleaved[i * channels + c] = matrix[c * input_size + i];
+    }
+
+    ok = rta_yin_setup_new(&direct, 128);
+    assert(ok);
+    ok = rta_yin_setup_new_with_method(&fft, 128, ac_size, input_size,
+				       rta_correlation_fft);
+    assert(ok);
+
+    /* interleaved and matrix with the direct setup, interleaved with
+       the FFT setup */
+    for (s = 0; s < 3; s++)
+    {
+	yin = s < 2 ? direct : fft;
+	if (s == 1)
+	    rta_yin_batch(lags, mins, energies, ac_batch, ac_size, matrix,
+			  1, input_size, input_size, channels, yin, THRESHOLD);
+	else
+	    rta_yin_batch(lags, mins, energies, ac_batch, ac_size, interleaved,
+			  channels, 1, input_size, channels, yin, THRESHOLD);
+
+	for (c = 0; c < channels; c++)
+	{
+	    rta_real_t min, lag;
+
+	    lag = rta_yin(&min, ac, ac_size, matrix + c * input_size,
+			  input_size, direct, THRESHOLD);
+
+	    for (i = 0; i < ac_size; i++)
+		ac_error = fmax(ac_error, fabs(ac_batch[i * channels + c]
+					       - ac[i]) / ac[0]);
+	    lag_error = fmax(lag_error, fabs(lags[c] - lag) / lag);
+	    min_error = fmax(min_error, fabs(mins[c] - min));
+	    energy_error = fmax(energy_error,
+				fabs(energies[c]
+				     - sqrt(ac[0] / (input_size - ac_size))));
+	}
+    }
+
+    /* without energies */
+    rta_yin_batch(lags, mins, NULL, ac_batch, ac_size, interleaved,
+		  channels, 1, input_size, channels, direct, THRESHOLD);
+
+    printf("--- batch %2u channels: autocorrelation error %g  lag error %g  minimum error %g  energy error %g\n",
+	   channels, ac_error, lag_error, min_error, energy_error);
+    assert(ac_error < (sizeof(rta_real_t) == sizeof(float) ? 1e-5 : 1e-12));
+    assert(lag_error < 1e-3);
+    assert(min_error < 1e-3);
+    assert(energy_error < 1e-4);
+
+    rta_yin_setup_delete(direct);
+    rta_yin_setup_delete(fft);
+    free(interleaved);
+    free(matrix);
+    free(ac_batch);
+    free(ac);
+    free(lags);
+    free(mins);
+    free(energies);
+}
+
+int main (int argc, char *argv[])
+{
+    fft_method(256, 512);
+    fft_method(1000, 2500);
+    fft_method(2048, 4096);
+
+    batch(1);
+    batch(3);
+    batch(8);
+    batch(13);
+
+    sliding_long_run(1, 1);
+    sliding_long_run(64, 30);
+    sliding_long_run(200, 30);
+    sliding_long_run(700, 1);
+
+    return 0;
+}